@@ -362,6 +362,12 @@ void setup() {
   // Note: VWIRE_RECEIVE(), VWIRE_CONNECTED(), and VWIRE_DISCONNECTED() macros
   // automatically register handlers - no manual registration needed!
   
+  // Dragging the color picker or a slider sends a burst of values; only
+  // the newest one needs to reach the strip
+  Vwire.setCommandCoalescing(V1);
+  Vwire.setCommandCoalescing(V2);
+  Vwire.setCommandCoalescing(V4);
+  
   // Connect
   Vwire.begin(WIFI_SSID, WIFI_PASSWORD);
 }
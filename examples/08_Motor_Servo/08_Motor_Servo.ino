@@ -255,7 +255,7 @@ VWIRE_RECEIVE(V2) {
     int x = param.getArrayInt(0);  // Left/Right
     int y = param.getArrayInt(1);  // Forward/Backward
     
-    Serial.printf("Joystick: X=%d, Y=%d\n", x, y);
+    Serial.printf("Joystick: X=%d, Y=%d (%u skipped)\n", x, y, Vwire.getDroppedCommands());
     joystickToDifferential(x, y);
   }
 }
@@ -329,6 +329,13 @@ void setup() {
   // Vwire.disableLog();   // Silent mode (default)
   Vwire.config(AUTH_TOKEN, DEVICE_ID);
   
+  // Sliders and the joystick send a burst of positions while dragged;
+  // drive to the newest one instead of replaying them all. The emergency
+  // stop (V5) keeps every command.
+  for (uint8_t pin = V0; pin <= V4; pin++) {
+    Vwire.setCommandCoalescing(pin);
+  }
+  
   // Connect (handlers auto-registered via VWIRE_RECEIVE macros)
   Vwire.begin(WIFI_SSID, WIFI_PASSWORD);
 }
@@ -0,0 +1,131 @@
+/*
+ * Vwire IOT - On-Device Benchmark
+ * 
+ * Measures this board against the real broker and publishes one JSON
+ * report on vwire/<deviceId>/bench:
+ *   - publish throughput (values/s and bytes/s)
+ *   - command round trip (cmd topic -> device -> echo publish)
+ *   - run() loop interval percentiles
+ *   - free heap low-water mark
+ * 
+ * Run it once with USE_TLS 1 and once with USE_TLS 0, on each board you
+ * deploy (ESP32, ESP8266, RP2040), to compare transports and boards. To
+ * gauge batching, uncomment setBatchWindow() below and compare again.
+ * 
+ * Copyright (c) 2026 Vwire IOT
+ * MIT License
+ * 
+ * =============================================================================
+ * DASHBOARD SETUP
+ * =============================================================================
+ * 
+ * V0: Button (push) - start another benchmark run
+ * 
+ * V127 carries the benchmark traffic: leave it without widgets.
+ * 
+ * =============================================================================
+ */
+
+#include <Vwire.h>
+
+// =============================================================================
+// CONFIGURATION - UPDATE THESE!
+// =============================================================================
+const char* WIFI_SSID     = "YOUR_WIFI_SSID";
+const char* WIFI_PASSWORD = "YOUR_WIFI_PASSWORD";
+const char* AUTH_TOKEN    = "YOUR_AUTH_TOKEN";
+const char* DEVICE_ID     = "YOUR_DEVICE_ID";  // VW-XXXXXX (OEM) or VU-XXXXXX (user-created)
+
+#define USE_TLS 1                     // 0: plain TCP (port 1883)
+#define PUBLISH_MS 5000               // Length of the publish phase
+#define START_DELAY_MS 3000           // Let the connection settle first
+
+// =============================================================================
+// GLOBAL VARIABLES
+// =============================================================================
+
+bool startRequested = false;
+unsigned long connectedAt = 0;
+bool wasRunning = false;
+
+// =============================================================================
+// HANDLERS
+// =============================================================================
+
+VWIRE_RECEIVE(V0) {
+  if (param.asInt() == 1) startRequested = true;
+}
+
+VWIRE_CONNECTED() {
+  Serial.println("Connected, benchmark starts in a moment");
+  connectedAt = millis();
+  startRequested = true;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+void printResult(const VwireBenchmarkResult& r) {
+  Serial.println("\n========== Vwire Benchmark ==========");
+  Serial.printf("Board: %s, transport: %s, %lu ms\n", Vwire.getBoardName(),
+                r.tls ? "TLS" : "TCP", r.durationMs);
+  if (!r.complete) Serial.println("(incomplete: connection lost or report not sent)");
+  Serial.printf("Publish:    %lu values/s, %lu bytes/s (%lu values)\n",
+                (unsigned long)r.valuesPerSec, (unsigned long)r.bytesPerSec,
+                (unsigned long)r.valuesSent);
+  Serial.printf("Round trip: avg %lu us, p50 %lu us, p90 %lu us, max %lu us (%d/%d back)\n",
+                (unsigned long)r.rttAvgUs, (unsigned long)r.rttP50Us,
+                (unsigned long)r.rttP90Us, (unsigned long)r.rttMaxUs,
+                r.probesReceived, r.probesSent);
+  Serial.printf("run() gap:  p50 %lu us, p90 %lu us, p99 %lu us, max %lu us (%lu runs)\n",
+                (unsigned long)r.loopP50Us, (unsigned long)r.loopP90Us,
+                (unsigned long)r.loopP99Us, (unsigned long)r.loopMaxUs,
+                (unsigned long)r.runs);
+  Serial.printf("Free heap:  start %lu, min %lu, end %lu bytes\n",
+                (unsigned long)r.heapStart, (unsigned long)r.heapMin,
+                (unsigned long)r.heapEnd);
+  Serial.println("=====================================\n");
+}
+
+// =============================================================================
+// SETUP / LOOP
+// =============================================================================
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  
+  // Optional logging:
+  // Vwire.logTo(Serial);  // Recommended: print library logs to Serial
+  #if USE_TLS
+  Vwire.config(AUTH_TOKEN, DEVICE_ID, VWIRE_TRANSPORT_TCP_SSL);
+  #else
+  Vwire.config(AUTH_TOKEN, DEVICE_ID, VWIRE_TRANSPORT_TCP);
+  #endif
+  
+  // Vwire.setBatchWindow(50);   // Compare: coalesce writes into batches
+  
+  Serial.println("Connecting to WiFi and MQTT...");
+  Vwire.begin(WIFI_SSID, WIFI_PASSWORD);
+}
+
+void loop() {
+  // Keep loop() to run() only while measuring: anything else here shows
+  // up in the run() gap percentiles
+  Vwire.run();
+  
+  if (startRequested && Vwire.connected() && millis() - connectedAt > START_DELAY_MS &&
+      !Vwire.isBenchmarkRunning()) {
+    startRequested = false;
+    if (Vwire.startBenchmark(PUBLISH_MS)) {
+      Serial.println("Benchmark running...");
+    }
+  }
+  
+  bool running = Vwire.isBenchmarkRunning();
+  if (wasRunning && !running) {
+    printResult(Vwire.getBenchmarkResult());
+  }
+  wasRunning = running;
+}
@@ -0,0 +1,278 @@
+/*
+ * Vwire IOT Arduino Library - Host Benchmarks
+ *
+ * Runs the library's hot paths against MockBroker and reports time and
+ * heap allocations per operation. Numbers are for the host CPU, so compare
+ * runs on the same machine: a regression between two library versions
+ * shows up here before it shows up on a device.
+ *
+ * Usage:
+ *   vwire_bench                 all benchmarks
+ *   vwire_bench dispatch        only those whose name contains "dispatch"
+ *   vwire_bench --ms 500        measure each for at least 500 ms
+ *
+ * Exits with status 1 when a benchmark marked allocation-free allocates.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <Vwire.h>
+#include <VwireGPIO.h>
+#include "MockBroker.h"
+
+#include <chrono>
+
+// =============================================================================
+// ALLOCATION COUNTING
+// =============================================================================
+//
+// The executable's malloc family wraps glibc's, so every heap allocation
+// in the library, the shims and libstdc++ (operator new) is counted.
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* block, size_t size);
+extern "C" void __libc_free(void* block);
+
+static uint64_t _allocations;
+static uint64_t _allocatedBytes;
+
+extern "C" void* malloc(size_t size) {
+  _allocations++;
+  _allocatedBytes += size;
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+  _allocations++;
+  _allocatedBytes += count * size;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* block, size_t size) {
+  _allocations++;
+  _allocatedBytes += size;
+  return __libc_realloc(block, size);
+}
+
+extern "C" void free(void* block) {
+  __libc_free(block);
+}
+
+// =============================================================================
+// FIXTURES
+// =============================================================================
+
+#define BENCH_DEVICE "bench"
+
+static MockBroker& broker = MockBroker::instance();
+static volatile uint32_t _sink;             // Keeps results from being optimised away
+
+static void _onCommand(VirtualPin& value) {
+  _sink += value.asInt();
+}
+
+static void _onTimer() {
+  _sink++;
+}
+
+static void _connect() {
+  Vwire.config("bench-token", BENCH_DEVICE);
+  Vwire.setTransport(VWIRE_TRANSPORT_TCP);
+  Vwire.onVirtualReceive(V1, _onCommand);
+  if (!Vwire.begin()) {
+    fprintf(stderr, "vwire_bench: could not connect to the mock broker\n");
+    exit(1);
+  }
+}
+
+// =============================================================================
+// BENCHMARKS
+// =============================================================================
+
+static const char* const kCommandTopic = "vwire/" BENCH_DEVICE "/cmd/V1";
+
+/** Command dispatch: PubSubClient callback -> topic parse -> V1 handler */
+static void benchDispatch(uint32_t i) {
+  (void)i;
+  broker.deliver(kCommandTopic, "512");
+}
+
+/** The same command, read by Vwire.run() through the MQTT client */
+static void benchRunCommand(uint32_t i) {
+  (void)i;
+  broker.push(kCommandTopic, "512");
+  Vwire.run();
+}
+
+/** Vwire.run() with nothing to read: the per-loop() cost */
+static void benchRunIdle(uint32_t i) {
+  (void)i;
+  Vwire.run();
+}
+
+static void benchParseInt(uint32_t i) {
+  (void)i;
+  VirtualPin pin("-12345");
+  _sink += pin.asInt();
+}
+
+static void benchParseFloat(uint32_t i) {
+  (void)i;
+  VirtualPin pin("23.456");
+  _sink += (uint32_t)pin.asFloat();
+}
+
+static void benchParseArray(uint32_t i) {
+  (void)i;
+  VirtualPin pin("1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5");
+  for (int k = 0; k < pin.getArraySize(); k++) {
+    _sink += (uint32_t)pin.getArrayFloat(k);
+  }
+}
+
+static void benchSendInt(uint32_t i) {
+  Vwire.virtualSend(V2, (int)i);
+}
+
+static void benchSendArray(uint32_t i) {
+  static float values[16];
+  for (int k = 0; k < 16; k++) values[k] = (float)(i + k) * 0.25f;
+  Vwire.virtualSendArray(V3, values, 16);
+}
+
+static void setupReliable() {
+  Vwire.setReliableDelivery(true);
+}
+
+static void teardownReliable() {
+  Vwire.setReliableDelivery(false);
+}
+
+/** Reliable write, then the broker's ACK for it */
+static void benchReliableAck(uint32_t i) {
+  Vwire.virtualSend(V4, (int)i);
+  const char* id = strstr(broker.lastPayload(), "\"msgId\":\"");
+  if (!id) return;
+  char ack[48];
+  snprintf(ack, sizeof(ack), "{\"msgId\":\"%lu\",\"ok\":true}", strtoul(id + 9, nullptr, 10));
+  broker.deliver("vwire/" BENCH_DEVICE "/ack", ack);
+}
+
+static VwireTimer _timers;
+
+static void setupTimers() {
+  for (int k = 0; k < 10; k++) {
+    _timers.setInterval(60000UL + k, _onTimer);
+  }
+}
+
+/** VwireTimer::run() with ten timers, none due */
+static void benchTimerIdle(uint32_t i) {
+  (void)i;
+  _timers.run();
+}
+
+static void setupGpio() {
+  Vwire.enableGPIO();
+}
+
+/** Dashboard pin configuration: JSON parse and four pins (re)configured */
+static void benchGpioConfig(uint32_t i) {
+  (void)i;
+  broker.deliver("vwire/" BENCH_DEVICE "/pinconfig",
+                 "{\"pins\":[{\"pin\":\"D2\",\"mode\":\"OUTPUT\"},"
+                 "{\"pin\":\"D4\",\"mode\":\"INPUT\",\"interval\":100},"
+                 "{\"pin\":\"D5\",\"mode\":\"PWM\"},"
+                 "{\"pin\":\"A0\",\"mode\":\"ANALOG_INPUT\",\"interval\":1000,\"deadband\":2}]}");
+}
+
+struct Benchmark {
+  const char* name;
+  void (*setup)();
+  void (*run)(uint32_t i);
+  void (*teardown)();
+  bool allocationFree;                      ///< Fails the run if it allocates after warm-up
+};
+
+static const Benchmark kBenchmarks[] = {
+  { "dispatch/cmd",        nullptr,        benchDispatch,    nullptr,          true },
+  { "run/cmd",             nullptr,        benchRunCommand,  nullptr,          true },
+  { "run/idle",            nullptr,        benchRunIdle,     nullptr,          true },
+  { "virtualpin/int",      nullptr,        benchParseInt,    nullptr,          true },
+  { "virtualpin/float",    nullptr,        benchParseFloat,  nullptr,          true },
+  { "virtualpin/array8",   nullptr,        benchParseArray,  nullptr,          true },
+  { "send/int",            nullptr,        benchSendInt,     nullptr,          true },
+  { "send/array16",        nullptr,        benchSendArray,   nullptr,          true },
+  { "reliable/send+ack",   setupReliable,  benchReliableAck, teardownReliable, true },
+  { "timer/run-idle10",    setupTimers,    benchTimerIdle,   nullptr,          true },
+  { "gpio/applyConfig",    setupGpio,      benchGpioConfig,  nullptr,          true },
+};
+
+// =============================================================================
+// RUNNER
+// =============================================================================
+
+static double _seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** @return false when an allocation-free benchmark allocated */
+static bool _measure(const Benchmark& bench, double minSeconds) {
+  if (bench.setup) bench.setup();
+
+  // Warm up: first-use allocations (buffers, handler tables) are not per op
+  uint32_t i = 0;
+  for (; i < 1000; i++) bench.run(i);
+
+  uint64_t ops = 1000;
+  double elapsed = 0;
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+  for (;;) {
+    uint64_t allocationsBefore = _allocations;
+    uint64_t bytesBefore = _allocatedBytes;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t n = 0; n < ops; n++) bench.run(i++);
+    elapsed = _seconds(start);
+    allocations = _allocations - allocationsBefore;
+    bytes = _allocatedBytes - bytesBefore;
+    if (elapsed >= minSeconds) break;
+    ops = elapsed > 0 ? (uint64_t)(ops * (minSeconds / elapsed) * 1.2) + 1 : ops * 10;
+  }
+
+  if (bench.teardown) bench.teardown();
+  printf("%-22s %12.1f %12.2f %12.1f %12llu\n", bench.name, elapsed * 1e9 / ops,
+         (double)allocations / ops, (double)bytes / ops, (unsigned long long)ops);
+  if (bench.allocationFree && allocations > 0) {
+    printf("%-22s FAILED: %llu allocations, expected none\n", bench.name,
+           (unsigned long long)allocations);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* filter = nullptr;
+  double minSeconds = 0.2;
+  for (int a = 1; a < argc; a++) {
+    if (strcmp(argv[a], "--ms") == 0 && a + 1 < argc) {
+      minSeconds = atof(argv[++a]) / 1000.0;
+    } else {
+      filter = argv[a];
+    }
+  }
+
+  _connect();
+  printf("Vwire %s host benchmarks (%s build)\n\n", VWIRE_VERSION, VWIRE_BOARD_NAME);
+  printf("%-22s %12s %12s %12s %12s\n", "benchmark", "ns/op", "allocs/op", "bytes/op", "ops");
+  bool ok = true;
+  for (const Benchmark& bench : kBenchmarks) {
+    if (filter && !strstr(bench.name, filter)) continue;
+    ok = _measure(bench, minSeconds) && ok;
+  }
+  printf("\nBroker received %lu publishes\n", (unsigned long)broker.publishCount());
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: Arduino core shim
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+
+// =============================================================================
+// TIME
+// =============================================================================
+
+static const std::chrono::steady_clock::time_point _hostStart = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - _hostStart).count();
+}
+
+unsigned long micros() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - _hostStart).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+}
+
+// =============================================================================
+// PINS
+// =============================================================================
+
+static int _hostPins[HOST_NUM_PINS];
+
+void hostSetPin(uint8_t pin, int value) {
+  if (pin < HOST_NUM_PINS) _hostPins[pin] = value;
+}
+
+int hostGetPin(uint8_t pin) {
+  return pin < HOST_NUM_PINS ? _hostPins[pin] : 0;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  hostSetPin(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+  return hostGetPin(pin) ? HIGH : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  return hostGetPin(pin);
+}
+
+void analogWrite(uint8_t pin, int value) {
+  hostSetPin(pin, value);
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+  return pin;
+}
+
+void attachInterrupt(int interrupt, void (*handler)(void), int mode) {
+  (void)interrupt;
+  (void)handler;
+  (void)mode;
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+  (void)pin;
+  (void)handler;
+  (void)arg;
+  (void)mode;
+}
+
+void detachInterrupt(int interrupt) {
+  (void)interrupt;
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
+
+// =============================================================================
+// RANDOM
+// =============================================================================
+
+long random(long howBig) {
+  return howBig > 0 ? (long)(::random() % howBig) : 0;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+  srandom((unsigned)seed);
+}
+
+// =============================================================================
+// LIBC EXTENSIONS
+// =============================================================================
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* out) {
+  sprintf(out, "%*.*f", width, precision, value);
+  return out;
+}
+
+char* ultoa(unsigned long value, char* out, int radix) {
+  char digits[33];
+  int n = 0;
+  do {
+    int d = (int)(value % radix);
+    digits[n++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+    value /= radix;
+  } while (value && n < (int)sizeof(digits));
+  for (int i = 0; i < n; i++) out[i] = digits[n - 1 - i];
+  out[n] = '\0';
+  return out;
+}
+
+char* ltoa(long value, char* out, int radix) {
+  if (value < 0 && radix == 10) {
+    out[0] = '-';
+    ultoa(0UL - (unsigned long)value, out + 1, radix);
+    return out;
+  }
+  return ultoa((unsigned long)value, out, radix);
+}
+
+char* itoa(int value, char* out, int radix) {
+  return ltoa(value, out, radix);
+}
+
+char* utoa(unsigned value, char* out, int radix) {
+  return ultoa(value, out, radix);
+}
+
+// =============================================================================
+// PRINT / STREAM / IP ADDRESS
+// =============================================================================
+
+size_t Print::printf(const char* format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buffer, std::min((size_t)len, sizeof(buffer) - 1));
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  unsigned long start = millis();
+  while (count < length && millis() - start < _timeout) {
+    int c = read();
+    if (c < 0) continue;
+    buffer[count++] = (char)c;
+  }
+  return count;
+}
+
+bool IPAddress::fromString(const char* address) {
+  unsigned parts[4];
+  char tail;
+  if (!address || sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) != 4) {
+    return false;
+  }
+  for (int i = 0; i < 4; i++) {
+    if (parts[i] > 255) return false;
+    _bytes[i] = (uint8_t)parts[i];
+  }
+  return true;
+}
+
+String IPAddress::toString() const {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+  return String(buffer);
+}
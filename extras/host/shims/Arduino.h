@@ -0,0 +1,286 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: Arduino core shim
+ *
+ * Just enough of the Arduino core for the library's generic-board code to
+ * build and run on Linux: String, Print/Stream, timing, GPIO and a few
+ * libc extensions. Pin reads return values set with hostSetPin(); writes
+ * are remembered for hostGetPin().
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_HOST_ARDUINO_H
+#define VWIRE_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PSTR(s) (s)
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define FPSTR(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define CHANGE 0x3
+#define RISING 0x4
+#define FALLING 0x5
+
+#define HOST_NUM_PINS 64
+#define A0 40
+#define LED_BUILTIN 2
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// =============================================================================
+// TIME, PINS, RANDOM
+// =============================================================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(int interrupt, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+void detachInterrupt(int interrupt);
+void noInterrupts();
+void interrupts();
+
+/** @brief Value the next digitalRead()/analogRead() of pin returns */
+void hostSetPin(uint8_t pin, int value);
+/** @brief Last value written to pin */
+int hostGetPin(uint8_t pin);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* out);
+char* itoa(int value, char* out, int radix);
+char* ltoa(long value, char* out, int radix);
+char* utoa(unsigned value, char* out, int radix);
+char* ultoa(unsigned long value, char* out, int radix);
+
+// =============================================================================
+// STRING
+// =============================================================================
+
+class String {
+public:
+  String() {}
+  String(const char* c) : _s(c ? c : "") {}
+  String(const __FlashStringHelper* c) : _s(c ? (const char*)c : "") {}
+  String(const String& other) = default;
+  explicit String(char c) : _s(1, c) {}
+  String(int v, unsigned char base = 10) : _s(_number((long)v, base)) {}
+  String(unsigned int v, unsigned char base = 10) : _s(_number((unsigned long)v, base)) {}
+  String(long v, unsigned char base = 10) : _s(_number(v, base)) {}
+  String(unsigned long v, unsigned char base = 10) : _s(_number(v, base)) {}
+  String(float v, unsigned char decimals = 2) : _s(_fixed(v, decimals)) {}
+  String(double v, unsigned char decimals = 2) : _s(_fixed(v, decimals)) {}
+
+  String& operator=(const String& other) = default;
+  String& operator=(const char* c) { _s = c ? c : ""; return *this; }
+
+  String& operator+=(const String& o) { _s += o._s; return *this; }
+  String& operator+=(const char* c) { if (c) _s += c; return *this; }
+  String& operator+=(const __FlashStringHelper* c) { return *this += (const char*)c; }
+  String& operator+=(char c) { _s += c; return *this; }
+  String& operator+=(int v) { _s += _number((long)v, 10); return *this; }
+  String& operator+=(unsigned int v) { _s += _number((unsigned long)v, 10); return *this; }
+  String& operator+=(long v) { _s += _number(v, 10); return *this; }
+  String& operator+=(unsigned long v) { _s += _number(v, 10); return *this; }
+  bool concat(const char* c) { *this += c; return true; }
+  bool concat(char c) { *this += c; return true; }
+
+  friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+  friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, int b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator==(const char* c) const { return _s == (c ? c : ""); }
+  bool operator!=(const String& o) const { return _s != o._s; }
+  bool operator!=(const char* c) const { return !(*this == c); }
+  bool equals(const String& o) const { return _s == o._s; }
+  bool equalsIgnoreCase(const String& o) const { return strcasecmp(c_str(), o.c_str()) == 0; }
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  void toCharArray(char* buf, unsigned int size) const {
+    if (!size) return;
+    size_t n = std::min((size_t)size - 1, _s.size());
+    memcpy(buf, _s.data(), n);
+    buf[n] = '\0';
+  }
+
+  String substring(unsigned int from) const { return substring(from, length()); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _s.size()) return String();
+    return String(_s.substr(from, to - from).c_str());
+  }
+  int indexOf(char c, unsigned int from = 0) const { return _find(_s.find(c, from)); }
+  int indexOf(const char* c, unsigned int from = 0) const { return _find(_s.find(c, from)); }
+  int lastIndexOf(char c) const { return _find(_s.rfind(c)); }
+  bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+  void trim() {
+    size_t a = _s.find_first_not_of(" \t\r\n");
+    size_t b = _s.find_last_not_of(" \t\r\n");
+    _s = a == std::string::npos ? std::string() : _s.substr(a, b - a + 1);
+  }
+  void toLowerCase() { for (char& c : _s) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (char& c : _s) c = (char)toupper((unsigned char)c); }
+
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return (float)atof(c_str()); }
+  double toDouble() const { return atof(c_str()); }
+
+private:
+  std::string _s;
+
+  static int _find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+  static std::string _number(long v, unsigned char base) {
+    char buf[34];
+    return base == 10 ? std::string(ltoa(v, buf, 10)) : std::string(ultoa((unsigned long)v, buf, base));
+  }
+  static std::string _number(unsigned long v, unsigned char base) {
+    char buf[34];
+    return std::string(ultoa(v, buf, base));
+  }
+  static std::string _fixed(double v, unsigned char decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return std::string(buf);
+  }
+};
+
+// =============================================================================
+// PRINT / STREAM
+// =============================================================================
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(const __FlashStringHelper* s) { return write((const char*)s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = 10) { return print(String(v, (unsigned char)base)); }
+  size_t print(unsigned long v, int base = 10) { return print(String(v, (unsigned char)base)); }
+  size_t print(double v, int decimals = 2) { return print(String(v, (unsigned char)decimals)); }
+
+  size_t println() { return write("\r\n"); }
+  template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+  template<typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long timeout) { _timeout = timeout; }
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+protected:
+  unsigned long _timeout = 1000;
+};
+
+/** @brief Serial: writes to stdout, never has input */
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  void flush() override { fflush(stdout); }
+  operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// =============================================================================
+// IP ADDRESS
+// =============================================================================
+
+class IPAddress {
+public:
+  IPAddress() { memset(_bytes, 0, sizeof(_bytes)); }
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    _bytes[0] = a; _bytes[1] = b; _bytes[2] = c; _bytes[3] = d;
+  }
+  IPAddress(uint32_t address) { memcpy(_bytes, &address, sizeof(_bytes)); }
+
+  operator uint32_t() const { uint32_t v; memcpy(&v, _bytes, sizeof(v)); return v; }
+  uint8_t operator[](int i) const { return _bytes[i]; }
+  uint8_t& operator[](int i) { return _bytes[i]; }
+  bool operator==(const IPAddress& o) const { return memcmp(_bytes, o._bytes, sizeof(_bytes)) == 0; }
+
+  bool fromString(const char* address);
+  bool fromString(const String& address) { return fromString(address.c_str()); }
+  String toString() const;
+
+private:
+  uint8_t _bytes[4];
+};
+
+#endif // VWIRE_HOST_ARDUINO_H
@@ -0,0 +1,84 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: in-memory MQTT broker
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "MockBroker.h"
+#include <PubSubClient.h>
+
+MockBroker& MockBroker::instance() {
+  static MockBroker broker;
+  return broker;
+}
+
+MockBroker::MockBroker()
+  : wifiConnected(true)
+  , accepting(true)
+  , _client(nullptr)
+  , _hook(nullptr)
+{
+  reset();
+}
+
+void MockBroker::reset() {
+  _head = 0;
+  _count = 0;
+  _published = 0;
+  _publishedBytes = 0;
+  _lastTopic[0] = '\0';
+  _lastPayload[0] = '\0';
+  _lastLength = 0;
+}
+
+bool MockBroker::push(const char* topic, const char* payload) {
+  return push(topic, (const uint8_t*)payload, strlen(payload));
+}
+
+bool MockBroker::push(const char* topic, const uint8_t* payload, unsigned int length) {
+  if (_count >= MOCK_BROKER_QUEUE || strlen(topic) >= MOCK_BROKER_TOPIC ||
+      length > MOCK_BROKER_PAYLOAD) {
+    return false;
+  }
+  Message& message = _queue[(_head + _count) % MOCK_BROKER_QUEUE];
+  strcpy(message.topic, topic);
+  memcpy(message.payload, payload, length);
+  message.length = length;
+  _count++;
+  return true;
+}
+
+bool MockBroker::pop(char* topic, uint8_t* payload, unsigned int& length) {
+  if (_count == 0) return false;
+  Message& message = _queue[_head];
+  strcpy(topic, message.topic);
+  memcpy(payload, message.payload, message.length);
+  length = message.length;
+  _head = (_head + 1) % MOCK_BROKER_QUEUE;
+  _count--;
+  return true;
+}
+
+bool MockBroker::deliver(const char* topic, const char* payload) {
+  return _client && _client->deliver(topic, (const uint8_t*)payload, strlen(payload));
+}
+
+void MockBroker::dropConnection() {
+  if (_client) _client->disconnect();
+}
+
+void MockBroker::received(const char* topic, const uint8_t* payload, unsigned int length,
+                          bool retained) {
+  _published++;
+  _publishedBytes += strlen(topic) + length;
+
+  strncpy(_lastTopic, topic, sizeof(_lastTopic) - 1);
+  _lastTopic[sizeof(_lastTopic) - 1] = '\0';
+  _lastLength = length < MOCK_BROKER_PAYLOAD ? length : MOCK_BROKER_PAYLOAD;
+  memcpy(_lastPayload, payload, _lastLength);
+  _lastPayload[_lastLength] = '\0';
+
+  if (_hook) _hook(topic, payload, length, retained);
+}
@@ -0,0 +1,93 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: in-memory MQTT broker
+ *
+ * Stands in for the network. Scripted messages are queued with push() and
+ * handed to the client one per PubSubClient::loop(), or delivered at once
+ * with deliver(). Everything the client publishes is counted and the last
+ * message is kept, and onPublish() sees each one. No call allocates.
+ *
+ * Usage:
+ *   MockBroker& broker = MockBroker::instance();
+ *   broker.push("vwire/dev/cmd/V1", "42");
+ *   Vwire.run();                              // V1 handler runs
+ *   printf("%s = %s\n", broker.lastTopic(), broker.lastPayload());
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_HOST_MOCK_BROKER_H
+#define VWIRE_HOST_MOCK_BROKER_H
+
+#include <Arduino.h>
+
+class PubSubClient;
+
+#define MOCK_BROKER_QUEUE 32          ///< Scripted messages waiting for loop()
+#define MOCK_BROKER_TOPIC 128
+#define MOCK_BROKER_PAYLOAD 2048
+
+typedef void (*MockPublishHook)(const char* topic, const uint8_t* payload, unsigned int length,
+                                bool retained);
+
+class MockBroker {
+public:
+  static MockBroker& instance();
+
+  // Network state
+  bool wifiConnected;                 ///< WiFi.status() reports WL_CONNECTED
+  bool accepting;                     ///< TCP connects and MQTT CONNECTs succeed
+
+  /** @brief Queue a message for the client's next loop() (false if the queue is full) */
+  bool push(const char* topic, const char* payload);
+  bool push(const char* topic, const uint8_t* payload, unsigned int length);
+  /** @brief Messages still queued */
+  uint8_t queued() const { return _count; }
+  /** @brief Hand a message to the connected client now, bypassing the queue */
+  bool deliver(const char* topic, const char* payload);
+
+  /** @brief Drop the MQTT session, as if the broker closed the socket */
+  void dropConnection();
+
+  // Published by the client
+  uint32_t publishCount() const { return _published; }
+  uint32_t publishBytes() const { return _publishedBytes; }
+  const char* lastTopic() const { return _lastTopic; }
+  const char* lastPayload() const { return _lastPayload; }
+  unsigned int lastLength() const { return _lastLength; }
+  void onPublish(MockPublishHook hook) { _hook = hook; }
+
+  /** @brief Forget counters, the queue and the last message */
+  void reset();
+
+  // Used by the shims
+  void attach(PubSubClient* client) { _client = client; }
+  void detach(PubSubClient* client) { if (_client == client) _client = nullptr; }
+  bool sessionUp() const { return _client != nullptr; }
+  bool pop(char* topic, uint8_t* payload, unsigned int& length);
+  void received(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+
+private:
+  MockBroker();
+
+  struct Message {
+    char topic[MOCK_BROKER_TOPIC];
+    uint8_t payload[MOCK_BROKER_PAYLOAD];
+    unsigned int length;
+  };
+
+  PubSubClient* _client;
+  Message _queue[MOCK_BROKER_QUEUE];
+  uint8_t _head;
+  uint8_t _count;
+
+  uint32_t _published;
+  uint32_t _publishedBytes;
+  char _lastTopic[MOCK_BROKER_TOPIC];
+  char _lastPayload[MOCK_BROKER_PAYLOAD + 1];
+  unsigned int _lastLength;
+  MockPublishHook _hook;
+};
+
+#endif // VWIRE_HOST_MOCK_BROKER_H
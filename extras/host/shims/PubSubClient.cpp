@@ -0,0 +1,198 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: PubSubClient shim
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <PubSubClient.h>
+#include "MockBroker.h"
+
+PubSubClient::PubSubClient()
+  : _client(nullptr)
+  , _callback(nullptr)
+  , _buffer(nullptr)
+  , _bufferSize(0)
+  , _state(MQTT_DISCONNECTED)
+  , _out(nullptr)
+  , _outLength(0)
+  , _outRetained(false)
+{
+  _outTopic[0] = '\0';
+  setBufferSize(MQTT_MAX_PACKET_SIZE);
+}
+
+PubSubClient::PubSubClient(Client& client) : PubSubClient() {
+  _client = &client;
+}
+
+PubSubClient::~PubSubClient() {
+  MockBroker::instance().detach(this);
+  free(_buffer);
+  free(_out);
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+  if (size == 0) return false;
+  // Like PubSubClient: one receive buffer, reallocated on resize. The
+  // shim's outgoing buffer is the same size.
+  uint8_t* buffer = (uint8_t*)realloc(_buffer, size);
+  if (!buffer) return false;
+  _buffer = buffer;
+  uint8_t* out = (uint8_t*)realloc(_out, size);
+  if (!out) return false;
+  _out = out;
+  _bufferSize = size;
+  return true;
+}
+
+// =============================================================================
+// CONNECTION
+// =============================================================================
+
+bool PubSubClient::connect(const char* id) {
+  return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+  return connect(id, user, pass, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass,
+                           const char* willTopic, uint8_t willQos, bool willRetain,
+                           const char* willMessage, bool cleanSession) {
+  (void)id;
+  (void)user;
+  (void)pass;
+  (void)willTopic;
+  (void)willQos;
+  (void)willRetain;
+  (void)willMessage;
+  (void)cleanSession;
+  MockBroker& broker = MockBroker::instance();
+  if (!_client || !_client->connected() || !broker.accepting) {
+    _state = MQTT_CONNECT_FAILED;
+    return false;
+  }
+  broker.attach(this);
+  _state = MQTT_CONNECTED;
+  return true;
+}
+
+void PubSubClient::disconnect() {
+  MockBroker::instance().detach(this);
+  if (_client) _client->stop();
+  _state = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::connected() {
+  if (_state != MQTT_CONNECTED) return false;
+  if (!_client || !_client->connected() || !MockBroker::instance().sessionUp()) {
+    MockBroker::instance().detach(this);
+    _state = MQTT_CONNECTION_LOST;
+    return false;
+  }
+  return true;
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t qos) {
+  (void)topic;
+  (void)qos;
+  return connected();
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+  (void)topic;
+  return connected();
+}
+
+// =============================================================================
+// PUBLISH
+// =============================================================================
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+  return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length,
+                           bool retained) {
+  // PubSubClient refuses messages that do not fit its buffer
+  if (!connected() || 5 + 2 + strlen(topic) + length > _bufferSize) return false;
+  MockBroker::instance().received(topic, payload, length, retained);
+  return true;
+}
+
+bool PubSubClient::beginPublish(const char* topic, unsigned int length, bool retained) {
+  (void)length;
+  if (!connected() || strlen(topic) >= sizeof(_outTopic)) return false;
+  strcpy(_outTopic, topic);
+  _outLength = 0;
+  _outRetained = retained;
+  return true;
+}
+
+size_t PubSubClient::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t PubSubClient::write(const uint8_t* buffer, size_t size) {
+  // Streamed payloads bypass the buffer on a device; keep what fits here
+  size_t room = _bufferSize - _outLength;
+  size_t n = size < room ? size : room;
+  memcpy(_out + _outLength, buffer, n);
+  _outLength += n;
+  return size;
+}
+
+int PubSubClient::endPublish() {
+  if (!connected()) return 0;
+  MockBroker::instance().received(_outTopic, _out, (unsigned int)_outLength, _outRetained);
+  return 1;
+}
+
+// =============================================================================
+// RECEIVE
+// =============================================================================
+
+bool PubSubClient::loop() {
+  if (!connected()) return false;
+
+  // One packet per call, as PubSubClient reads from the socket
+  char topic[MOCK_BROKER_TOPIC];
+  uint8_t payload[MOCK_BROKER_PAYLOAD];
+  unsigned int length = 0;
+  if (MockBroker::instance().pop(topic, payload, length)) {
+    deliver(topic, payload, length);
+  }
+  return true;
+}
+
+bool PubSubClient::deliver(const char* topic, const uint8_t* payload, unsigned int length) {
+  if (!_callback) return false;
+
+  // [0x30][remaining length][topic length: 2][topic][payload]
+  size_t topicLength = strlen(topic);
+  size_t remaining = 2 + topicLength + length;
+  uint8_t llen = remaining < 128 ? 1 : remaining < 16384 ? 2 : 3;
+  size_t total = 1 + llen + remaining;
+  if (total > _bufferSize) return false;          // PubSubClient drops it
+
+  _buffer[0] = 0x30;
+  size_t value = remaining;
+  for (uint8_t i = 0; i < llen; i++) {
+    _buffer[1 + i] = (uint8_t)((value % 128) | (i + 1 < llen ? 0x80 : 0));
+    value /= 128;
+  }
+  _buffer[llen + 1] = (uint8_t)(topicLength >> 8);
+  _buffer[llen + 2] = (uint8_t)(topicLength & 0xFF);
+  memcpy(_buffer + llen + 3, topic, topicLength);
+  memcpy(_buffer + llen + 3 + topicLength, payload, length);
+
+  // What PubSubClient::loop() does before calling back: shift the topic one
+  // byte down over its length field and terminate it in place
+  memmove(_buffer + llen + 2, _buffer + llen + 3, topicLength);
+  _buffer[llen + 2 + topicLength] = 0;
+  _callback((char*)_buffer + llen + 2, _buffer + llen + 3 + topicLength, length);
+  return true;
+}
@@ -0,0 +1,87 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: PubSubClient shim
+ *
+ * Same interface as PubSubClient 2.8, talking to MockBroker instead of a
+ * socket. Inbound PUBLISH packets are laid out in the receive buffer the
+ * way PubSubClient does it, so the library's zero-copy path sees the same
+ * pointers as on a device. loop() delivers at most one packet per call.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_HOST_PUBSUBCLIENT_H
+#define VWIRE_HOST_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <Client.h>
+
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_KEEPALIVE 15
+#define MQTT_SOCKET_TIMEOUT 15
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+
+#define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
+
+class PubSubClient : public Print {
+public:
+  PubSubClient();
+  explicit PubSubClient(Client& client);
+  ~PubSubClient();
+
+  PubSubClient& setClient(Client& client) { _client = &client; return *this; }
+  PubSubClient& setServer(const char* domain, uint16_t port) { (void)domain; (void)port; return *this; }
+  PubSubClient& setServer(IPAddress ip, uint16_t port) { (void)ip; (void)port; return *this; }
+  PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE) { _callback = callback; return *this; }
+  PubSubClient& setKeepAlive(uint16_t keepAlive) { (void)keepAlive; return *this; }
+  PubSubClient& setSocketTimeout(uint16_t timeout) { (void)timeout; return *this; }
+  bool setBufferSize(uint16_t size);
+  uint16_t getBufferSize() { return _bufferSize; }
+
+  bool connect(const char* id);
+  bool connect(const char* id, const char* user, const char* pass);
+  bool connect(const char* id, const char* user, const char* pass, const char* willTopic,
+               uint8_t willQos, bool willRetain, const char* willMessage, bool cleanSession = true);
+  void disconnect();
+
+  bool publish(const char* topic, const char* payload) { return publish(topic, payload, false); }
+  bool publish(const char* topic, const char* payload, bool retained);
+  bool publish(const char* topic, const uint8_t* payload, unsigned int length) {
+    return publish(topic, payload, length, false);
+  }
+  bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+  bool beginPublish(const char* topic, unsigned int length, bool retained);
+  int endPublish();
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+
+  bool subscribe(const char* topic, uint8_t qos = 0);
+  bool unsubscribe(const char* topic);
+  bool loop();
+  bool connected();
+  int state() { return _state; }
+
+  /** @brief Hand one PUBLISH to the callback now (MockBroker::deliver) */
+  bool deliver(const char* topic, const uint8_t* payload, unsigned int length);
+
+private:
+  Client* _client;
+  void (*_callback)(char*, uint8_t*, unsigned int);
+  uint8_t* _buffer;
+  uint16_t _bufferSize;
+  int _state;
+
+  // Outgoing beginPublish() message
+  char _outTopic[128];
+  uint8_t* _out;
+  size_t _outLength;
+  bool _outRetained;
+};
+
+#endif // VWIRE_HOST_PUBSUBCLIENT_H
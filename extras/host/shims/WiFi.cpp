@@ -0,0 +1,128 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: WiFi shim
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <WiFi.h>
+#include "MockBroker.h"
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::status() {
+  return MockBroker::instance().wifiConnected ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+int WiFiClass::begin(const char* ssid, const char* password, int32_t channel,
+                     const uint8_t* bssid, bool connect) {
+  (void)password;
+  (void)channel;
+  (void)connect;
+  if (ssid) {
+    strncpy(_ssid, ssid, sizeof(_ssid) - 1);
+    _ssid[sizeof(_ssid) - 1] = '\0';
+  }
+  if (bssid) memcpy(_bssid, bssid, sizeof(_bssid));
+  return status();
+}
+
+bool WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet,
+                       IPAddress dns1, IPAddress dns2) {
+  (void)local;
+  (void)gateway;
+  (void)subnet;
+  (void)dns1;
+  (void)dns2;
+  return true;
+}
+
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+  if (!MockBroker::instance().wifiConnected) return 0;
+  if (!result.fromString(host)) {
+    result = IPAddress(127, 0, 0, 1);
+  }
+  return 1;
+}
+
+// =============================================================================
+// WIFI CLIENT
+// =============================================================================
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+  (void)ip;
+  (void)port;
+  MockBroker& broker = MockBroker::instance();
+  _connected = broker.wifiConnected && broker.accepting;
+  return _connected ? 1 : 0;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  (void)host;
+  return connect(IPAddress(127, 0, 0, 1), port);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+  if (!connected()) return 0;
+  size_t room = sizeof(_frame) - _framed;
+  if (size > room) {
+    _framed = 0;                      // Larger than the broker accepts: drop it
+    return size;
+  }
+  memcpy(_frame + _framed, buffer, size);
+  _framed += size;
+  _parseFrames();
+  return size;
+}
+
+void WiFiClient::_parseFrames() {
+  for (;;) {
+    // Fixed header: type/flags, then the remaining length (1-4 bytes)
+    uint32_t remaining = 0;
+    size_t header = 1;
+    for (;;) {
+      if (header >= _framed) return;
+      uint8_t digit = _frame[header];
+      remaining |= (uint32_t)(digit & 0x7F) << (7 * (header - 1));
+      header++;
+      if (!(digit & 0x80)) break;
+      if (header > 4) {
+        _framed = 0;
+        return;
+      }
+    }
+    size_t total = header + remaining;
+    if (total > sizeof(_frame)) {
+      _framed = 0;
+      return;
+    }
+    if (_framed < total) return;
+
+    uint8_t type = _frame[0] >> 4;
+    if (type == 3 && remaining >= 2) {
+      uint8_t qos = (_frame[0] >> 1) & 0x03;
+      size_t topicLength = ((size_t)_frame[header] << 8) | _frame[header + 1];
+      size_t offset = header + 2 + topicLength + (qos ? 2 : 0);
+      if (topicLength < MOCK_BROKER_TOPIC && offset <= total) {
+        char topic[MOCK_BROKER_TOPIC];
+        memcpy(topic, _frame + header + 2, topicLength);
+        topic[topicLength] = '\0';
+        MockBroker::instance().received(topic, _frame + offset, (unsigned int)(total - offset),
+                                        _frame[0] & 0x01);
+      }
+    }
+    memmove(_frame, _frame + total, _framed - total);
+    _framed -= total;
+  }
+}
+
+int WiFiClient::available() {
+  return connected() ? MockBroker::instance().queued() : 0;
+}
+
+uint8_t WiFiClient::connected() {
+  if (!MockBroker::instance().wifiConnected) _connected = false;
+  if (!_connected) _framed = 0;
+  return _connected ? 1 : 0;
+}
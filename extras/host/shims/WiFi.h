@@ -0,0 +1,64 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: WiFi shim
+ *
+ * The station is associated whenever MockBroker::wifiConnected is set.
+ * Host names resolve to 127.0.0.1.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_HOST_WIFI_H
+#define VWIRE_HOST_WIFI_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class WiFiClass {
+public:
+  wl_status_t status();
+  void mode(wifi_mode_t mode) { (void)mode; }
+  int begin(const char* ssid, const char* password = nullptr, int32_t channel = 0,
+            const uint8_t* bssid = nullptr, bool connect = true);
+  bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+              IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+  bool disconnect(bool wifiOff = false) { (void)wifiOff; return true; }
+  bool reconnect() { return true; }
+  int hostByName(const char* host, IPAddress& result);
+
+  IPAddress localIP() { return IPAddress(10, 0, 0, 2); }
+  IPAddress gatewayIP() { return IPAddress(10, 0, 0, 1); }
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  IPAddress dnsIP(uint8_t n = 0) { (void)n; return IPAddress(10, 0, 0, 1); }
+  String SSID() { return String(_ssid); }
+  int32_t RSSI() { return -50; }
+  int32_t channel() { return 6; }
+  uint8_t* BSSID() { return _bssid; }
+  String macAddress() { return String("02:00:00:00:00:01"); }
+  bool setHostname(const char* name) { (void)name; return true; }
+  bool hostname(const char* name) { (void)name; return true; }
+  void setAutoReconnect(bool enable) { (void)enable; }
+  void persistent(bool enable) { (void)enable; }
+  bool setSleep(bool enable) { (void)enable; return true; }
+
+private:
+  char _ssid[33] = "host";
+  uint8_t _bssid[6] = { 0x02, 0, 0, 0, 0, 0x01 };
+};
+
+extern WiFiClass WiFi;
+
+#endif // VWIRE_HOST_WIFI_H
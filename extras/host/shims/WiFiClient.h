@@ -0,0 +1,44 @@
+/*
+ * Vwire IOT Arduino Library - Host Build: WiFiClient shim
+ *
+ * A TCP connection to MockBroker. PubSubClient's own packets are handled
+ * by its shim; frames the library writes to the socket directly (streamed
+ * PUBLISH) are reassembled here and handed to the broker. available()
+ * reports whether scripted messages are waiting, like a socket with data.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_HOST_WIFI_CLIENT_H
+#define VWIRE_HOST_WIFI_CLIENT_H
+
+#include <Client.h>
+#include "MockBroker.h"
+
+class WiFiClient : public Client {
+public:
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char* host, uint16_t port) override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override;
+  int available() override;
+  int read() override { return -1; }
+  int read(uint8_t* buffer, size_t size) override { (void)buffer; (void)size; return -1; }
+  void flush() override {}
+  void stop() override { _connected = false; _framed = 0; }
+  uint8_t connected() override;
+  operator bool() override { return connected(); }
+  void setTimeout(unsigned long timeout) { Stream::setTimeout(timeout); }
+  void setNoDelay(bool noDelay) { (void)noDelay; }
+
+private:
+  bool _connected = false;
+  uint8_t _frame[5 + 2 + MOCK_BROKER_TOPIC + MOCK_BROKER_PAYLOAD];
+  size_t _framed = 0;
+
+  void _parseFrames();
+};
+
+#endif // VWIRE_HOST_WIFI_CLIENT_H
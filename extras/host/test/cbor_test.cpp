@@ -0,0 +1,76 @@
+/*
+ * Vwire IOT Arduino Library - Host Tests: VwireCborWriter
+ *
+ * Checks that writeValue() only encodes canonical decimal text as a number
+ * and sends everything else as a text string.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <VwireCbor.h>
+
+static int _failures;
+
+#define EXPECT_EQ(actual, expected) do { \
+    long a = (long)(actual), e = (long)(expected); \
+    if (a != e) { \
+      printf("%s:%d: %s is %ld, expected %ld\n", __FILE__, __LINE__, #actual, a, e); \
+      _failures++; \
+    } \
+  } while (0)
+
+/** First byte of text encoded by writeValue() */
+static uint8_t _head(const char* text) {
+  uint8_t buffer[32] = {0};
+  VwireCborWriter writer(buffer, sizeof(buffer));
+  writer.writeValue(text);
+  return buffer[0];
+}
+
+static const uint8_t FLOAT32 = 0xFA;
+static const uint8_t FLOAT64 = 0xFB;
+
+/** Text strings carry their length in the head byte */
+static uint8_t _text(const char* text) { return (uint8_t)(0x60 | strlen(text)); }
+
+static void testNumbers() {
+  EXPECT_EQ(_head("0"), 0x00);
+  EXPECT_EQ(_head("17"), 0x11);
+  EXPECT_EQ(_head("-1"), 0x20);
+  EXPECT_EQ(_head("501"), 0x19);
+  EXPECT_EQ(_head("-2147483648"), 0x3A);
+  EXPECT_EQ(_head("3000000000"), FLOAT64);
+  EXPECT_EQ(_head("0.5"), FLOAT32);
+  EXPECT_EQ(_head("-12.25"), FLOAT32);
+  EXPECT_EQ(_head("1e5"), FLOAT32);
+  EXPECT_EQ(_head("2.5E-3"), FLOAT32);
+  EXPECT_EQ(_head("3.14159265358"), FLOAT64);
+  EXPECT_EQ(_head("-0"), FLOAT32);
+}
+
+static void testNonCanonicalStaysText() {
+  const char* samples[] = {
+    "0x1F", "nan", "NAN", "inf", "-inf", "infinity", "+5", "00501", "-007",
+    "1.", ".5", "1e", "1e+", "5 ", " 5", "", "-", "12abc",
+  };
+  for (const char* text : samples) {
+    if (_head(text) != _text(text)) {
+      printf("%s:%d: \"%s\" was not sent as text\n", __FILE__, __LINE__, text);
+      _failures++;
+    }
+  }
+}
+
+int main() {
+  testNumbers();
+  testNonCanonicalStaysText();
+
+  if (_failures) {
+    printf("cbor_test: %d failure(s)\n", _failures);
+    return 1;
+  }
+  printf("cbor_test: ok\n");
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Vwire IOT Arduino Library - Host Tests: VwireTimer
+ *
+ * Checks that run() fires each timer at most once per call, including
+ * timers that are rescheduled into the past while it runs.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include <VwireTimer.h>
+
+static int _failures;
+
+#define EXPECT_EQ(actual, expected) do { \
+    long a = (long)(actual), e = (long)(expected); \
+    if (a != e) { \
+      printf("%s:%d: %s is %ld, expected %ld\n", __FILE__, __LINE__, #actual, a, e); \
+      _failures++; \
+    } \
+  } while (0)
+
+static int _fastRuns;
+static int _slowRuns;
+static void _onFast() { _fastRuns++; }
+static void _onSlow() { _slowRuns++; }
+static void _onIdle() {}
+
+/** Timers that are never due; they only make the heap bigger */
+static void _addIdleTimers(VwireTimer& timer) {
+  for (int k = 0; k < 4; k++) {
+    timer.setInterval(60000UL, _onIdle);
+  }
+}
+
+/** A BURST timer ten periods behind makes up one period per run() */
+static void testLaggingBurst() {
+  VwireTimer timer;
+  _fastRuns = 0;
+  _addIdleTimers(timer);
+  int id = timer.setInterval(5, _onFast);
+  timer.setCatchUp(id, VWIRE_CATCHUP_BURST);
+  delay(55);
+
+  timer.run();
+  EXPECT_EQ(_fastRuns, 1);
+  timer.run();
+  EXPECT_EQ(_fastRuns, 2);
+}
+
+/** An interval-0 timer is due again as soon as it fires */
+static void testZeroInterval() {
+  VwireTimer timer;
+  _fastRuns = 0;
+  _addIdleTimers(timer);
+  timer.setInterval(0, _onFast);
+
+  timer.run();
+  EXPECT_EQ(_fastRuns, 1);
+  timer.run();
+  EXPECT_EQ(_fastRuns, 2);
+}
+
+/** A timer that already fired does not keep another due timer from running */
+static void testSecondTimerStillRuns() {
+  VwireTimer timer;
+  _fastRuns = 0;
+  _slowRuns = 0;
+  timer.setInterval(0, _onFast);
+  timer.setInterval(1, _onSlow);
+  delay(5);
+
+  timer.run();
+  EXPECT_EQ(_fastRuns, 1);
+  EXPECT_EQ(_slowRuns, 1);
+}
+
+int main() {
+  testLaggingBurst();
+  testZeroInterval();
+  testSecondTimerStillRuns();
+
+  if (_failures) {
+    printf("timer_test: %d failure(s)\n", _failures);
+    return 1;
+  }
+  printf("timer_test: ok\n");
+  return 0;
+}
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Regenerate src/VwirePortalPage.h from index.html.
+
+The provisioning page is served pre-compressed straight from flash, so
+after editing index.html run:
+
+    python3 extras/portal/build_portal.py
+
+Indentation, blank lines and HTML comments are stripped before the page
+is gzipped. The output is deterministic (no timestamp in the gzip header),
+and the ETag is derived from the compressed bytes, so browsers only fetch
+the page again when it actually changed.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(HERE, "index.html")
+TARGET = os.path.join(HERE, "..", "..", "src", "VwirePortalPage.h")
+
+HEADER = """/*
+ * Vwire IOT Arduino Library - Provisioning Portal Page
+ *
+ * GENERATED by extras/portal/build_portal.py from extras/portal/index.html.
+ * Do not edit by hand.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_PORTAL_PAGE_H
+#define VWIRE_PORTAL_PAGE_H
+
+#include <Arduino.h>
+
+/** @brief ETag of the page below */
+#define VWIRE_PORTAL_PAGE_ETAG "\\"{etag}\\""
+
+/** @brief index.html, gzip-compressed ({raw} bytes uncompressed) */
+static const uint8_t VWIRE_PORTAL_PAGE[] PROGMEM = {{
+{data}
+}};
+
+#endif // VWIRE_PORTAL_PAGE_H
+"""
+
+
+def minify(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    lines = (line.strip() for line in html.splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        page = minify(f.read()).encode("utf-8")
+
+    packed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(packed).hexdigest()[:16]
+
+    rows = []
+    for i in range(0, len(packed), 16):
+        rows.append("  " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+
+    with open(TARGET, "w", encoding="utf-8", newline="\n") as f:
+        f.write(HEADER.format(etag=etag, raw=len(page), data="\n".join(rows)))
+
+    print("%s: %d bytes -> %d bytes gzip, ETag %s" %
+          (os.path.relpath(TARGET), len(page), len(packed), etag))
+
+
+if __name__ == "__main__":
+    main()
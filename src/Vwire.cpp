@@ -25,6 +25,11 @@
 VwireClass Vwire;
 static VwireClass* _vwireInstance = nullptr;
 
+// Dotted quad without IPAddress::toString()'s String
+static void _formatIP(char* out, size_t size, const IPAddress& ip) {
+  snprintf(out, size, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+}
+
 // =============================================================================
 // AUTO-REGISTRATION SYSTEM
 // =============================================================================
@@ -60,9 +65,30 @@ VwireClass::VwireClass()
   , _logCallback(nullptr)
   , _startTime(0)
   , _lastHeartbeat(0)
-  , _lastReconnectAttempt(0)
+  , _connectStep(VWIRE_STEP_IDLE)
+  , _stepStartedAt(0)
+  , _nextAttemptAt(0)
+  , _reconnectAttempts(0)
+  , _brokerIPCached(false)
+  , _brokerIPExpires(0)
+  , _fastWakeAttempt(false)
+  #if VWIRE_ENABLE_ROAMING
+  , _networkCount(0)
+  , _roamEnabled(false)
+  , _roamThreshold(VWIRE_ROAM_RSSI_THRESHOLD)
+  , _roamScanning(false)
+  , _roamPending(false)
+  , _roamCheckedAt(0)
+  , _roamScanAt(0)
+  #endif
+  #if defined(VWIRE_BOARD_ESP8266)
+  , _tlsAutoRxSize(0)
+  #endif
   , _mqttClient(_wifiClient)  // Initialize with WiFiClient - CRITICAL!
+  , _mqttBufferSize(VWIRE_MAX_PAYLOAD_LENGTH)
+  , _subscribeId(0)
   , _pinHandlerCount(0)
+  , _autoHandlersMerged(0)
   , _connectHandler(nullptr)
   , _disconnectHandler(nullptr)
   , _messageHandler(nullptr)
@@ -70,11 +96,61 @@ VwireClass::VwireClass()
   , _gpioAddon(nullptr)
   , _reliableDeliveryAddon(nullptr)
   , _otaFeature(nullptr)
+  , _offlineQueue(nullptr)
+  #if VWIRE_ENABLE_CBOR
+  , _cborOffered(false)
+  , _cborForced(false)
+  , _cborActive(false)
+  #endif
+  #if VWIRE_ENABLE_NETWORK_TASK
+  , _netTask(nullptr)
+  , _netOutbound(nullptr)
+  , _netInbound(nullptr)
+  , _netMutex(nullptr)
+  #endif
+  #if VWIRE_ENABLE_SCHEDULER
+  , _taskCount(0)
+  , _runBudgetUs(0)
+  #endif
+  #if VWIRE_ENABLE_METRICS
+  , _metricsInHeartbeat(false)
+  , _metricsSampledAt(0)
+  , _outageStartedAt(0)
+  #endif
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  , _policyCount(0)
+  #endif
+  #if VWIRE_ENABLE_COALESCING
+  , _coalesceCount(0)
+  , _coalescePending(0)
+  , _coalesceStored(false)
+  , _coalesceDropped(0)
+  #endif
+  #if VWIRE_ENABLE_BATCH
+  , _batchLength(0)
+  , _batchCount(0)
+  , _batchActive(false)
+  , _batchWindow(0)
+  , _batchStartedAt(0)
+  , _batchLost(false)
+  #endif
 {
-  memset(_deviceId, 0, sizeof(_deviceId));
+  _storeDeviceId("");
   memset(_hostname, 0, sizeof(_hostname));
+  memset(_wifiSsid, 0, sizeof(_wifiSsid));
+  memset(_wifiPassword, 0, sizeof(_wifiPassword));
+  #if VWIRE_ENABLE_ROAMING
+  memset(_networks, 0, sizeof(_networks));
+  #endif
   memset(_pinHandlers, 0, sizeof(_pinHandlers));
+  memset(_manualPins, 0, sizeof(_manualPins));
   memset(_addons, 0, sizeof(_addons));
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  memset(_policyIndex, 0xFF, sizeof(_policyIndex));
+  #endif
+  #if VWIRE_ENABLE_COALESCING
+  memset(_coalesceIndex, 0xFF, sizeof(_coalesceIndex));
+  #endif
   _vwireInstance = this;
 }
 
@@ -100,9 +176,7 @@ void VwireClass::config(const char* authToken, const char* deviceId,
   _settings.port = (transport == VWIRE_TRANSPORT_TCP) ? VWIRE_DEFAULT_PORT_TCP : VWIRE_DEFAULT_PORT_TLS;
 
   // Device ID: use provided value, or fall back to auth token
-  const char* id = (deviceId && strlen(deviceId) > 0) ? deviceId : authToken;
-  strncpy(_deviceId, id, VWIRE_MAX_TOKEN_LENGTH - 1);
-  _deviceId[VWIRE_MAX_TOKEN_LENGTH - 1] = '\0';
+  _storeDeviceId((deviceId && strlen(deviceId) > 0) ? deviceId : authToken);
 
   VWIRE_LOGF("[Vwire] Config: device=%s, transport=%s",
                _deviceId,
@@ -111,8 +185,7 @@ void VwireClass::config(const char* authToken, const char* deviceId,
 
 void VwireClass::setDeviceId(const char* deviceId) {
   if (deviceId && strlen(deviceId) > 0) {
-    strncpy(_deviceId, deviceId, VWIRE_MAX_TOKEN_LENGTH - 1);
-    _deviceId[VWIRE_MAX_TOKEN_LENGTH - 1] = '\0';
+    _storeDeviceId(deviceId);
     VWIRE_LOGF("[Vwire] Custom device ID set: %s", _deviceId);
   }
 }
@@ -139,6 +212,10 @@ void VwireClass::setReconnectInterval(unsigned long interval) {
   _settings.reconnectInterval = interval;
 }
 
+void VwireClass::setMaxReconnectInterval(unsigned long interval) {
+  _settings.maxReconnectInterval = interval;
+}
+
 void VwireClass::setHeartbeatInterval(unsigned long interval) {
   _settings.heartbeatInterval = interval;
 }
@@ -165,9 +242,9 @@ void VwireClass::_setupClient() {
     _secureClient.setTimeout(10);  // 10 second timeout (reduced for faster response)
     #elif defined(VWIRE_BOARD_ESP8266)
     _secureClient.setInsecure();
-    // ESP8266 BearSSL needs larger buffers for TLS
-    // RX=2048 for incoming, TX=1024 for outgoing (TLS overhead needs ~500+ bytes)
-    _secureClient.setBufferSizes(2048, 1024);
+    _applyTlsBufferSizes();
+    // Offer the previous session on reconnect to skip the key exchange
+    _secureClient.setSession(_settings.tlsSessionCache ? &_tlsSession : nullptr);
     _secureClient.setTimeout(10000);  // 10 second timeout (ms for ESP8266)
     #endif
     
@@ -182,54 +259,250 @@ void VwireClass::_setupClient() {
   
   _mqttClient.setServer(_settings.server, _settings.port);
   _mqttClient.setCallback(_mqttCallbackWrapper);
-  _mqttClient.setBufferSize(VWIRE_MAX_PAYLOAD_LENGTH);
+  if (_mqttClient.getBufferSize() != _mqttBufferSize) {
+    _mqttClient.setBufferSize(_mqttBufferSize);  // Reallocates, so only when it changes
+  }
   _mqttClient.setKeepAlive(10);       // 10 second keepalive (EMQX detects offline within ~15s)
   _mqttClient.setSocketTimeout(5);    // 5 second socket timeout (faster error detection)
 }
 
-bool VwireClass::_connectWiFi(const char* ssid, const char* password) {
-  _state = VWIRE_STATE_CONNECTING_WIFI;
+void VwireClass::_startWiFi(const char* ssid, const char* password) {
   VWIRE_LOGF("[Vwire] Connecting to WiFi: %s", ssid);
   
   WiFi.mode(WIFI_STA);
   
   // Set WiFi hostname for network discovery (mDNS / DHCP)
   // Priority: user-set _hostname > default "vwire-<deviceId>"
-  String wifiHostname;
-  if (strlen(_hostname) > 0) {
-    wifiHostname = String(_hostname);
-  } else {
-    wifiHostname = "vwire-" + String(_deviceId).substring(0, 8);
+  if (_hostname[0] == '\0') {
     // Store the default so enableOTA() can reuse it
-    strncpy(_hostname, wifiHostname.c_str(), sizeof(_hostname) - 1);
-    _hostname[sizeof(_hostname) - 1] = '\0';
+    snprintf(_hostname, sizeof(_hostname), "vwire-%.8s", _deviceId);
   }
+  const char* wifiHostname = _hostname;
   #if defined(VWIRE_BOARD_ESP32)
-  WiFi.setHostname(wifiHostname.c_str());
+  WiFi.setHostname(wifiHostname);
   #elif defined(VWIRE_BOARD_ESP8266)
-  WiFi.hostname(wifiHostname.c_str());
+  WiFi.hostname(wifiHostname);
   #endif
-  VWIRE_LOGF("[Vwire] WiFi hostname: %s", wifiHostname.c_str());
+  VWIRE_LOGF("[Vwire] WiFi hostname: %s", wifiHostname);
   
-  WiFi.begin(ssid, password);
+  // Keep the credentials for the fast-wake fallback
+  strncpy(_wifiSsid, ssid, sizeof(_wifiSsid) - 1);
+  strncpy(_wifiPassword, password ? password : "", sizeof(_wifiPassword) - 1);
   
-  unsigned long startAttempt = millis();
+  // Rejoin the last AP directly: with its IP settings after deep sleep,
+  // from the config store after a cold boot
+  _fastWakeAttempt = _beginFastWake(ssid, password);
+  _state = VWIRE_STATE_CONNECTING_WIFI;
+  #if VWIRE_ENABLE_ROAMING
+  addNetwork(ssid, password);
+  if (!_fastWakeAttempt && _roamActive()) {
+    // Any known network may have been joined last; otherwise pick by scan
+    _fastWakeAttempt = _roamFastWake();
+    if (!_fastWakeAttempt) {
+      _roamStartScan();
+      return;
+    }
+  }
+  #endif
+  if (!_fastWakeAttempt) {
+    WiFi.begin(ssid, password);
+  }
   
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    yield();
-    VWIRE_LOG(".");
+  // Association and DHCP continue in the background; run() polls for them
+  _connectStep = VWIRE_STEP_WIFI;
+  _stepStartedAt = millis();
+}
+
+Client& VwireClass::_transportClient() {
+  #if VWIRE_HAS_SSL
+  if (_settings.transport == VWIRE_TRANSPORT_TCP_SSL) {
+    return _secureClient;
+  }
+  #endif
+  return _wifiClient;
+}
+
+bool VwireClass::_advanceConnection() {
+  // Each call performs at most one step, so run() returns between the
+  // WiFi wait, the DNS lookup, the TCP/TLS connect and the MQTT handshake.
+  switch (_connectStep) {
+    case VWIRE_STEP_IDLE:
+      return _state == VWIRE_STATE_CONNECTED;
+    
+    case VWIRE_STEP_BACKOFF:
+      if ((long)(millis() - _nextAttemptAt) < 0) return false;
+      if (WiFi.status() == WL_CONNECTED) {
+        _connectStep = VWIRE_STEP_RESOLVE;
+      } else {
+        _state = VWIRE_STATE_CONNECTING_WIFI;
+        #if VWIRE_ENABLE_ROAMING
+        if (_roamActive()) {
+          // The access point may be gone; look for the best one again
+          _roamStartScan();
+          return false;
+        }
+        #endif
+        #if defined(VWIRE_BOARD_ESP32) || defined(VWIRE_BOARD_ESP8266)
+        WiFi.reconnect();
+        #endif
+        _connectStep = VWIRE_STEP_WIFI;
+        _stepStartedAt = millis();
+      }
+      return false;
+    
+    case VWIRE_STEP_SCAN:
+      #if VWIRE_ENABLE_ROAMING
+      _roamConnectStep();
+      #endif
+      return false;
+    
+    case VWIRE_STEP_WIFI:
+      if (WiFi.status() == WL_CONNECTED) {
+        #if VWIRE_ENABLE_LOGGING
+        char ip[16];
+        _formatIP(ip, sizeof(ip), WiFi.localIP());
+        VWIRE_LOGF("[Vwire] WiFi connected! IP: %s", ip);
+        #endif
+        _saveAccessPoint();
+        _connectStep = VWIRE_STEP_RESOLVE;
+      } else if (_fastWakeAttempt && millis() - _stepStartedAt >= VWIRE_FAST_WAKE_WIFI_TIMEOUT) {
+        // Cached AP or address no longer valid: scan and use DHCP
+        VWIRE_LOG("[Vwire] Fast wake failed, reconnecting with scan + DHCP");
+        _fastWakeAttempt = false;
+        _dropFastWake();
+        WiFi.disconnect();
+        WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+        #if VWIRE_ENABLE_ROAMING
+        if (_roamActive()) {
+          _roamStartScan();
+          return false;
+        }
+        #endif
+        WiFi.begin(_wifiSsid, _wifiPassword);
+        _stepStartedAt = millis();
+      } else if (millis() - _stepStartedAt >= _settings.wifiTimeout) {
+        VWIRE_LOG("[Vwire] WiFi connection timeout!");
+        _setError(VWIRE_ERR_WIFI_FAILED);
+        _scheduleReconnect();
+      }
+      return false;
+    
+    case VWIRE_STEP_RESOLVE:
+      _state = VWIRE_STATE_CONNECTING_MQTT;
+      if (_brokerIPCached && (long)(millis() - _brokerIPExpires) < 0) {
+        #if VWIRE_ENABLE_LOGGING
+        char ip[16];
+        _formatIP(ip, sizeof(ip), _brokerIP);
+        VWIRE_LOGF("[Vwire] Using cached broker address %s", ip);
+        #endif
+      } else if (_brokerIP.fromString(_settings.server)) {
+        _brokerIPCached = false;
+      } else if (WiFi.hostByName(_settings.server, _brokerIP) == 1) {
+        _brokerIPCached = _settings.dnsCacheTtl > 0;
+        _brokerIPExpires = millis() + _settings.dnsCacheTtl;
+      } else {
+        VWIRE_LOGF("[Vwire] DNS lookup failed: %s", _settings.server);
+        _brokerIPCached = false;
+        _setError(VWIRE_ERR_MQTT_FAILED);
+        _scheduleReconnect();
+        return false;
+      }
+      _connectStep = VWIRE_STEP_TRANSPORT;
+      return false;
     
-    if (millis() - startAttempt >= _settings.wifiTimeout) {
-      VWIRE_LOG("\n[Vwire] WiFi connection timeout!");
-      _setError(VWIRE_ERR_WIFI_FAILED);
-      _state = VWIRE_STATE_ERROR;
+    case VWIRE_STEP_TRANSPORT: {
+      VWIRE_LOGF("[Vwire] Connecting to MQTT: %s:%d", _settings.server, _settings.port);
+      Client& client = _transportClient();
+      bool secure = &client != &_wifiClient;
+      int opened;
+      #if defined(VWIRE_BOARD_ESP32) && VWIRE_HAS_SSL
+      // Connect to the resolved address, passing the hostname for SNI
+      opened = secure ? _secureClient.connect(_brokerIP, _settings.port, _settings.server,
+                                              nullptr, nullptr, nullptr)
+                      : client.connect(_brokerIP, _settings.port);
+      #elif defined(VWIRE_BOARD_ESP8266)
+      if (secure && _settings.tlsRxBufferSize == 0 && _tlsAutoRxSize == 0) {
+        _applyTlsBufferSizes();     // Probes the broker once per boot
+      }
+      // BearSSL only sends SNI when given the hostname; its own lookup is
+      // answered from the lwIP DNS cache
+      opened = secure ? client.connect(_settings.server, _settings.port)
+                      : client.connect(_brokerIP, _settings.port);
+      #else
+      opened = secure ? client.connect(_settings.server, _settings.port)
+                      : client.connect(_brokerIP, _settings.port);
+      #endif
+      if (!opened) {
+        VWIRE_LOGF("[Vwire] %s connect failed", secure ? "TLS" : "TCP");
+        _setError(secure ? VWIRE_ERR_SSL_FAILED : VWIRE_ERR_MQTT_FAILED);
+        client.stop();
+        _brokerIPCached = false;      // The broker may have moved
+        _scheduleReconnect();
+        return false;
+      }
+      _connectStep = VWIRE_STEP_MQTT;
       return false;
     }
+    
+    case VWIRE_STEP_MQTT:
+      // The socket is already open, so PubSubClient only sends CONNECT
+      // and waits for CONNACK here
+      if (_connectMQTT()) {
+        _connectStep = VWIRE_STEP_IDLE;
+        _reconnectAttempts = 0;
+        #if VWIRE_ENABLE_METRICS
+        if (_outageStartedAt != 0) {
+          uint32_t outage = millis() - _outageStartedAt;
+          _metrics.reconnects++;
+          _metrics.lastOutageMs = outage;
+          _metrics.totalOutageMs += outage;
+          if (outage > _metrics.maxOutageMs) _metrics.maxOutageMs = outage;
+          _outageStartedAt = 0;
+        }
+        #endif
+        return true;
+      }
+      _transportClient().stop();
+      _scheduleReconnect();
+      return false;
+  }
+  return false;
+}
+
+void VwireClass::_scheduleReconnect() {
+  if (_state != VWIRE_STATE_DISCONNECTED) {
+    VWIRE_METRIC_COUNT(_metrics.connectFailures, 1);   // Not a fresh drop
+  }
+  _state = VWIRE_STATE_ERROR;
+  if (!_settings.autoReconnect) {
+    _connectStep = VWIRE_STEP_IDLE;
+    return;
   }
   
-  VWIRE_LOGF("\n[Vwire] WiFi connected! IP: %s", WiFi.localIP().toString().c_str());
-  return true;
+  // Exponential backoff with jitter: half the delay is fixed, half random
+  unsigned long delayMs = _settings.reconnectInterval;
+  for (uint8_t i = 0; i < _reconnectAttempts && delayMs < _settings.maxReconnectInterval; i++) {
+    delayMs <<= 1;
+  }
+  if (delayMs > _settings.maxReconnectInterval) {
+    delayMs = _settings.maxReconnectInterval;
+  }
+  delayMs = delayMs / 2 + (unsigned long)random((long)(delayMs / 2) + 1);
+  if (_reconnectAttempts < 255) _reconnectAttempts++;
+  
+  _nextAttemptAt = millis() + delayMs;
+  _connectStep = VWIRE_STEP_BACKOFF;
+  VWIRE_LOGF("[Vwire] Reconnecting in %lu ms (attempt %d)", delayMs, _reconnectAttempts);
+}
+
+void VwireClass::_notifyDisconnect(const char* reason) {
+  _state = VWIRE_STATE_DISCONNECTED;
+  VWIRE_LOGF("[Vwire] %s disconnected!", reason);
+  for (uint8_t i = 0; i < _addonCount; i++) {
+    if (_addons[i]) _addons[i]->onDisconnect();
+  }
+  if (_disconnectHandler) _disconnectHandler();
+  if (_vwireAutoDisconnectHandler) _vwireAutoDisconnectHandler();
 }
 
 bool VwireClass::_connectMQTT() {
@@ -240,35 +513,45 @@ bool VwireClass::_connectMQTT() {
   }
   
   _state = VWIRE_STATE_CONNECTING_MQTT;
-  VWIRE_LOGF("[Vwire] Connecting to MQTT: %s:%d", _settings.server, _settings.port);
   
   // Generate client ID from device ID
-  String clientId = "vwire-";
-  clientId += _deviceId;
+  char clientId[sizeof(_deviceId) + 6];
+  snprintf(clientId, sizeof(clientId), "vwire-%s", _deviceId);
   
   // Last will message
-  String willTopic = _buildTopic("status");
+  char willTopic[96];
+  _topic(willTopic, sizeof(willTopic), "status");
   const char* willMessage = "{\"status\":\"offline\"}";
   
-  VWIRE_LOGF("[Vwire] MQTT connecting as: %s", clientId.c_str());
+  VWIRE_LOGF("[Vwire] MQTT connecting as: %s", clientId);
   
   // Connect with token as both username and password (server validates password)
-  bool connected = _mqttClient.connect(clientId.c_str(), _settings.authToken, _settings.authToken, 
-                          willTopic.c_str(), 1, true, willMessage);
+  bool connected = _mqttClient.connect(clientId, _settings.authToken, _settings.authToken, 
+                          willTopic, 1, true, willMessage);
   
   if (connected) {
     _state = VWIRE_STATE_CONNECTED;
     VWIRE_LOG("[Vwire] MQTT connected!");
     
     // Publish online status (retained so server knows device is online)
-    _mqttClient.beginPublish(willTopic.c_str(), 19, true);  // retained=true
-    _mqttClient.print("{\"status\":\"online\"}");
-    _mqttClient.endPublish();
+    const char* onlineMessage = "{\"status\":\"online\"}";
+    #if VWIRE_ENABLE_CBOR
+    // Offer CBOR; the server accepts on vwire/{deviceId}/encoding
+    _setCborActive(_cborForced);
+    if (_cborOffered) {
+      onlineMessage = "{\"status\":\"online\",\"enc\":\"cbor\"}";
+      char encodingTopic[96];
+      _topic(encodingTopic, sizeof(encodingTopic), "encoding");
+      _streamSubscribe(encodingTopic, 1);
+    }
+    #endif
+    _streamPublish(willTopic, onlineMessage, strlen(onlineMessage), true);  // retained=true
     
     // Subscribe to command topics with QoS 1 for reliable command delivery
-    String cmdTopic = _buildTopic("cmd") + "/#";
-    _mqttClient.subscribe(cmdTopic.c_str(), 1);  // QoS 1 - commands are delivered at least once
-    VWIRE_LOGF("[Vwire] Subscribed to: %s (QoS 1)", cmdTopic.c_str());
+    char cmdTopic[96];
+    _topic(cmdTopic, sizeof(cmdTopic), "cmd/#");
+    _streamSubscribe(cmdTopic, 1);  // QoS 1 - commands are delivered at least once
+    VWIRE_LOGF("[Vwire] Subscribed to: %s (QoS 1)", cmdTopic);
     
     // Notify addons of connect (they subscribe to their own topics here)
     for (uint8_t i = 0; i < _addonCount; i++) {
@@ -292,21 +575,16 @@ bool VwireClass::_connectMQTT() {
 }
 
 bool VwireClass::begin(const char* ssid, const char* password) {
-  VWIRE_LOG("\n[Vwire] ========================================");
-  VWIRE_LOGF("[Vwire] Vwire IOT Library v%s", VWIRE_VERSION);
-  VWIRE_LOGF("[Vwire] Board: %s", VWIRE_BOARD_NAME);
-  VWIRE_LOG("[Vwire] ========================================\n");
-  
-  // Setup network client first
-  _setupClient();
-  
-  // Connect to WiFi
-  if (!_connectWiFi(ssid, password)) {
+  if (!beginAsync(ssid, password)) {
     return false;
   }
   
-  // Connect to MQTT
-  return _connectMQTT();
+  // Drive the connection engine until the first attempt succeeds or fails
+  while (_connectStep != VWIRE_STEP_IDLE && _connectStep != VWIRE_STEP_BACKOFF) {
+    _advanceConnection();
+    delay(10);
+  }
+  return connected();
 }
 
 bool VwireClass::begin() {
@@ -317,27 +595,149 @@ bool VwireClass::begin() {
     return false;
   }
   
+  if (!beginAsync()) {
+    return false;
+  }
+  while (_connectStep != VWIRE_STEP_IDLE && _connectStep != VWIRE_STEP_BACKOFF) {
+    _advanceConnection();
+    yield();
+  }
+  return connected();
+}
+
+bool VwireClass::beginAsync(const char* ssid, const char* password) {
+  VWIRE_LOG("\n[Vwire] ========================================");
+  VWIRE_LOGF("[Vwire] Vwire IOT Library v%s", VWIRE_VERSION);
+  VWIRE_LOGF("[Vwire] Board: %s", VWIRE_BOARD_NAME);
+  VWIRE_LOG("[Vwire] ========================================\n");
+  
+  if (strlen(_settings.authToken) == 0) {
+    _setError(VWIRE_ERR_NO_TOKEN);
+    VWIRE_LOG("[Vwire] Error: No auth token configured!");
+    return false;
+  }
+  
+  // Setup network client first
+  _restoreConnectionCache();
+  _setupClient();
+  _reconnectAttempts = 0;
+  _startWiFi(ssid, password);
+  return true;
+}
+
+bool VwireClass::beginAsync() {
+  if (strlen(_settings.authToken) == 0) {
+    _setError(VWIRE_ERR_NO_TOKEN);
+    VWIRE_LOG("[Vwire] Error: No auth token configured!");
+    return false;
+  }
+  
+  _restoreConnectionCache();
   _setupClient();
-  return _connectMQTT();
+  _reconnectAttempts = 0;
+  _state = VWIRE_STATE_CONNECTING_WIFI;
+  _connectStep = VWIRE_STEP_WIFI;
+  _stepStartedAt = millis();
+  return true;
 }
 
 void VwireClass::run() {
+  #if VWIRE_ENABLE_NETWORK_TASK
+  if (_netTask) {
+    // Networking lives in the task; deliver its commands on this core
+    _netDrainInbound();
+    #if VWIRE_ENABLE_COALESCING
+    if (_coalescePending > 0) _coalesceRun();
+    #endif
+    #if VWIRE_ENABLE_SCHEDULER
+    _runTasks(micros(), millis(), false, true);
+    #endif
+    return;
+  }
+  #endif
+  _runNetwork();
+  #if VWIRE_ENABLE_COALESCING
+  if (_coalescePending > 0) _coalesceRun();
+  #endif
+}
+
+void VwireClass::_runNetwork() {
+  VWIRE_METRIC_START(runStart);
+  #if VWIRE_ENABLE_SCHEDULER
+  const uint32_t runStartUs = micros();
+  #if VWIRE_ENABLE_NETWORK_TASK
+  const bool runTimers = !_netTask;      // The app side runs them instead
+  #else
+  const bool runTimers = true;
+  #endif
+  #endif
+  
   // Process MQTT messages - critical for low latency command reception
   if (_mqttClient.connected()) {
+    VWIRE_METRIC_START(loopStart);
+    #if VWIRE_ENABLE_COALESCING
+    _coalesceStored = false;
+    _mqttClient.loop();
+    // loop() reads one packet per call; while a burst only fills mailboxes,
+    // read on so it is absorbed now instead of over the next run() calls
+    for (uint8_t i = 0; i < VWIRE_COALESCE_MAX_READS && _coalesceStored &&
+                        _transportClient().available() > 0; i++) {
+      _coalesceStored = false;
+      _mqttClient.loop();
+    }
+    #else
     _mqttClient.loop();
+    #endif
+    VWIRE_METRIC_RECORD(_metrics.mqttLoop, loopStart);
     
-    // Send heartbeat (only when connected)
     unsigned long now = millis();
+    
+    #if VWIRE_ENABLE_BATCH
+    // Flush auto-batched pin writes once the window has elapsed
+    if (_batchCount > 0 && !_batchActive && _batchWindow > 0 &&
+        now - _batchStartedAt >= _batchWindow) {
+      _batchFlush();
+    }
+    #endif
+    
+    #if VWIRE_ENABLE_PUBLISH_POLICY
+    // Send values held back by a publish policy once they are due
+    if (_policyCount > 0) {
+      _policyRun(now);
+    }
+    #endif
+    
+    // Send heartbeat (only when connected)
     if (now - _lastHeartbeat >= _settings.heartbeatInterval) {
       _lastHeartbeat = now;
       _sendHeartbeat();
     }
     
+    #if VWIRE_ENABLE_ROAMING
+    if (_roamActive()) {
+      _roamRun(now);
+    }
+    #endif
+    
     // Run addons (GPIO polling, etc.)
+    #if VWIRE_ENABLE_SCHEDULER
+    _runTasks(runStartUs, now, true, runTimers);
+    #else
     for (uint8_t i = 0; i < _addonCount; i++) {
-      if (_addons[i]) _addons[i]->onRun();
+      if (!_addons[i]) continue;
+      VWIRE_METRIC_START(addonStart);
+      _addons[i]->onRun();
+      VWIRE_METRIC_RECORD(_metrics.addonRun[i], addonStart);
     }
+    #endif
     
+    #if VWIRE_ENABLE_METRICS
+    if (now - _metricsSampledAt >= VWIRE_METRICS_SAMPLE_INTERVAL) {
+      _metricsSampledAt = now;
+      _sampleHeap();
+    }
+    #endif
+    VWIRE_METRIC_RECORD(_metrics.loop, runStart);
     return;  // Fast path - everything is good
   }
   
@@ -346,39 +746,28 @@ void VwireClass::run() {
   // Allow ESP8266/ESP32 network stack to process
   yield();
   
-  // Check WiFi
-  if (WiFi.status() != WL_CONNECTED) {
-    if (_state == VWIRE_STATE_CONNECTED) {
-      _state = VWIRE_STATE_DISCONNECTED;
-      VWIRE_LOG("[Vwire] WiFi disconnected!");
-      for (uint8_t i = 0; i < _addonCount; i++) {
-        if (_addons[i]) _addons[i]->onDisconnect();
-      }
-      if (_disconnectHandler) _disconnectHandler();
-      if (_vwireAutoDisconnectHandler) _vwireAutoDisconnectHandler();
-    }
-    return;
-  }
-  
-  // MQTT disconnected but WiFi is up
   if (_state == VWIRE_STATE_CONNECTED) {
-    _state = VWIRE_STATE_DISCONNECTED;
-    VWIRE_LOG("[Vwire] MQTT disconnected!");
-    for (uint8_t i = 0; i < _addonCount; i++) {
-      if (_addons[i]) _addons[i]->onDisconnect();
-    }
-    if (_disconnectHandler) _disconnectHandler();
-    if (_vwireAutoDisconnectHandler) _vwireAutoDisconnectHandler();
+    #if VWIRE_ENABLE_METRICS
+    _outageStartedAt = millis();
+    if (_outageStartedAt == 0) _outageStartedAt = 1;
+    #endif
+    _notifyDisconnect(WiFi.status() != WL_CONNECTED ? "WiFi" : "MQTT");
+    _transportClient().stop();
+    _reconnectAttempts = 0;
+    _scheduleReconnect();
+    _state = VWIRE_STATE_DISCONNECTED;   // Dropped, not failed
   }
   
-  // Attempt reconnect
-  if (_settings.autoReconnect) {
-    unsigned long now = millis();
-    if (now - _lastReconnectAttempt >= _settings.reconnectInterval) {
-      _lastReconnectAttempt = now;
-      _connectMQTT();
-    }
+  // Reconnect one step at a time so loop() keeps running during outages
+  if (_connectStep != VWIRE_STEP_IDLE) {
+    _advanceConnection();
   }
+  
+  #if VWIRE_ENABLE_SCHEDULER
+  // Registered timers keep running through outages
+  _runTasks(runStartUs, millis(), false, runTimers);
+  #endif
+  VWIRE_METRIC_RECORD(_metrics.loop, runStart);
 }
 
 bool VwireClass::connected() {
@@ -386,15 +775,16 @@ bool VwireClass::connected() {
 }
 
 void VwireClass::disconnect() {
+  NetGuard guard(this, true);
   if (_mqttClient.connected()) {
     // Publish offline status (retained so server knows device went offline)
     char topic[96];
-    snprintf(topic, sizeof(topic), "vwire/%s/status", _deviceId);
-    _mqttClient.beginPublish(topic, 20, true);  // retained=true
-    _mqttClient.print("{\"status\":\"offline\"}");
-    _mqttClient.endPublish();
+    _topic(topic, sizeof(topic), "status");
+    _streamPublish(topic, "{\"status\":\"offline\"}", 20, true);  // retained=true
     _mqttClient.disconnect();
   }
+  _transportClient().stop();
+  _connectStep = VWIRE_STEP_IDLE;
   _state = VWIRE_STATE_DISCONNECTED;
 }
 
@@ -407,17 +797,70 @@ int VwireClass::getWiFiRSSI() { return WiFi.RSSI(); }
 // =============================================================================
 void VwireClass::_mqttCallbackWrapper(char* topic, byte* payload, unsigned int length) {
   if (_vwireInstance) {
+    #if VWIRE_ENABLE_METRICS
+    // Measured up front: a full-buffer payload is moved over the topic's terminator
+    size_t topicLength = strlen(topic);
+    #endif
+    VWIRE_METRIC_START(dispatchStart);
     _vwireInstance->_handleMessage(topic, payload, length);
+    VWIRE_METRIC_RECORD(_vwireInstance->_metrics.dispatch, dispatchStart);
+    VWIRE_METRIC_COUNT(_vwireInstance->_metrics.messagesIn, 1);
+    VWIRE_METRIC_COUNT(_vwireInstance->_metrics.bytesIn, topicLength + length);
   }
 }
 
 void VwireClass::_handleMessage(char* topic, byte* payload, unsigned int length) {
+  #if VWIRE_ENABLE_ZERO_COPY
+  // PubSubClient passes views into its receive buffer. When there is a spare
+  // byte after the payload, terminate it in place instead of copying.
+  if (_payloadHasSlack(topic, payload, length)) {
+    payload[length] = '\0';
+    _dispatchMessage(topic, (char*)payload, length);
+    return;
+  }
+  
+  // Packet filled the buffer exactly. The byte before the payload is the
+  // topic terminator (or the already-read msgId), so set the topic aside and
+  // move the payload back one byte to make room for its terminator.
+  char topicCopy[128];
+  size_t topicLength = strlen(topic);
+  if (topicLength >= sizeof(topicCopy)) {
+    _setError(VWIRE_ERR_BUFFER_FULL);
+    VWIRE_LOGF("[Vwire] Error: topic too long for a full %u byte payload", length);
+    return;
+  }
+  memcpy(topicCopy, topic, topicLength + 1);
+  char* moved = (char*)payload - 1;
+  memmove(moved, payload, length);
+  moved[length] = '\0';
+  _dispatchMessage(topicCopy, moved, length);
+  #else
   // Copy payload to null-terminated string
   char payloadStr[VWIRE_MAX_PAYLOAD_LENGTH];
   int copyLen = min((unsigned int)(VWIRE_MAX_PAYLOAD_LENGTH - 1), length);
   memcpy(payloadStr, payload, copyLen);
   payloadStr[copyLen] = '\0';
-  
+  _dispatchMessage(topic, payloadStr, copyLen);
+  #endif
+}
+
+#if VWIRE_ENABLE_ZERO_COPY
+bool VwireClass::_payloadHasSlack(const char* topic, const byte* payload, unsigned int length) {
+  // PubSubClient 2.8 lays a PUBLISH out in its buffer as
+  //   [header][remaining length: 1-4 bytes][topic\0][msgId (QoS 1)][payload]
+  // with the topic moved one byte forward and terminated. The remaining
+  // length follows from the pointers, which fixes the size of its field and
+  // therefore where the buffer starts.
+  const char* payloadStart = (const char*)payload;
+  if (payloadStart <= topic) return false;
+  unsigned long remaining = (unsigned long)(payloadStart - topic) + 1 + length;
+  uint8_t lengthBytes = remaining < 128UL ? 1 : remaining < 16384UL ? 2 : remaining < 2097152UL ? 3 : 4;
+  unsigned long used = (unsigned long)(payloadStart - topic) + 2 + lengthBytes + length;
+  return used < _mqttClient.getBufferSize();
+}
+#endif
+
+void VwireClass::_dispatchMessage(char* topic, char* payloadStr, unsigned int copyLen) {
   VWIRE_LOGF("[Vwire] Received: %s = %s", topic, payloadStr);
   
   // Call raw message handler if set
@@ -425,64 +868,157 @@ void VwireClass::_handleMessage(char* topic, byte* payload, unsigned int length)
     _messageHandler(topic, payloadStr);
   }
   
+  // Parse the topic once; addons route on message.type instead of
+  // re-scanning the topic string.
+  VwireMessage message;
+  message.topic = topic;
+  message.payload = payloadStr;
+  message.length = copyLen;
+  _classifyMessage(message);
+  
+  #if VWIRE_ENABLE_CBOR
+  if (message.type == VWIRE_MSG_DEVICE && strcmp(message.subtopic, "encoding") == 0) {
+    _setCborActive(_cborOffered && strcmp(payloadStr, "cbor") == 0);
+    return;
+  }
+  #endif
+  
   // Let addons handle the message first (GPIO pinconfig, OTA, ACK, etc.).
   // The first addon that returns true claims ownership; remaining addons and
   // the built-in virtual-pin dispatch are skipped for this message.
   for (uint8_t i = 0; i < _addonCount; i++) {
-    if (_addons[i] && _addons[i]->onMessage(topic, payloadStr)) {
+    if (_addons[i] && _addons[i]->onMessage(message)) {
       return;
     }
   }
   
-  // Fast parse: find "/cmd/" in topic using strstr (no heap allocation)
-  char* cmdPos = strstr(topic, "/cmd/");
-  if (!cmdPos) return;  // Not a command topic
+  if (message.type != VWIRE_MSG_CMD || message.pinType != 'V') return;
   
-  // Get pin string after "/cmd/"
-  char* pinStr = cmdPos + 5;  // Skip "/cmd/"
-  if (!pinStr || *pinStr == '\0') return;
-  
-  // Parse pin number (handle V prefix — virtual pins)
-  int pin = -1;
-  if (*pinStr == 'V' || *pinStr == 'v') {
-    pin = atoi(pinStr + 1);
-  } else {
-    pin = atoi(pinStr);
+  #if VWIRE_ENABLE_NETWORK_TASK
+  // Sketch handlers run on the app core: hand the command over
+  if (_netTask) {
+    _netForward(message.pin, payloadStr, copyLen);
+    return;
   }
-  
+  #endif
+  _runPinHandler(message.pin, payloadStr, copyLen);
+}
+
+void VwireClass::_runPinHandler(int pin, const char* payload, unsigned int length) {
   // Handle the pin if valid
   if (pin >= 0 && pin < VWIRE_MAX_VIRTUAL_PINS) {
-    VirtualPin vpin;
-    vpin.set(payloadStr);
-    
-    // First, check manually registered handlers (onVirtualReceive)
-    for (int i = 0; i < _pinHandlerCount; i++) {
-      if (_pinHandlers[i].active && _pinHandlers[i].pin == pin) {
-        if (_pinHandlers[i].handler) {
-          _pinHandlers[i].handler(vpin);
-        }
-        return;  // Found handler, exit immediately
+    #if VWIRE_ENABLE_COALESCING
+    // Latest-wins pins keep the newest value; run() calls the handler
+    if (_coalesceIndex[pin] != 0xFF) {
+      if (!_coalesceStore((uint8_t)pin, payload, length)) {
+        _callPinHandler((uint8_t)pin, payload, length);
+        _coalesceDropped = 0;
       }
+      return;
     }
+    #endif
+    _callPinHandler((uint8_t)pin, payload, length);
+  }
+}
+
+void VwireClass::_callPinHandler(uint8_t pin, const char* payload, unsigned int length) {
+  // VWIRE_RECEIVE handlers register from static constructors, possibly
+  // after this object was built; fold any new ones into the table.
+  if (_autoHandlersMerged != _vwireAutoReceiveCount) {
+    _mergeAutoHandlers();
+  }
+  
+  PinHandler handler = _pinHandlers[pin];
+  if (handler) {
+    VirtualPin vpin;
+    vpin._view(payload, length);  // No copy: payload outlives the handler
+    handler(vpin);
+  }
+}
+
+void VwireClass::_classifyMessage(VwireMessage& message) {
+  message.type = VWIRE_MSG_OTHER;
+  message.subtopic = nullptr;
+  message.pinName = nullptr;
+  message.pinType = 0;
+  message.pin = -1;
+  
+  // Expect vwire/{deviceId}/...
+  const char* topic = message.topic;
+  if (strncmp(topic, _topicPrefix, _topicPrefixLength) != 0) return;
+  
+  const char* sub = topic + _topicPrefixLength;
+  message.subtopic = sub;
+  message.type = VWIRE_MSG_DEVICE;
+  
+  if (strncmp(sub, "cmd/", 4) == 0) {
+    const char* pinStr = sub + 4;
+    if (*pinStr == '\0') return;
+    message.type = VWIRE_MSG_CMD;
+    message.pinName = pinStr;
     
-    // Then, check auto-registered handlers (VWIRE_RECEIVE macros)
-    for (uint8_t i = 0; i < _vwireAutoReceiveCount; i++) {
-      if (_vwireAutoReceiveHandlers[i].pin == pin) {
-        if (_vwireAutoReceiveHandlers[i].handler) {
-          _vwireAutoReceiveHandlers[i].handler(vpin);
-        }
-        return;  // Found handler, exit immediately
-      }
+    // Parse pin number (V prefix or bare number = virtual pin)
+    char prefix = toupper((unsigned char)*pinStr);
+    if (prefix == 'V' || prefix == 'D' || prefix == 'A') {
+      message.pinType = prefix;
+      pinStr++;
+    } else if (isdigit((unsigned char)*pinStr)) {
+      message.pinType = 'V';
+    }
+    if (isdigit((unsigned char)*pinStr)) {
+      message.pin = atoi(pinStr);
+    }
+  } else if (strcmp(sub, "pinconfig") == 0) {
+    message.type = VWIRE_MSG_PINCONFIG;
+  } else if (strcmp(sub, "ota") == 0) {
+    message.type = VWIRE_MSG_OTA;
+  } else if (strcmp(sub, "ack") == 0) {
+    message.type = VWIRE_MSG_ACK;
+  }
+}
+
+void VwireClass::_mergeAutoHandlers() {
+  // Manual handlers take priority; among VWIRE_RECEIVE duplicates the first
+  // registration wins, matching the order the old linear scan used.
+  for (uint8_t i = _autoHandlersMerged; i < _vwireAutoReceiveCount; i++) {
+    uint8_t pin = _vwireAutoReceiveHandlers[i].pin;
+    if (pin >= VWIRE_MAX_VIRTUAL_PINS) continue;
+    if (_manualPins[pin >> 3] & (1 << (pin & 7))) continue;
+    if (!_pinHandlers[pin]) {
+      _pinHandlers[pin] = _vwireAutoReceiveHandlers[i].handler;
     }
   }
+  _autoHandlersMerged = _vwireAutoReceiveCount;
 }
 
 // =============================================================================
 // VIRTUAL PIN OPERATIONS
 // =============================================================================
-void VwireClass::_virtualSendInternal(uint8_t pin, const String& value) {
+void VwireClass::_virtualSendInternal(uint8_t pin, const char* value) {
+  #if VWIRE_ENABLE_NETWORK_TASK
+  // Queue for the network task; policies, batching and delivery run there
+  if (_netTask && _onAppSide()) {
+    _netSend(VWIRE_NET_OP_PIN, pin, value);
+    return;
+  }
+  #endif
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  // Deadband / rate limit: held or skipped values stop here
+  if (pin < VWIRE_MAX_VIRTUAL_PINS && _policyIndex[pin] != 0xFF && !_policyAdmit(pin, value)) {
+    return;
+  }
+  #endif
+  _deliverPin(pin, value);
+}
+
+void VwireClass::_deliverPin(uint8_t pin, const char* value) {
   if (!connected()) {
+    // Journal to flash for replay after reconnect, if enabled
+    if (_offlineQueue && _offlineQueue->store(pin, value)) {
+      return;
+    }
     _setError(VWIRE_ERR_NOT_CONNECTED);
+    VWIRE_METRIC_COUNT(_metrics.messagesDropped, 1);
     return;
   }
 
@@ -490,36 +1026,65 @@ void VwireClass::_virtualSendInternal(uint8_t pin, const String& value) {
     return;
   }
   
+  // Collect into the current batch (explicit or auto-window). Entries that
+  // can never fit the batch buffer fall through to a direct publish.
+  if (isBatching() && _batchAppend(pin, value)) {
+    return;
+  }
+  
+  _publishPin(pin, value);
+}
+
+bool VwireClass::_publishPin(uint8_t pin, const char* value) {
   // Standard fire-and-forget delivery
   // Use stack-allocated buffer for topic (avoid heap allocation)
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/pin/V%d", _deviceId, pin);
+  size_t topicLength = _pinTopic(topic, sizeof(topic), "pin/V", pin);
   
   // Publish data to server
-  const char* payload = value.c_str();
-  unsigned int len = strlen(payload);
-  _mqttClient.beginPublish(topic, len, _settings.dataRetain);
-  _mqttClient.print(payload);
-  _mqttClient.endPublish();
-  VWIRE_LOGF("[Vwire] Send V%d = %s", pin, value.c_str());
+  VWIRE_METRIC_START(publishStart);
+  unsigned int len = strlen(value);
+  bool ok;
+  #if VWIRE_ENABLE_CBOR
+  if (_cborActive) {
+    ok = _publishCborValue(topic, value);
+  } else
+  #endif
+  {
+    ok = _streamPublish(topic, value, len, _settings.dataRetain);
+  }
+  #if VWIRE_ENABLE_METRICS
+  _recordPublish(publishStart, topicLength + len, ok);
+  #else
+  (void)topicLength;
+  #endif
+  VWIRE_LOGF("[Vwire] Send V%d = %s", pin, value);
+  return ok;
 }
 
 void VwireClass::virtualSendArray(uint8_t pin, float* values, int count) {
-  String str = "";
-  for (int i = 0; i < count; i++) {
-    if (i > 0) str += ",";
-    str += String(values[i], 2);
+  #if VWIRE_ENABLE_CBOR
+  if (_cborDirect(pin)) {
+    _publishCborArray(pin, values, nullptr, count);
+    return;
   }
-  _virtualSendInternal(pin, str);
+  #endif
+  // Formatted on the stack: no VirtualPin storage growing on the heap
+  char buffer[VWIRE_MAX_PAYLOAD_LENGTH];
+  VirtualPin::formatArray(buffer, sizeof(buffer), values, count);
+  _virtualSendInternal(pin, buffer);
 }
 
 void VwireClass::virtualSendArray(uint8_t pin, int* values, int count) {
-  String str = "";
-  for (int i = 0; i < count; i++) {
-    if (i > 0) str += ",";
-    str += String(values[i]);
+  #if VWIRE_ENABLE_CBOR
+  if (_cborDirect(pin)) {
+    _publishCborArray(pin, nullptr, values, count);
+    return;
   }
-  _virtualSendInternal(pin, str);
+  #endif
+  char buffer[VWIRE_MAX_PAYLOAD_LENGTH];
+  VirtualPin::formatArray(buffer, sizeof(buffer), values, count);
+  _virtualSendInternal(pin, buffer);
 }
 
 void VwireClass::virtualSendf(uint8_t pin, const char* format, ...) {
@@ -528,41 +1093,49 @@ void VwireClass::virtualSendf(uint8_t pin, const char* format, ...) {
   va_start(args, format);
   vsnprintf(buffer, sizeof(buffer), format, args);
   va_end(args);
-  _virtualSendInternal(pin, String(buffer));
+  _virtualSendInternal(pin, buffer);
 }
 
 void VwireClass::syncVirtual(uint8_t pin) {
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
   // Use stack buffer for topic
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/sync/V%d", _deviceId, pin);
-  _mqttClient.beginPublish(topic, 0, false);
-  _mqttClient.endPublish();
+  _pinTopic(topic, sizeof(topic), "sync/V", pin);
+  _streamPublish(topic, "", 0, false);
 }
 
 void VwireClass::syncAll() {
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/sync", _deviceId);
-  _mqttClient.beginPublish(topic, 3, false);
-  _mqttClient.print("all");
-  _mqttClient.endPublish();
+  _topic(topic, sizeof(topic), "sync");
+  _streamPublish(topic, "all", 3, false);
 }
 
 // =============================================================================
 // EVENT HANDLERS
 // =============================================================================
 void VwireClass::onVirtualReceive(uint8_t pin, PinHandler handler) {
-  if (_pinHandlerCount >= VWIRE_MAX_HANDLERS) {
+  if (pin >= VWIRE_MAX_VIRTUAL_PINS) {
+    _setError(VWIRE_ERR_INVALID_PIN);
+    VWIRE_LOGF("[Vwire] Error: V%d is out of range!", pin);
+    return;
+  }
+  
+  bool isNew = !(_manualPins[pin >> 3] & (1 << (pin & 7)));
+  if (isNew && _pinHandlerCount >= VWIRE_MAX_HANDLERS) {
     _setError(VWIRE_ERR_HANDLER_FULL);
     VWIRE_LOG("[Vwire] Error: Max handlers reached!");
     return;
   }
   
-  _pinHandlers[_pinHandlerCount].pin = pin;
-  _pinHandlers[_pinHandlerCount].handler = handler;
-  _pinHandlers[_pinHandlerCount].active = true;
-  _pinHandlerCount++;
+  // Registering again for the same pin replaces the previous handler
+  _pinHandlers[pin] = handler;
+  _manualPins[pin >> 3] |= (1 << (pin & 7));
+  if (isNew) _pinHandlerCount++;
   
   VWIRE_LOGF("[Vwire] Handler registered for V%d", pin);
 }
@@ -581,6 +1154,8 @@ const char* VwireClass::getVersion() { return VWIRE_VERSION; }
 uint32_t VwireClass::getFreeHeap() {
   #if defined(VWIRE_BOARD_ESP32) || defined(VWIRE_BOARD_ESP8266)
   return ESP.getFreeHeap();
+  #elif defined(VWIRE_BOARD_RP2040) && !defined(ARDUINO_ARCH_MBED)
+  return rp2040.getFreeHeap();
   #else
   return 0;
   #endif
@@ -593,18 +1168,12 @@ uint32_t VwireClass::getUptime() {
 // =============================================================================
 // HELPERS
 // =============================================================================
-String VwireClass::_buildTopic(const char* type, int pin) {
-  String topic = "vwire/";
-  topic += _deviceId;
-  topic += "/";
-  topic += type;
-  
-  if (pin >= 0) {
-    topic += "/";
-    topic += String(pin);
-  }
+void VwireClass::_storeDeviceId(const char* id) {
+  strncpy(_deviceId, id, VWIRE_MAX_TOKEN_LENGTH - 1);
+  _deviceId[VWIRE_MAX_TOKEN_LENGTH - 1] = '\0';
   
-  return topic;
+  // Every topic starts with this: build it once instead of per publish
+  _topicPrefixLength = (uint8_t)snprintf(_topicPrefix, sizeof(_topicPrefix), "vwire/%s/", _deviceId);
 }
 
 void VwireClass::_sendHeartbeat() {
@@ -612,30 +1181,46 @@ void VwireClass::_sendHeartbeat() {
   
   // Use stack buffers to avoid heap allocation
   char topic[96];
+  #if VWIRE_ENABLE_METRICS
+  char buffer[512];
+  #else
   char buffer[192];
+  #endif
   
-  // Get IP address string
-  String ipStr = WiFi.localIP().toString();
+  char ip[16];
+  _formatIP(ip, sizeof(ip), WiFi.localIP());
   
-  snprintf(topic, sizeof(topic), "vwire/%s/heartbeat", _deviceId);
+  _topic(topic, sizeof(topic), "heartbeat");
+  
+  int len = snprintf(buffer, sizeof(buffer), 
+    "{\"uptime\":%lu,\"heap\":%lu,\"rssi\":%d,\"ip\":\"%s\",\"fw\":\"%s\"",
+    (unsigned long)getUptime(), (unsigned long)getFreeHeap(), getWiFiRSSI(),
+    ip, VWIRE_VERSION);
   
   #if VWIRE_ENABLE_CLOUD_OTA
-  if (_otaFeature && _otaFeature->isCloudEnabled()) {
-    snprintf(buffer, sizeof(buffer), 
-      "{\"uptime\":%lu,\"heap\":%lu,\"rssi\":%d,\"ip\":\"%s\",\"fw\":\"%s\",\"ota\":true}",
-      getUptime(), getFreeHeap(), getWiFiRSSI(), ipStr.c_str(), VWIRE_VERSION);
-  } else {
-    snprintf(buffer, sizeof(buffer), 
-      "{\"uptime\":%lu,\"heap\":%lu,\"rssi\":%d,\"ip\":\"%s\",\"fw\":\"%s\"}",
-      getUptime(), getFreeHeap(), getWiFiRSSI(), ipStr.c_str(), VWIRE_VERSION);
+  if (_otaFeature && _otaFeature->isCloudEnabled() && (size_t)len < sizeof(buffer)) {
+    len += snprintf(buffer + len, sizeof(buffer) - len, ",\"ota\":true");
+  }
+  #endif
+  
+  #if VWIRE_ENABLE_METRICS
+  if (_metricsInHeartbeat && (size_t)len + 1 < sizeof(buffer)) {
+    int start = len;
+    buffer[len++] = ',';
+    len += _formatMetrics(buffer + len, sizeof(buffer) - len);
+    if ((size_t)len + 1 >= sizeof(buffer)) {
+      len = start;                   // Didn't fit: send without metrics
+    }
   }
-  #else
-  snprintf(buffer, sizeof(buffer), 
-    "{\"uptime\":%lu,\"heap\":%lu,\"rssi\":%d,\"ip\":\"%s\",\"fw\":\"%s\"}",
-    getUptime(), getFreeHeap(), getWiFiRSSI(), ipStr.c_str(), VWIRE_VERSION);
   #endif
   
-  _mqttClient.publish(topic, buffer);
+  if ((size_t)len + 1 >= sizeof(buffer)) {
+    len = sizeof(buffer) - 2;
+  }
+  buffer[len++] = '}';
+  buffer[len] = '\0';
+  
+  _streamPublish(topic, buffer, len, false);
 }
 
 void VwireClass::_setError(VwireError error) {
@@ -659,6 +1244,9 @@ void VwireClass::addAddon(VwireAddon& addon) {
   }
 
   _addons[_addonCount++] = &addon;
+  #if VWIRE_ENABLE_SCHEDULER
+  _addTask(&addon, nullptr, _addonCount - 1, 0, VWIRE_PRIORITY_NORMAL);
+  #endif
   addon.onAttach(*this);
 
   if (connected()) {
@@ -675,15 +1263,62 @@ bool VwireClass::publish(const char* topic, const char* payload, bool retain) {
     _setError(VWIRE_ERR_NOT_CONNECTED);
     return false;
   }
+  NetGuard guard(this, false);
+  if (!guard.locked) return false;
+  VWIRE_METRIC_START(publishStart);
   unsigned int len = strlen(payload);
-  _mqttClient.beginPublish(topic, len, retain);
-  _mqttClient.print(payload);
-  return _mqttClient.endPublish();
+  bool ok = _streamPublish(topic, payload, len, retain);
+  #if VWIRE_ENABLE_METRICS
+  _recordPublish(publishStart, strlen(topic) + len, ok);
+  #endif
+  return ok;
+}
+
+// Header, topic and payload leave in as few client writes as the stream
+// buffer allows (one for typical pin values), instead of PubSubClient's
+// separate header and payload writes
+bool VwireClass::_streamPublish(const char* topic, const char* payload, size_t length, bool retain) {
+  VwirePublishStream stream(_transportClient());
+  stream.begin(topic, length, retain);
+  stream.write((const uint8_t*)payload, length);
+  return stream.end();
 }
 
 bool VwireClass::subscribe(const char* topic, uint8_t qos) {
   if (!connected()) return false;
-  return _mqttClient.subscribe(topic, qos);
+  NetGuard guard(this, false);
+  return guard.locked && _streamSubscribe(topic, qos);
+}
+
+// SUBSCRIBE is framed here too: PubSubClient's subscribe() builds it in the
+// receive buffer, which holds the message being dispatched when a handler
+// subscribes. PubSubClient ignores SUBACKs, so the packet id is ours.
+bool VwireClass::_streamSubscribe(const char* topic, uint8_t qos) {
+  size_t topicLength = strlen(topic);
+  uint32_t remaining = (uint32_t)(2 + 2 + topicLength + 1);
+  uint8_t frame[VWIRE_STREAM_BUFFER_SIZE];
+  if (qos > 1) return false;         // Like PubSubClient: QoS 0 and 1 only
+  if (remaining + 5 > sizeof(frame)) {
+    _setError(VWIRE_ERR_BUFFER_FULL);
+    return false;
+  }
+
+  if (++_subscribeId == 0) _subscribeId = 1;
+  size_t length = 0;
+  frame[length++] = 0x82;            // SUBSCRIBE, reserved flags 0b0010
+  do {
+    uint8_t digit = remaining % 128;
+    remaining /= 128;
+    frame[length++] = remaining > 0 ? (uint8_t)(digit | 0x80) : digit;
+  } while (remaining > 0);
+  frame[length++] = (uint8_t)(_subscribeId >> 8);
+  frame[length++] = (uint8_t)_subscribeId;
+  frame[length++] = (uint8_t)(topicLength >> 8);
+  frame[length++] = (uint8_t)topicLength;
+  memcpy(frame + length, topic, topicLength);
+  length += topicLength;
+  frame[length++] = qos;
+  return _transportClient().write(frame, length) == length;
 }
 
 // =============================================================================
@@ -23,6 +23,13 @@
 #include <Arduino.h>
 #include "VwireConfig.h"
 #include "VwireTimer.h"
+#include "VwireMetrics.h"
+#include "VwireBenchmark.h"
+#include "VwirePublishPolicy.h"
+#include "VwireAnalogFilter.h"
+#include "VwireCbor.h"
+#include "VwireStream.h"
+#include "VwireArena.h"
 
 // =============================================================================
 // PLATFORM-SPECIFIC INCLUDES
@@ -51,9 +58,23 @@
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
 
+#if VWIRE_ENABLE_NETWORK_TASK
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #include <freertos/queue.h>
+  #include <freertos/semphr.h>
+
+// Network task queue entry kinds (internal)
+#define VWIRE_NET_OP_PIN          0   // Pin write (outbound) or command (inbound)
+#define VWIRE_NET_OP_BATCH_BEGIN  1   // beginBatch() from the app
+#define VWIRE_NET_OP_BATCH_COMMIT 2   // commitBatch() from the app
+#endif
+
 class VwireGPIO;
 class VwireReliableDeliveryAddon;
 class VwireOTAAddon;
+class VwireOfflineQueueAddon;
+class VwireBenchmarkAddon;
 
 class VwireReliableDelivery : public VwireAddon {
 public:
@@ -65,7 +86,19 @@ public:
   virtual void onDeliveryStatus(DeliveryCallback cb) = 0;
   virtual uint8_t getPendingCount() const = 0;
   virtual bool isPending() const = 0;
-  virtual bool send(uint8_t pin, const String& value) = 0;
+  virtual bool send(uint8_t pin, const char* value) = 0;
+};
+
+class VwireOfflineQueue : public VwireAddon {
+public:
+  virtual ~VwireOfflineQueue() {}
+  virtual bool begin() = 0;
+  virtual void setEnabled(bool enable) = 0;
+  virtual bool isEnabled() const = 0;
+  virtual void setDrainRate(uint8_t perBatch, unsigned long interval) = 0;
+  virtual uint32_t getQueuedCount() const = 0;
+  virtual void clear() = 0;
+  virtual bool store(uint8_t pin, const char* value) = 0;
 };
 
 class VwireOTAFeature : public VwireAddon {
@@ -79,6 +112,7 @@ public:
   virtual void enableCloud() = 0;
   virtual void disableCloud() = 0;
   virtual bool isCloudEnabled() const = 0;
+  virtual int cloudProgress() const = 0;
   #endif
 };
 
@@ -91,6 +125,11 @@ public:
  * 
  * VirtualPin wraps string values with convenient type conversion methods.
  * Supports integers, floats, booleans, strings, and comma-separated arrays.
+ *
+ * Values are kept in a fixed inline buffer (VWIRE_PIN_INLINE_SIZE bytes), so
+ * setting and reading typical values does not allocate. Numeric conversions
+ * are parsed once and cached, and array elements are located through an
+ * offset index built in a single pass on first access.
  */
 class VirtualPin {
 public:
@@ -99,87 +138,138 @@ public:
   // =========================================================================
   
   /** @brief Default constructor - creates empty value */
-  VirtualPin() : _value("") {}
+  VirtualPin() { _init(); }
   
   /** @brief Construct from String */
-  VirtualPin(const String& value) : _value(value) {}
+  VirtualPin(const String& value) { _init(); set(value); }
   
   /** @brief Construct from C-string */
-  VirtualPin(const char* value) : _value(value) {}
+  VirtualPin(const char* value) { _init(); set(value); }
   
   /** @brief Construct from integer */
-  VirtualPin(int value) : _value(String(value)) {}
+  VirtualPin(int value) { _init(); set(value); }
   
   /** @brief Construct from long */
-  VirtualPin(long value) : _value(String(value)) {}
+  VirtualPin(long value) { _init(); set(value); }
   
   /** @brief Construct from unsigned integer */
-  VirtualPin(unsigned int value) : _value(String(value)) {}
+  VirtualPin(unsigned int value) { _init(); set(value); }
   
   /** @brief Construct from unsigned long */
-  VirtualPin(unsigned long value) : _value(String(value)) {}
+  VirtualPin(unsigned long value) { _init(); set(value); }
   
   /** @brief Construct from float (2 decimal places) */
-  VirtualPin(float value) : _value(String(value, 2)) {}
+  VirtualPin(float value) { _init(); set(value); }
   
   /** @brief Construct from double (4 decimal places) */
-  VirtualPin(double value) : _value(String(value, 4)) {}
+  VirtualPin(double value) { _init(); set(value); }
   
   /** @brief Construct from boolean */
-  VirtualPin(bool value) : _value(value ? "1" : "0") {}
+  VirtualPin(bool value) { _init(); set(value); }
+  
+  /** @brief Copy constructor */
+  VirtualPin(const VirtualPin& other) { _init(); _assign(other._data, other._length); }
+  
+  /** @brief Copy assignment */
+  VirtualPin& operator=(const VirtualPin& other) {
+    if (this != &other) _assign(other._data, other._length);
+    return *this;
+  }
+  
+  ~VirtualPin() { _release(); }
   
   // =========================================================================
   // SETTERS
   // =========================================================================
   
   /** @brief Set value from String */
-  void set(const String& value) { _value = value; }
+  void set(const String& value) { _assign(value.c_str(), value.length()); }
   
   /** @brief Set value from C-string */
-  void set(const char* value) { _value = String(value); }
+  void set(const char* value) { _assign(value, value ? strlen(value) : 0); }
+  
+  /**
+   * @brief Set value from a buffer that is not null-terminated
+   * @param value Value bytes
+   * @param length Number of bytes to copy
+   */
+  void set(const char* value, size_t length) { _assign(value, length); }
   
   /** @brief Set value from integer */
-  void set(int value) { _value = String(value); }
+  void set(int value) { set((long)value); }
   
   /** @brief Set value from long */
-  void set(long value) { _value = String(value); }
+  void set(long value);
   
   /** @brief Set value from unsigned integer */
-  void set(unsigned int value) { _value = String(value); }
+  void set(unsigned int value) { set((unsigned long)value); }
   
   /** @brief Set value from unsigned long */
-  void set(unsigned long value) { _value = String(value); }
+  void set(unsigned long value);
   
   /** @brief Set value from float (2 decimal places) */
-  void set(float value) { _value = String(value, 2); }
+  void set(float value) { _setDouble(value, 2); }
   
   /** @brief Set value from double (4 decimal places) */
-  void set(double value) { _value = String(value, 4); }
+  void set(double value) { _setDouble(value, 4); }
   
   /** @brief Set value from boolean */
-  void set(bool value) { _value = value ? "1" : "0"; }
+  void set(bool value) { set(value ? 1L : 0L); }
+  
+  /**
+   * @brief Set value to a comma-separated float array
+   * @param values Array of float values
+   * @param count Number of values
+   * @param decimals Decimal places per element (default 2)
+   */
+  void setArray(const float* values, int count, uint8_t decimals = 2);
+  
+  /**
+   * @brief Set value to a comma-separated int array
+   * @param values Array of int values
+   * @param count Number of values
+   */
+  void setArray(const int* values, int count);
+  
+  /**
+   * @brief Write the setArray() text form into a caller's buffer
+   * @param out Destination, always null-terminated
+   * @param size Size of out in bytes
+   * @return Length written; elements that do not fit are left off the end
+   */
+  static size_t formatArray(char* out, size_t size, const float* values, int count,
+                            uint8_t decimals = 2);
+  
+  /** @brief Int overload of formatArray() */
+  static size_t formatArray(char* out, size_t size, const int* values, int count);
   
   // =========================================================================
   // GETTERS
   // =========================================================================
   
   /** @brief Get value as integer */
-  int asInt() const { return _value.toInt(); }
+  int asInt() const { return (int)_parseLong(); }
   
   /** @brief Get value as float */
-  float asFloat() const { return _value.toFloat(); }
+  float asFloat() const { return (float)_parseDouble(); }
   
   /** @brief Get value as double */
-  double asDouble() const { return _value.toDouble(); }
+  double asDouble() const { return _parseDouble(); }
   
   /** @brief Get value as boolean (true for "1", "true", "on") */
-  bool asBool() const { return _value == "1" || _value.equalsIgnoreCase("true") || _value.equalsIgnoreCase("on"); }
+  bool asBool() const;
+  
+  /**
+   * @brief Get value as String
+   * @note Allocates a new String; prefer asCString() in hot paths
+   */
+  String asString() const { return String(_data); }
   
-  /** @brief Get value as String */
-  String asString() const { return _value; }
+  /** @brief Get value as C-string (valid until the value changes) */
+  const char* asCString() const { return _data; }
   
-  /** @brief Get value as C-string */
-  const char* asCString() const { return _value.c_str(); }
+  /** @brief Get value length in bytes */
+  size_t length() const { return _length; }
   
   // =========================================================================
   // ARRAY SUPPORT (comma-separated values)
@@ -190,12 +280,8 @@ public:
    * @return Element count (1 for non-array values)
    */
   int getArraySize() const {
-    if (_value.length() == 0) return 0;
-    int count = 1;
-    for (size_t i = 0; i < _value.length(); i++) {
-      if (_value.charAt(i) == ',') count++;
-    }
-    return count;
+    _indexArray();
+    return _arraySize;
   }
   
   /**
@@ -203,34 +289,32 @@ public:
    * @param index Zero-based element index
    * @return Element value as int, 0 if index out of range
    */
-  int getArrayInt(int index) const { return getArrayElement(index).toInt(); }
+  int getArrayInt(int index) const;
   
   /**
    * @brief Get array element as float
    * @param index Zero-based element index
    * @return Element value as float, 0.0 if index out of range
    */
-  float getArrayFloat(int index) const { return getArrayElement(index).toFloat(); }
+  float getArrayFloat(int index) const;
   
   /**
    * @brief Get array element as string
    * @param index Zero-based element index
    * @return Element value as String, empty if index out of range
+   * @note Allocates a new String; prefer the buffer overload in hot paths
    */
-  String getArrayElement(int index) const {
-    int start = 0;
-    int count = 0;
-    for (size_t i = 0; i <= _value.length(); i++) {
-      if (i == _value.length() || _value.charAt(i) == ',') {
-        if (count == index) {
-          return _value.substring(start, i);
-        }
-        count++;
-        start = i + 1;
-      }
-    }
-    return "";
-  }
+  String getArrayElement(int index) const;
+  
+  /**
+   * @brief Copy array element into a caller-supplied buffer
+   * @param index Zero-based element index
+   * @param buffer Destination buffer (always null-terminated)
+   * @param size Size of destination buffer
+   * @return Element length in bytes (may exceed size - 1 if truncated),
+   *         or -1 if index out of range
+   */
+  int getArrayElement(int index, char* buffer, size_t size) const;
   
   // =========================================================================
   // TYPE CONVERSION OPERATORS
@@ -246,10 +330,55 @@ public:
   operator bool() const { return asBool(); }
   
   /** @brief Implicit conversion to String */
-  operator String() const { return _value; }
+  operator String() const { return asString(); }
   
 private:
-  String _value;
+  // Cached parse results (bits in _cached)
+  static const uint8_t CACHE_LONG   = 0x01;
+  static const uint8_t CACHE_DOUBLE = 0x02;
+  static const uint8_t CACHE_ARRAY  = 0x04;
+  
+  friend class VwireClass;
+  
+  char _inline[VWIRE_PIN_INLINE_SIZE];  ///< Inline storage for short values
+  char* _data;                          ///< Points at _inline, a heap block or a borrowed buffer
+  size_t _length;                       ///< Value length (excluding '\0')
+  size_t _capacity;                     ///< Usable bytes at _data (0 = borrowed, read-only)
+  
+  mutable uint8_t _cached;
+  mutable long _longValue;
+  mutable double _doubleValue;
+  mutable int _arraySize;
+  mutable uint16_t _offsets[VWIRE_PIN_ARRAY_CACHE];  ///< Element start offsets
+  
+  void _init() {
+    _inline[0] = '\0';
+    _data = _inline;
+    _length = 0;
+    _capacity = sizeof(_inline);
+    _cached = 0;
+  }
+  
+  /**
+   * Reference a null-terminated buffer without copying it. The buffer must
+   * outlive the view; any later set() takes a private copy first.
+   */
+  void _view(const char* value, size_t length) {
+    _release();
+    _data = (char*)value;
+    _length = length;
+    _capacity = 0;
+  }
+  
+  void _release();
+  bool _reserve(size_t capacity);
+  void _assign(const char* value, size_t length);
+  bool _append(const char* value, size_t length);
+  void _setDouble(double value, uint8_t decimals);
+  long _parseLong() const;
+  double _parseDouble() const;
+  void _indexArray() const;
+  const char* _element(int index, size_t* length) const;
 };
 
 // =============================================================================
@@ -267,7 +396,12 @@ struct VwireSettings {
   uint16_t port;                               ///< MQTT broker port
   VwireTransport transport;                    ///< Transport type (TCP or TLS)
   bool autoReconnect;                          ///< Auto-reconnect on disconnect
-  unsigned long reconnectInterval;             ///< Milliseconds between reconnect attempts
+  unsigned long reconnectInterval;             ///< Initial reconnect backoff (ms)
+  unsigned long maxReconnectInterval;          ///< Reconnect backoff limit (ms)
+  unsigned long dnsCacheTtl;                   ///< Cached broker address lifetime (ms, 0 = off)
+  bool tlsSessionCache;                        ///< Resume TLS sessions (ESP8266)
+  uint16_t tlsRxBufferSize;                    ///< BearSSL RX buffer (ESP8266, 0 = auto)
+  uint16_t tlsTxBufferSize;                    ///< BearSSL TX buffer (ESP8266)
   unsigned long heartbeatInterval;             ///< Milliseconds between heartbeats
   unsigned long wifiTimeout;                   ///< WiFi connection timeout (ms)
   unsigned long mqttTimeout;                   ///< MQTT connection timeout (ms)
@@ -279,7 +413,7 @@ struct VwireSettings {
    * 
    * Defaults:
    * - Server: mqtt.vwire.io:8883 (TLS)
-   * - Auto-reconnect: enabled, 5 second interval
+   * - Auto-reconnect: enabled, 5 second backoff doubling up to 60 seconds
   * - Heartbeat: 15 seconds
    */
   VwireSettings() {
@@ -291,6 +425,11 @@ struct VwireSettings {
     dataQoS = 0;                               // PubSubClient only supports QoS 0
     dataRetain = false;                        // Don't retain by default (faster)
     reconnectInterval = VWIRE_DEFAULT_RECONNECT_INTERVAL;
+    maxReconnectInterval = VWIRE_DEFAULT_MAX_RECONNECT_INTERVAL;
+    dnsCacheTtl = VWIRE_DEFAULT_DNS_CACHE_TTL;
+    tlsSessionCache = true;
+    tlsRxBufferSize = VWIRE_TLS_RX_BUFFER_SIZE;
+    tlsTxBufferSize = VWIRE_TLS_TX_BUFFER_SIZE;
     heartbeatInterval = VWIRE_DEFAULT_HEARTBEAT_INTERVAL;
     wifiTimeout = VWIRE_DEFAULT_WIFI_TIMEOUT;
     mqttTimeout = VWIRE_DEFAULT_MQTT_TIMEOUT;
@@ -301,13 +440,23 @@ struct VwireSettings {
 // CALLBACK TYPES
 // =============================================================================
 
-/** @brief Handler function for virtual pin write events */
+/**
+ * @brief Handler function for virtual pin write events
+ * @note The VirtualPin views the MQTT receive buffer (VWIRE_ENABLE_ZERO_COPY)
+ * and is valid until the handler returns. Sends, publish() and subscribe()
+ * inside the handler leave it intact, since the library frames outgoing
+ * packets itself; calling run() reads the next packet over it. Copy the
+ * VirtualPin to keep the value longer.
+ */
 typedef void (*PinHandler)(VirtualPin&);
 
 /** @brief Handler function for connection/disconnection events */
 typedef void (*ConnectionHandler)();
 
-/** @brief Handler function for raw MQTT messages */
+/**
+ * @brief Handler function for raw MQTT messages
+ * @note topic/payload are only valid for the duration of the call
+ */
 typedef void (*RawMessageHandler)(const char* topic, const char* payload);
 
 // =============================================================================
@@ -565,11 +714,22 @@ public:
   void setAutoReconnect(bool enable);
   
   /**
-   * @brief Set reconnection attempt interval
-   * @param interval Milliseconds between reconnect attempts
+   * @brief Set the initial reconnect delay
+   *
+   * The delay doubles after each failed attempt up to the limit set with
+   * setMaxReconnectInterval(), and is randomized so a fleet recovering from
+   * a broker outage does not reconnect in lockstep.
+   *
+   * @param interval Milliseconds before the first reconnect attempt (default: 5000)
    */
   void setReconnectInterval(unsigned long interval);
   
+  /**
+   * @brief Set the upper bound for the reconnect backoff
+   * @param interval Maximum milliseconds between reconnect attempts (default: 60000)
+   */
+  void setMaxReconnectInterval(unsigned long interval);
+  
   /**
    * @brief Set heartbeat interval
    * @param interval Milliseconds between heartbeats
@@ -616,6 +776,183 @@ public:
    */
   void onDeliveryStatus(DeliveryCallback cb);
   
+  // =========================================================================
+  // PUBLISH POLICY
+  // =========================================================================
+  
+  /**
+   * @brief Filter and rate-limit writes to a virtual pin
+   *
+   * virtualSend() calls for the pin pass through the policy first: values
+   * inside the deadband are skipped, and writes faster than minInterval are
+   * coalesced so only the latest one is sent when the interval ends. With
+   * maxInterval set, the current value is republished after that long
+   * without a message. Values longer than VWIRE_POLICY_VALUE_SIZE bypass
+   * the policy.
+   *
+   * @param pin Virtual pin number (0-127)
+   * @param policy Deadband and interval settings (see VwirePublishPolicy)
+   * @return false if the pin is invalid or all VWIRE_MAX_PUBLISH_POLICIES
+   *         slots are in use
+   */
+  bool setPublishPolicy(uint8_t pin, const VwirePublishPolicy& policy);
+  
+  /**
+   * @brief Remove a virtual pin's publish policy (every write is sent again)
+   * @param pin Virtual pin number
+   */
+  void clearPublishPolicy(uint8_t pin);
+  
+  // =========================================================================
+  // COMMAND COALESCING
+  // =========================================================================
+  
+  /**
+   * @brief Deliver only the newest command for a virtual pin ("latest wins")
+   *
+   * Commands for the pin go to a one-entry mailbox while run() reads the
+   * MQTT connection, and the pin's handler is then called once with the
+   * newest value. Meant for sliders, joysticks and colour pickers driving
+   * servos or LED strips, where stale positions only cost time. While
+   * commands are only filling mailboxes, run() reads up to
+   * VWIRE_COALESCE_MAX_READS more packets, so a burst is absorbed in one
+   * call. Commands of VWIRE_COALESCE_VALUE_SIZE bytes or more are
+   * delivered at once.
+   *
+   * @param pin Virtual pin number (0-127)
+   * @param enable false returns the pin to one handler call per command
+   * @return false if the pin is invalid or all VWIRE_MAX_COALESCED_PINS
+   *         slots are in use
+   */
+  bool setCommandCoalescing(uint8_t pin, bool enable = true);
+  
+  /**
+   * @brief Commands replaced by newer ones before the running handler was called
+   * @return Count for the current handler call, 0 outside coalesced handlers
+   */
+  uint16_t getDroppedCommands() const;
+  
+  // =========================================================================
+  // OFFLINE QUEUE (ESP32/ESP8266)
+  // =========================================================================
+  
+  /**
+   * @brief Journal pin writes to flash while disconnected
+   *
+   * When enabled, virtualSend() calls made without an MQTT connection are
+   * recorded with a timestamp in a ring buffer on LittleFS instead of being
+   * dropped. After reconnecting they are replayed in batches on
+   * vwire/{deviceId}/batch, oldest first, as [pin,"value",ageMs] entries.
+   * When the journal is full the oldest writes are overwritten.
+   *
+   * @param enable true to enable (mounts LittleFS on first use)
+   * @return true if the queue is available on this board/build
+   */
+  bool setOfflineQueue(bool enable);
+  
+  /**
+   * @brief Pace replay of journaled writes after reconnecting
+   * @param perBatch Writes per batch message (default: 16)
+   * @param interval Milliseconds between batch messages (default: 250)
+   */
+  void setOfflineDrainRate(uint8_t perBatch, unsigned long interval);
+  
+  /**
+   * @brief Number of journaled writes waiting to be replayed
+   */
+  uint32_t getOfflineQueued();
+  
+  /**
+   * @brief Discard all journaled writes
+   */
+  void clearOfflineQueue();
+  
+  // =========================================================================
+  // CONNECTION CACHE
+  // =========================================================================
+  
+  /**
+   * @brief Set how long the resolved broker address is reused
+   *
+   * Reconnects skip the DNS lookup while the cached address is fresh. A
+   * failed connect drops the cache, so a moved broker is found again on the
+   * next attempt.
+   *
+   * @param ttl Milliseconds (default: 300000, 0 = resolve on every connect)
+   */
+  void setDnsCacheTtl(unsigned long ttl);
+  
+  /**
+   * @brief Resume TLS sessions on reconnect (ESP8266)
+   *
+   * BearSSL keeps the session ID from the last handshake and offers it on
+   * the next connect. If the broker accepts it, the reconnect skips the key
+   * exchange, which is most of the handshake time. The ESP32 TLS client has
+   * no session API, so this has no effect there.
+   *
+   * @param enable true to resume sessions (default), false for full handshakes
+   */
+  void setTlsSessionCache(bool enable);
+  
+  /**
+   * @brief Set BearSSL I/O buffer sizes (ESP8266)
+   *
+   * Pass rx = 0 to size the receive buffer automatically: before the first TLS
+   * connect, the broker is probed for the smallest max fragment length
+   * (512-4096 bytes) that holds VWIRE_MAX_PAYLOAD_LENGTH. If it supports none,
+   * the library falls back to the full 16 KB TLS record buffer.
+   *
+   * @param rx Receive buffer in bytes (default: 2048, 0 = auto)
+   * @param tx Transmit buffer in bytes (default: 1024)
+   */
+  void setTlsBufferSizes(uint16_t rx, uint16_t tx);
+  
+  /**
+   * @brief Keep the broker address and TLS session across deep sleep
+   *
+   * Call right before entering deep sleep. The cache goes to RTC memory
+   * (RTC_DATA_ATTR on ESP32, RTC user memory on ESP8266). The next begin()
+   * or beginAsync() after waking restores it, so the first connect needs no
+   * DNS lookup and can resume the TLS session.
+   *
+   * The current WiFi BSSID, channel and IP configuration are saved too. On
+   * wake, begin(ssid, password) joins that access point directly with a
+   * static IP, skipping the scan and DHCP. If that fails within
+   * VWIRE_FAST_WAKE_WIFI_TIMEOUT it falls back to a normal connect.
+   *
+   * @param sleepMs Planned sleep duration, charged against the DNS TTL
+   * @return true if anything was saved
+   */
+  bool saveConnectionCache(unsigned long sleepMs = 0);
+  
+  /**
+   * @brief Forget the cached broker address, TLS session and WiFi (RAM and RTC)
+   */
+  void clearConnectionCache();
+  
+  // =========================================================================
+  // DEEP SLEEP (ESP32/ESP8266)
+  // =========================================================================
+  
+  /**
+   * @brief Deliver pending writes, then enter deep sleep
+   *
+   * Intended for battery nodes that wake, send a few values and sleep again:
+   * 1. Waits for the connection if it is still coming up
+   * 2. Flushes pending batched writes
+   * 3. Runs until reliable-delivery ACKs and offline-queue replay finish
+   * 4. Saves the connection cache (see saveConnectionCache()) and disconnects
+   * 5. Enters timer deep sleep
+   *
+   * Steps 1 and 3 stop early once their work is done, bounded by maxWaitMs in
+   * total. On ESP8266 the wake requires GPIO16 wired to RST.
+   *
+   * @param sleepMs Deep sleep duration in milliseconds
+   * @param maxWaitMs Upper bound for steps 1 and 3 (default: 5000)
+   * @return false if deep sleep is not available (otherwise does not return)
+   */
+  bool publishAndSleep(unsigned long sleepMs, unsigned long maxWaitMs = VWIRE_DEFAULT_SLEEP_WAIT);
+  
   // =========================================================================
   // CONNECTION METHODS
   // =========================================================================
@@ -634,12 +971,64 @@ public:
    */
   bool begin();
   
+  /**
+   * @brief Start connecting to WiFi and MQTT without waiting
+   *
+   * Returns immediately. The connection is then advanced one step per run()
+   * call (WiFi association, DNS lookup, TCP/TLS connect, MQTT CONNECT), so
+   * timers and local control logic in loop() keep running while the device
+   * comes online. Use connected() or onConnect() to find out when it is up.
+   *
+   * @param ssid WiFi network name
+   * @param password WiFi password
+   * @return false if no auth token is configured
+   */
+  bool beginAsync(const char* ssid, const char* password);
+  
+  /**
+   * @brief Start connecting to MQTT without waiting, using the current WiFi
+   *
+   * If WiFi is not associated yet, run() waits for it (up to the WiFi
+   * timeout) before connecting to the broker.
+   *
+   * @return false if no auth token is configured
+   */
+  bool beginAsync();
+  
   /**
    * @brief Process MQTT messages and maintain connection
-   * @note Must be called frequently in loop()
+   * @note Must be called frequently in loop(). With the network task
+   *       running it only delivers queued commands to VWIRE_RECEIVE
+   *       handlers and services registered timers.
    */
   void run();
   
+  /**
+   * @brief Move networking to a FreeRTOS task (ESP32 only)
+   *
+   * Call after begin() or beginAsync(). From then on the MQTT client,
+   * reconnects, heartbeats and all addons run in a task pinned to
+   * VWIRE_NET_TASK_CORE. virtualSend() only queues the value, so loop()
+   * never waits on TLS writes or reconnects; VWIRE_RECEIVE handlers still
+   * run on the caller's core from run(). Other publishing calls (notify(),
+   * publish(), syncVirtual(), ...) wait for the network task for at most
+   * VWIRE_NET_LOCK_TIMEOUT ms and fail with VWIRE_ERR_TIMEOUT while it is
+   * busy reconnecting.
+   *
+   * @param core       Core to pin the task to
+   * @param stackSize  Task stack in bytes
+   * @param priority   FreeRTOS priority
+   * @return false if unavailable, already running, or out of memory
+   */
+  bool startNetworkTask(uint8_t core = VWIRE_NET_TASK_CORE,
+                        uint32_t stackSize = VWIRE_NET_TASK_STACK,
+                        uint8_t priority = VWIRE_NET_TASK_PRIORITY);
+  
+  /**
+   * @brief true once startNetworkTask() succeeded
+   */
+  bool isNetworkTaskRunning() const;
+  
   /**
    * @brief Check if connected to MQTT broker
    * @return true if connected
@@ -648,9 +1037,66 @@ public:
   
   /**
    * @brief Disconnect from MQTT broker
+   * @note Stops auto-reconnect until begin() or beginAsync() is called again
    */
   void disconnect();
   
+  // =========================================================================
+  // WIFI NETWORKS (ESP32/ESP8266 only)
+  // =========================================================================
+  
+  /**
+   * @brief Add a network the device may join
+   *
+   * The network passed to begin() is added automatically. With more than
+   * one network, connecting scans first and joins the strongest access
+   * point of any of them, and a dropped connection rescans instead of
+   * retrying the old access point.
+   *
+   * @param ssid WiFi network name
+   * @param password WiFi password (nullptr for an open network)
+   * @return false if the list is full or roaming is not available
+   */
+  bool addNetwork(const char* ssid, const char* password = nullptr);
+  
+  /**
+   * @brief Forget every network added with addNetwork() or begin()
+   */
+  void clearNetworks();
+  
+  /**
+   * @brief Number of known networks
+   */
+  uint8_t getNetworkCount();
+  
+  /**
+   * @brief Roam between access points of the connected network
+   *
+   * Also enables scan-based access point selection with a single network.
+   * While connected the RSSI is sampled every VWIRE_ROAM_CHECK_INTERVAL;
+   * below rssiThreshold a background scan looks for an access point of the
+   * same network that is VWIRE_ROAM_HYSTERESIS dB stronger and
+   * reassociates to it. The IP address and the MQTT connection are kept
+   * when the network hands the device over quickly; otherwise it
+   * reconnects as usual. Enabled automatically with more than one network.
+   *
+   * @param enable Roam while connected
+   * @param rssiThreshold Signal level (dBm) below which to look for a better access point
+   */
+  void setRoaming(bool enable, int8_t rssiThreshold = VWIRE_ROAM_RSSI_THRESHOLD);
+  
+  /**
+   * @brief Save the known networks in the config store
+   * @return false if the store is unavailable
+   */
+  bool saveNetworks();
+  
+  /**
+   * @brief Load networks saved by saveNetworks(), replacing the current list
+   * @return false if nothing is saved
+   */
+  bool loadNetworks();
+  
   // =========================================================================
   // STATE METHODS
   // =========================================================================
@@ -686,7 +1132,7 @@ public:
   template<typename T>
   void virtualSend(uint8_t pin, T value) {
     VirtualPin vp(value);
-    _virtualSendInternal(pin, vp.asString());
+    _virtualSendInternal(pin, vp.asCString());
   }
   
   /**
@@ -705,6 +1151,27 @@ public:
    */
   void virtualSendArray(uint8_t pin, int* values, int count);
   
+  /**
+   * @brief Offer a binary payload encoding to the server
+   *
+   * With VWIRE_ENCODING_CBOR the online status announces "enc":"cbor" and
+   * the device switches once the server publishes "cbor" to
+   * vwire/{deviceId}/encoding (or "text" to switch back). From then on pin
+   * values, arrays and batches are CBOR; virtualSendArray() sends raw
+   * float32/int values without rounding, encoded straight into the MQTT
+   * client. Negotiation repeats on every connection.
+   *
+   * @param encoding VWIRE_ENCODING_TEXT (default) or VWIRE_ENCODING_CBOR
+   * @param force    Use it immediately without waiting for the server
+   *                 (for backends that always expect it)
+   */
+  void setPayloadEncoding(VwireEncoding encoding, bool force = false);
+  
+  /**
+   * @brief Encoding currently used for outgoing pin data
+   */
+  VwireEncoding getPayloadEncoding() const;
+  
   /**
    * @brief Send formatted string to virtual pin
    * @param pin Virtual pin number
@@ -713,6 +1180,60 @@ public:
    */
   void virtualSendf(uint8_t pin, const char* format, ...);
   
+  // =========================================================================
+  // BATCHED SEND OPERATIONS
+  // =========================================================================
+  
+  /**
+   * @brief Start collecting virtual pin writes into a single batch
+   *
+   * Every virtualSend()/virtualSendArray()/virtualSendf() call made until
+   * commitBatch() is appended to an internal buffer instead of being
+   * published immediately. The whole batch then goes out as one MQTT
+   * message on vwire/{deviceId}/batch, which saves a TLS record and a
+   * broker round trip per pin.
+   *
+   * @code
+   * Vwire.beginBatch();
+   * Vwire.virtualSend(V0, temperature);
+   * Vwire.virtualSend(V1, humidity);
+   * Vwire.virtualSend(V2, pressure);
+   * Vwire.commitBatch();   // one publish for all three pins
+   * @endcode
+   *
+   * @note Writes routed through reliable delivery are never batched.
+   */
+  void beginBatch();
+  
+  /**
+   * @brief Publish all pin writes collected since beginBatch()
+   * @return true if the batch was published (or was empty)
+   */
+  bool commitBatch();
+  
+  /**
+   * @brief Automatically batch every pin write within a time window
+   *
+   * When set, pin writes are collected without an explicit beginBatch()
+   * and run() flushes them once the oldest pending write is @p window
+   * milliseconds old. A full buffer is always flushed immediately.
+   *
+   * @param window Flush window in milliseconds (0 = disabled, default)
+   */
+  void setBatchWindow(unsigned long window);
+  
+  /**
+   * @brief Check whether pin writes are currently being batched
+   * @return true inside beginBatch()/commitBatch() or with a batch window set
+   */
+  bool isBatching() const;
+  
+  /**
+   * @brief Get the number of pin writes waiting in the batch buffer
+   * @return Pending write count
+   */
+  uint8_t getBatchCount() const;
+  
   // =========================================================================
   // SYNC OPERATIONS
   // =========================================================================
@@ -885,6 +1406,89 @@ public:
    */
   uint32_t getUptime();
   
+  // =========================================================================
+  // RUNTIME METRICS
+  // =========================================================================
+  
+  /**
+   * @brief Runtime counters and latency histograms
+   *
+   * Covers the whole run() call, PubSubClient::loop(), inbound dispatch,
+   * publishes and each addon's onRun(). Also counts traffic, dropped
+   * writes and reconnects, and records heap watermarks (sampled once per
+   * second). All values accumulate since start or the last resetMetrics().
+   * Without VWIRE_ENABLE_METRICS the snapshot stays zeroed.
+   */
+  const VwireMetrics& getMetrics();
+  
+  /**
+   * @brief Clear all metrics and restart collection
+   */
+  void resetMetrics();
+  
+  /**
+   * @brief Print a metrics summary (count / avg / p99 / max per section)
+   * @param out Destination, e.g. Serial
+   */
+  void printMetrics(Print& out);
+  
+  /**
+   * @brief Add a compact "metrics" object to each heartbeat
+   * @param enable true to include metrics (default: false)
+   */
+  void setMetricsInHeartbeat(bool enable);
+  
+  // =========================================================================
+  // BENCHMARK
+  // =========================================================================
+  
+  /**
+   * @brief Start the on-device benchmark (see VwireBenchmark.h)
+   *
+   * Runs from run() while connected, so loop() must keep calling it. It
+   * publishes on pin and probes through the pin's command topic: pick a
+   * pin no widget or handler uses. The report goes to
+   * vwire/<deviceId>/bench; a dropped connection aborts the run.
+   * @param publishMs Length of the publish phase (ms)
+   * @param pin Virtual pin to publish and probe on
+   * @return false if not connected, already running or stripped
+   */
+  bool startBenchmark(unsigned long publishMs = VWIRE_BENCH_PUBLISH_MS,
+                      uint8_t pin = VWIRE_BENCH_PIN);
+  
+  /** @brief true from startBenchmark() until the report is sent */
+  bool isBenchmarkRunning() const;
+  
+  /** @brief Figures of the last (or current) benchmark run */
+  const VwireBenchmarkResult& getBenchmarkResult() const;
+  
+  // =========================================================================
+  // MEMORY BUDGET
+  // =========================================================================
+  
+  /**
+   * @brief Give the library a fixed RAM budget
+   *
+   * Call before begin(). One heap block is sized for what this build
+   * carves from it later: the Cloud OTA read chunk and SHA-256 state and,
+   * on ESP32, the network task queues and stack (VWIRE_NET_TASK_STACK);
+   * a subsystem that does not fit whole is left to the heap. The rest of
+   * the budget, up to VWIRE_MAX_PAYLOAD_LENGTH, becomes the MQTT packet
+   * buffer; anything beyond that is not allocated. Carves are kept for
+   * reuse, so these buffers are not allocated again.
+   *
+   * @param bytes Total budget in bytes (at least 256)
+   * @return false if a budget is already set, bytes is below 256 or an
+   *         allocation failed
+   */
+  bool setMemoryBudget(size_t bytes);
+  
+  /**
+   * @brief Print what each subsystem got from the budget
+   * @param out Destination, e.g. Serial
+   */
+  void printMemoryReport(Print& out);
+  
   // =========================================================================
   // OTA UPDATES (ESP32/ESP8266 only)
   // =========================================================================
@@ -935,6 +1539,12 @@ public:
    * @return true if cloud OTA is enabled
    */
   bool isCloudOTAEnabled();
+
+  /**
+   * @brief Progress of the running Cloud OTA download
+   * @return 0-100, or -1 when no update is in progress
+   */
+  int getCloudOTAProgress();
   #endif
 
   // =========================================================================
@@ -982,6 +1592,24 @@ public:
 
   /** @brief Get the number of managed GPIO pins */
   uint8_t getGPIOPinCount() const;
+
+  /** @brief Set the publish policy of a managed GPIO input pin */
+  bool setGPIOPublishPolicy(const char* pinName, const VwirePublishPolicy& policy);
+
+  /** @brief Set the oversampling / smoothing filter of a managed analog input pin */
+  bool setGPIOAnalogFilter(const char* pinName, const VwireAnalogFilter& filter);
+
+  /** @brief Report a managed digital input on its edges instead of polling it */
+  bool setGPIOEdgeTrigger(const char* pinName, bool enable, uint16_t debounceMs = VWIRE_GPIO_DEBOUNCE_MS);
+
+  /** @brief Pulses counted on a managed COUNTER or FREQUENCY pin */
+  uint32_t getGPIOPulseCount(const char* pinName) const;
+
+  /** @brief Pulse rate of a managed COUNTER or FREQUENCY pin (Hz) */
+  float getGPIOFrequency(const char* pinName) const;
+
+  /** @brief Restart the running total of a managed COUNTER or FREQUENCY pin */
+  bool resetGPIOPulseCount(const char* pinName);
   
   // =========================================================================
   // ADDON SYSTEM
@@ -1001,6 +1629,55 @@ public:
    */
   void addAddon(VwireAddon& addon);
 
+  // =========================================================================
+  // COOPERATIVE SCHEDULER
+  // =========================================================================
+
+  /**
+   * @brief Run an addon on a period, with a priority and a soft time budget
+   *
+   * The addon must already be registered. A budget cannot interrupt
+   * onRun(); calls that take longer are counted as overruns in
+   * getMetrics().addonOverruns.
+   *
+   * @param addon     Registered addon
+   * @param periodMs  Minimum ms between onRun() calls (0 = every run())
+   * @param budgetUs  Expected worst-case onRun() time in us (0 = unchecked)
+   * @param priority  Order among tasks due in the same run() call
+   * @return false if the addon is not registered
+   * @code
+   * Vwire.setAddonSchedule(gpio, 10, 2000, VWIRE_PRIORITY_HIGH);
+   * @endcode
+   */
+  bool setAddonSchedule(VwireAddon& addon, uint32_t periodMs, uint32_t budgetUs = 0,
+                        VwireTaskPriority priority = VWIRE_PRIORITY_NORMAL);
+
+  /**
+   * @brief Let run() drive a VwireTimer
+   *
+   * The timer is serviced by every run() call, connected or not, so the
+   * sketch no longer calls timer.run() itself. Its callbacks stop for the
+   * call once budgetUs is spent; the rest keep their deadlines.
+   *
+   * @param timer     Timer to service (must outlive Vwire)
+   * @param budgetUs  Time budget per pass in us (0 = run everything due)
+   * @param priority  Order among tasks due in the same run() call
+   * @return false if VWIRE_MAX_SCHED_TIMERS timers are already registered
+   */
+  bool addTimer(VwireTimer& timer, uint32_t budgetUs = 0,
+                VwireTaskPriority priority = VWIRE_PRIORITY_NORMAL);
+
+  /**
+   * @brief Cap the time one run() call spends on addons and timers
+   *
+   * Measured from the start of run(), including the MQTT client loop
+   * (which always runs first so commands are never held back). Due tasks
+   * that do not fit wait for the next call and then run first.
+   *
+   * @param budgetUs Microseconds per run() call (0 = unlimited, default)
+   */
+  void setRunBudget(uint32_t budgetUs);
+
   // =========================================================================
   // PUBLISH / SUBSCRIBE (for addons & advanced users)
   // =========================================================================
@@ -1076,6 +1753,8 @@ private:
   VwireState _state;                    ///< Current connection state
   VwireError _lastError;                ///< Last error code
   char _deviceId[VWIRE_MAX_TOKEN_LENGTH]; ///< Device identifier
+  char _topicPrefix[VWIRE_MAX_TOKEN_LENGTH + 7]; ///< "vwire/<deviceId>/", kept with _deviceId
+  uint8_t _topicPrefixLength;
   char _hostname[33];                    ///< User-defined hostname (max 32 chars + null)
   bool _debug;                          ///< Debug output enabled (legacy)
   Stream* _debugStream;                 ///< Debug output stream (legacy)
@@ -1084,7 +1763,37 @@ private:
   
   // Timing
   unsigned long _lastHeartbeat;         ///< Last heartbeat timestamp
-  unsigned long _lastReconnectAttempt;  ///< Last reconnect attempt timestamp
+  
+  // Connection engine (advanced one step per run() call)
+  VwireConnectStep _connectStep;        ///< Current connection step
+  unsigned long _stepStartedAt;         ///< Time the current step started
+  unsigned long _nextAttemptAt;         ///< Backoff: time of the next attempt
+  uint8_t _reconnectAttempts;           ///< Failed attempts since last success
+  IPAddress _brokerIP;                  ///< Resolved broker address
+  bool _brokerIPCached;                 ///< _brokerIP may be reused until _brokerIPExpires
+  unsigned long _brokerIPExpires;       ///< DNS cache expiry
+  char _wifiSsid[33];                   ///< SSID from begin(), for the fast-wake fallback
+  char _wifiPassword[65];               ///< Password from begin(), for the fast-wake fallback
+  bool _fastWakeAttempt;                ///< WiFi step is using cached BSSID/channel/IP
+  #if VWIRE_ENABLE_ROAMING
+  /** @brief One known WiFi network */
+  struct RoamNetwork {
+    char ssid[33];
+    char password[65];
+  };
+  RoamNetwork _networks[VWIRE_MAX_NETWORKS]; ///< From addNetwork() and begin()
+  uint8_t _networkCount;                ///< Used entries of _networks
+  bool _roamEnabled;                    ///< setRoaming(true)
+  int8_t _roamThreshold;                ///< Background scans start below this RSSI
+  bool _roamScanning;                   ///< Background scan in progress
+  bool _roamPending;                    ///< Reassociating; save the new AP once joined
+  unsigned long _roamCheckedAt;         ///< Last RSSI sample
+  unsigned long _roamScanAt;            ///< Last background scan start
+  #endif
+  #if defined(VWIRE_BOARD_ESP8266)
+  BearSSL::Session _tlsSession;         ///< Last TLS session, offered on reconnect
+  uint16_t _tlsAutoRxSize;              ///< Probed RX buffer size (0 = not probed)
+  #endif
   
   // Network clients (member variables for stable TLS)
   WiFiClient _wifiClient;               ///< Plain TCP client
@@ -1092,15 +1801,17 @@ private:
   WiFiClientSecure _secureClient;       ///< TLS/SSL client
   #endif
   PubSubClient _mqttClient;             ///< MQTT client
+  uint16_t _mqttBufferSize;             ///< PubSubClient packet buffer (from the budget)
+  uint16_t _subscribeId;                ///< Packet id of the last _streamSubscribe()
+  #if VWIRE_ENABLE_ARENA
+  VwireArena _arena;                    ///< Long-lived buffers, see setMemoryBudget()
+  #endif
   
-  // Handlers
-  struct PinHandlerEntry {
-    uint8_t pin;                        ///< Pin number
-    PinHandler handler;                 ///< Handler function
-    bool active;                        ///< Entry in use
-  };
-  PinHandlerEntry _pinHandlers[VWIRE_MAX_HANDLERS];  ///< Manual handler table
-  int _pinHandlerCount;                              ///< Number of registered handlers
+  // Handlers (direct-indexed by virtual pin number)
+  PinHandler _pinHandlers[VWIRE_MAX_VIRTUAL_PINS];     ///< Dispatch table
+  uint8_t _manualPins[VWIRE_MAX_VIRTUAL_PINS / 8];     ///< Bit set: entry came from onVirtualReceive()
+  int _pinHandlerCount;                                ///< Number of manually registered handlers
+  uint8_t _autoHandlersMerged;                         ///< VWIRE_RECEIVE entries already in the table
   
   ConnectionHandler _connectHandler;     ///< Manual connect handler
   ConnectionHandler _disconnectHandler;  ///< Manual disconnect handler
@@ -1112,29 +1823,302 @@ private:
   VwireGPIO* _gpioAddon;                 ///< Active GPIO addon, if attached
   VwireReliableDelivery* _reliableDeliveryAddon; ///< Reliable delivery module
   VwireOTAFeature* _otaFeature;          ///< OTA feature module
+  VwireOfflineQueue* _offlineQueue;      ///< Flash-backed offline queue module
+
+  // Payload encoding
+  #if VWIRE_ENABLE_CBOR
+  bool _cborOffered;                     ///< setPayloadEncoding(CBOR) was called
+  bool _cborForced;                      ///< Use CBOR without server confirmation
+  bool _cborActive;                      ///< Encode outgoing pin data as CBOR
+  #endif
+
+  // Network task (ESP32)
+  #if VWIRE_ENABLE_NETWORK_TASK
+  /** @brief Pin write, batch marker or inbound command crossing between tasks */
+  struct NetItem {
+    uint8_t op;                          ///< VWIRE_NET_OP_*
+    uint8_t pin;                         ///< Virtual pin
+    char value[VWIRE_NET_VALUE_SIZE];    ///< Null-terminated value
+  };
+  TaskHandle_t _netTask;                 ///< Network task (nullptr = not started)
+  QueueHandle_t _netOutbound;            ///< App -> network: NetItem
+  QueueHandle_t _netInbound;             ///< Network -> app: NetItem (commands)
+  SemaphoreHandle_t _netMutex;           ///< Recursive: held by the task while it works
+  #endif
+
+  /**
+   * @brief Holds the network task lock for the current scope
+   *
+   * App-side publishers check locked: without wait the lock is given up
+   * after VWIRE_NET_LOCK_TIMEOUT. Pass wait for calls that must not be lost.
+   */
+  struct NetGuard {
+    VwireClass* vwire;
+    bool locked;
+    NetGuard(VwireClass* vwire, bool wait)
+      : vwire(vwire), locked(vwire->_netLock(wait)) {}
+    ~NetGuard() { if (locked) vwire->_netUnlock(); }
+  };
+
+  // Cooperative scheduler
+  #if VWIRE_ENABLE_SCHEDULER
+  /** @brief One addon or registered timer and its schedule */
+  struct SchedTask {
+    VwireAddon* addon;                   ///< Addon task (nullptr for a timer)
+    VwireTimer* timer;                   ///< Timer task (nullptr for an addon)
+    uint32_t periodMs;                   ///< Addons: min ms between runs (0 = every call)
+    uint32_t budgetUs;                   ///< Soft budget per run (0 = unchecked)
+    unsigned long nextRun;               ///< Addons: next due time
+    uint8_t addonIndex;                  ///< Addons: index into _addons / metrics
+    uint8_t priority;                    ///< VwireTaskPriority
+    bool deferred;                       ///< Skipped by the run budget last call
+  };
+  SchedTask _tasks[VWIRE_MAX_TASKS];     ///< Sorted by priority (stable)
+  uint8_t _taskCount;                    ///< Tasks in use
+  uint32_t _runBudgetUs;                 ///< Per-run() budget (0 = unlimited)
+  #endif
+
+  // Runtime metrics
+  #if VWIRE_ENABLE_METRICS
+  VwireMetrics _metrics;                 ///< Counters and histograms
+  bool _metricsInHeartbeat;              ///< Append metrics to the heartbeat
+  unsigned long _metricsSampledAt;       ///< Last heap watermark sample
+  unsigned long _outageStartedAt;        ///< Time of the last drop (0 = none)
+  #endif
+  
+  // Publish policies (virtual pins)
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  /** @brief Policy state plus the latest value held back for a pin */
+  struct PolicySlot {
+    VwirePublishGate gate;
+    uint8_t pin;
+    bool numeric;
+    char value[VWIRE_POLICY_VALUE_SIZE];
+  };
+  PolicySlot _policies[VWIRE_MAX_PUBLISH_POLICIES];  ///< Slots in use: [0, _policyCount)
+  uint8_t _policyCount;                               ///< Slots in use
+  uint8_t _policyIndex[VWIRE_MAX_VIRTUAL_PINS];       ///< Pin -> slot (0xFF = none)
+  #endif
+  
+  // Latest-wins command mailboxes (virtual pins)
+  #if VWIRE_ENABLE_COALESCING
+  /** @brief Newest command for a coalesced pin, waiting for run() */
+  struct CoalesceSlot {
+    uint8_t pin;
+    bool pending;
+    uint16_t length;
+    uint16_t dropped;                    ///< Commands replaced before the handler ran
+    char value[VWIRE_COALESCE_VALUE_SIZE];
+  };
+  CoalesceSlot _coalesce[VWIRE_MAX_COALESCED_PINS]; ///< Slots in use: [0, _coalesceCount)
+  uint8_t _coalesceCount;                           ///< Slots in use
+  uint8_t _coalesceIndex[VWIRE_MAX_VIRTUAL_PINS];   ///< Pin -> slot (0xFF = none)
+  uint8_t _coalescePending;                         ///< Slots holding a command
+  bool _coalesceStored;                             ///< Last command went to a mailbox
+  uint16_t _coalesceDropped;                        ///< getDroppedCommands() value
+  #endif
+  
+  // Batched publishing
+  #if VWIRE_ENABLE_BATCH
+  char _batchBuffer[VWIRE_BATCH_BUFFER_SIZE]; ///< Pending batch entries (without brackets)
+  uint16_t _batchLength;                 ///< Bytes used in _batchBuffer
+  uint8_t _batchCount;                   ///< Number of pending pin writes
+  bool _batchActive;                     ///< Inside beginBatch()/commitBatch()
+  unsigned long _batchWindow;            ///< Auto-batch flush window (0 = off)
+  unsigned long _batchStartedAt;         ///< Time the first pending write was queued
+  bool _batchLost;                       ///< A flush failed since the offline queue last cleared it
+  #endif
   
   // =========================================================================
   // PRIVATE METHODS
   // =========================================================================
   
-  bool _connectWiFi(const char* ssid, const char* password);
+  void _startWiFi(const char* ssid, const char* password);
   bool _connectMQTT();
   void _setupClient();
+  Client& _transportClient();
+  bool _advanceConnection();
+  void _scheduleReconnect();
+  void _notifyDisconnect(const char* reason);
+  void _restoreConnectionCache();
+  bool _beginFastWake(const char* ssid, const char* password);
+  void _dropFastWake();
+  void _saveAccessPoint();
+  #if VWIRE_ENABLE_ROAMING
+  bool _roamActive() const;
+  bool _roamFastWake();
+  void _roamStartScan();
+  void _roamConnectStep();
+  int _roamPick(int found, const char* ssid, int& network);
+  void _roamRun(unsigned long now);
+  #endif
+  void _applyTlsBufferSizes();
   void _handleMessage(char* topic, byte* payload, unsigned int length);
+  void _dispatchMessage(char* topic, char* payload, unsigned int length);
+  #if VWIRE_ENABLE_ZERO_COPY
+  bool _payloadHasSlack(const char* topic, const byte* payload, unsigned int length);
+  #endif
+
+  /** @brief Carve from the arena; nullptr without a budget or when it is full */
+  void* _arenaAllocate(size_t size, const char* owner) {
+    #if VWIRE_ENABLE_ARENA
+    return _arena.allocate(size, owner);
+    #else
+    (void)size; (void)owner;
+    return nullptr;
+    #endif
+  }
+
+  /** @brief Whether block came from _arenaAllocate() (never freed) */
+  bool _arenaOwns(const void* block) const {
+    #if VWIRE_ENABLE_ARENA
+    return _arena.owns(block);
+    #else
+    (void)block;
+    return false;
+    #endif
+  }
+
+  void _classifyMessage(VwireMessage& message);
+  void _mergeAutoHandlers();
   static void _mqttCallbackWrapper(char* topic, byte* payload, unsigned int length);
-  void _virtualSendInternal(uint8_t pin, const String& value);
-  String _buildTopic(const char* type, int pin = -1);
+  void _virtualSendInternal(uint8_t pin, const char* value);
+  void _deliverPin(uint8_t pin, const char* value);
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  bool _policyAdmit(uint8_t pin, const char* value);
+  void _policyRun(unsigned long now);
+  #endif
+  bool _publishPin(uint8_t pin, const char* value);
+  bool _streamPublish(const char* topic, const char* payload, size_t length, bool retain);
+  bool _streamSubscribe(const char* topic, uint8_t qos);
+
+  /**
+   * @brief Publish JSON produced by body(VwireJsonWriter&) without a buffer
+   *
+   * body runs twice: into a counting writer for the packet length, then
+   * into a VwirePublishStream on the transport.
+   */
+  template <typename Body>
+  bool _publishJson(const char* topic, bool retain, Body body) {
+    VwireJsonWriter sizer;
+    body(sizer);
+
+    VWIRE_METRIC_START(publishStart);
+    VwirePublishStream stream(_transportClient());
+    stream.begin(topic, sizer.length(), retain);
+    VwireJsonWriter json(&stream);
+    body(json);
+    bool ok = stream.end();
+    #if VWIRE_ENABLE_METRICS
+    _recordPublish(publishStart, strlen(topic) + sizer.length(), ok);
+    #endif
+    return ok;
+  }
+  #if VWIRE_ENABLE_CBOR
+  bool _cborDirect(uint8_t pin);
+  bool _publishCborValue(const char* topic, const char* value);
+  void _publishCborArray(uint8_t pin, const float* floats, const int* ints, int count);
+  void _setCborActive(bool active);
+  bool _batchAppendCbor(uint8_t pin, const char* value, long ageMs);
+  #endif
+  bool _batchAppend(uint8_t pin, const char* value, long ageMs = -1);
+  bool _batchFlush();
+  #if VWIRE_ENABLE_METRICS
+  void _recordPublish(uint32_t startUs, size_t bytes, bool ok);
+  void _sampleHeap();
+  uint32_t _totalOverruns() const;
+  int _formatMetrics(char* buffer, size_t size);
+  #endif
+  // Topics are the cached prefix plus a tail copied with a known length:
+  // no formatting or heap on the publish paths
+  void _storeDeviceId(const char* id);
+  
+  /** @brief Append length bytes of text at out + used, truncated to size; returns the new length */
+  static size_t _topicAppend(char* out, size_t used, size_t size, const char* text, size_t length) {
+    if (used + length >= size) length = size - used - 1;
+    memcpy(out + used, text, length);
+    out[used + length] = '\0';
+    return used + length;
+  }
+  
+  /** @brief Decimal digits of pin, unterminated; returns their count */
+  static uint8_t _pinDigits(char* out, uint8_t pin) {
+    uint8_t n = 0;
+    if (pin >= 100) out[n++] = (char)('0' + pin / 100);
+    if (pin >= 10) out[n++] = (char)('0' + pin / 10 % 10);
+    out[n++] = (char)('0' + pin % 10);
+    return n;
+  }
+  
+  size_t _topic(char* out, size_t size, const char* suffix, size_t length) const {
+    return _topicAppend(out, _topicAppend(out, 0, size, _topicPrefix, _topicPrefixLength),
+                        size, suffix, length);
+  }
+  
+  /** @brief vwire/<deviceId>/<suffix> for a literal suffix (length fixed at compile time) */
+  template <size_t N>
+  size_t _topic(char* out, size_t size, const char (&suffix)[N]) const {
+    return _topic(out, size, suffix, N - 1);
+  }
+  
+  /** @brief vwire/<deviceId>/<channel><name>, e.g. "pin/" + "D5" */
+  template <size_t N>
+  size_t _topic(char* out, size_t size, const char (&channel)[N], const char* name) const {
+    return _topicAppend(out, _topic(out, size, channel, N - 1), size, name, strlen(name));
+  }
+  
+  /** @brief vwire/<deviceId>/<channel><pin>, e.g. "pin/V" + 12 */
+  template <size_t N>
+  size_t _pinTopic(char* out, size_t size, const char (&channel)[N], uint8_t pin) const {
+    char tail[N + 2];
+    memcpy(tail, channel, N - 1);
+    return _topic(out, size, tail, N - 1 + _pinDigits(tail + N - 1, pin));
+  }
   void _sendHeartbeat();
   void _setError(VwireError error);
   void _debugPrint(const char* message);
   void _debugPrintf(const char* format, ...);
   bool _ensureReliableDeliveryAddon();
   bool _ensureOTAFeature();
+  bool _ensureOfflineQueue();
+  #if VWIRE_ENABLE_SCHEDULER
+  bool _addTask(VwireAddon* addon, VwireTimer* timer, uint8_t addonIndex,
+                uint32_t budgetUs, uint8_t priority);
+  void _sortTask(uint8_t index);
+  void _runTasks(uint32_t runStartUs, unsigned long now, bool addons, bool timers);
+  #endif
+  void _runNetwork();
+  void _runPinHandler(int pin, const char* payload, unsigned int length);
+  void _callPinHandler(uint8_t pin, const char* payload, unsigned int length);
+  #if VWIRE_ENABLE_COALESCING
+  bool _coalesceStore(uint8_t pin, const char* payload, unsigned int length);
+  void _coalesceRun();
+  #endif
+  #if VWIRE_ENABLE_ARENA
+  size_t _arenaDemand(size_t available) const;
+  #endif
+  #if VWIRE_ENABLE_NETWORK_TASK
+  static size_t _netArenaDemand(uint32_t stackSize);
+  static void _networkTaskEntry(void* arg);
+  bool _onAppSide() const;
+  bool _netSend(uint8_t op, uint8_t pin, const char* value);
+  void _netForward(int pin, const char* payload, unsigned int length);
+  void _netDrainOutbound();
+  void _netDrainInbound();
+  bool _netLock(bool wait = true);
+  void _netUnlock();
+  #else
+  bool _netLock(bool wait = true) { (void)wait; return true; }
+  void _netUnlock() {}
+  #endif
 
   friend class VwireReliableDelivery;
   friend class VwireOTAFeature;
   friend class VwireReliableDeliveryAddon;
   friend class VwireOTAAddon;
+  friend class VwireOfflineQueueAddon;
+  friend class VwireBenchmarkAddon;
+  friend class VwireGPIO;
 };
 
 // =============================================================================
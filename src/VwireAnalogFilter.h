@@ -0,0 +1,182 @@
+/*
+ * Vwire IOT Arduino Library - Analog Input Filter
+ *
+ * Oversampling and smoothing for GPIO analog inputs. A filter describes the
+ * pipeline; a sampler holds one pin's state and runs it. Samples are taken
+ * incrementally from VwireGPIO::onRun(), so filtering never blocks run().
+ *
+ * Pipeline, each stage optional:
+ *   oversample  N ADC samples spread over the read interval, averaged
+ *   median      median of the last K readings (rejects single spikes)
+ *   average     moving average of the last W readings
+ *   ema         exponential moving average
+ *
+ * Usage:
+ *   // 16 samples per reading, median of 3, then EMA with weight 0.2
+ *   gpio.setAnalogFilter("A0", VwireAnalogFilter(16, 3, 1, 0.2));
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_ANALOG_FILTER_H
+#define VWIRE_ANALOG_FILTER_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+/** @brief Maximum ADC samples averaged into one reading */
+#ifndef VWIRE_GPIO_MAX_OVERSAMPLE
+  #define VWIRE_GPIO_MAX_OVERSAMPLE 64
+#endif
+
+/** @brief History length for the median and moving average stages */
+#ifndef VWIRE_GPIO_FILTER_WINDOW
+  #define VWIRE_GPIO_FILTER_WINDOW 8
+#endif
+
+// =============================================================================
+// FILTER SETTINGS
+// =============================================================================
+
+/**
+ * @brief Filter pipeline for one analog input
+ *
+ * The default-constructed filter has every stage off and reads the pin once
+ * per interval, as without a filter.
+ */
+struct VwireAnalogFilter {
+  uint8_t oversample;         ///< ADC samples per reading (1 = single read)
+  uint8_t median;             ///< Median of the last K readings (1 = off)
+  uint8_t average;            ///< Moving average of the last W readings (1 = off)
+  float ema;                  ///< Weight of a new reading, 0 < ema < 1 (0 = off)
+
+  VwireAnalogFilter(uint8_t oversample = 1, uint8_t median = 1,
+                    uint8_t average = 1, float ema = 0)
+    : oversample(oversample), median(median), average(average), ema(ema) {}
+
+  /** @brief true when at least one stage is on */
+  bool enabled() const {
+    return oversample > 1 || median > 1 || average > 1 || (ema > 0 && ema < 1);
+  }
+
+  /** @brief Clamp every stage to the supported range */
+  void clamp() {
+    oversample = constrain(oversample, 1, VWIRE_GPIO_MAX_OVERSAMPLE);
+    median = constrain(median, 1, VWIRE_GPIO_FILTER_WINDOW);
+    average = constrain(average, 1, VWIRE_GPIO_FILTER_WINDOW);
+    if (ema <= 0 || ema >= 1) ema = 0;
+  }
+
+  /** @brief Build from wider values (e.g. JSON), clamped before they are narrowed */
+  static VwireAnalogFilter clamped(int oversample, int median, int average, float ema) {
+    VwireAnalogFilter filter((uint8_t)constrain(oversample, 1, VWIRE_GPIO_MAX_OVERSAMPLE),
+                             (uint8_t)constrain(median, 1, VWIRE_GPIO_FILTER_WINDOW),
+                             (uint8_t)constrain(average, 1, VWIRE_GPIO_FILTER_WINDOW), ema);
+    filter.clamp();
+    return filter;
+  }
+};
+
+// =============================================================================
+// SAMPLER
+// =============================================================================
+
+/**
+ * @brief Per-pin filter state
+ *
+ * addSample() accumulates the current reading; finish() averages it and
+ * passes it through the median, moving average and EMA stages.
+ */
+struct VwireAnalogSampler {
+  VwireAnalogFilter filter;
+  uint32_t sum;                                     ///< Oversampling accumulator
+  uint8_t taken;                                    ///< Samples in the current reading
+  bool used;                                        ///< Slot is assigned to a pin
+
+  int16_t medianRing[VWIRE_GPIO_FILTER_WINDOW];
+  uint8_t medianPos;
+  uint8_t medianFill;
+
+  int16_t averageRing[VWIRE_GPIO_FILTER_WINDOW];
+  int32_t averageSum;
+  uint8_t averagePos;
+  uint8_t averageFill;
+
+  float emaValue;
+  bool emaPrimed;
+
+  VwireAnalogSampler() : used(false) { reset(); }
+
+  /** @brief Drop the current reading and all history */
+  void reset() {
+    sum = 0;
+    taken = 0;
+    medianPos = medianFill = 0;
+    averageSum = 0;
+    averagePos = averageFill = 0;
+    emaValue = 0;
+    emaPrimed = false;
+  }
+
+  /** @brief Add one raw ADC sample to the current reading */
+  void addSample(int raw) {
+    sum += (uint32_t)raw;
+    taken++;
+  }
+
+  /**
+   * @brief Close the current reading and run it through the pipeline
+   * @return Filtered value (call only when taken > 0)
+   */
+  int finish() {
+    int value = (int)((sum + taken / 2) / taken);
+    sum = 0;
+    taken = 0;
+
+    if (filter.median > 1) {
+      medianRing[medianPos] = (int16_t)value;
+      medianPos = (medianPos + 1) % filter.median;
+      if (medianFill < filter.median) medianFill++;
+      value = _median();
+    }
+
+    if (filter.average > 1) {
+      if (averageFill == filter.average) {
+        averageSum -= averageRing[averagePos];
+      } else {
+        averageFill++;
+      }
+      averageRing[averagePos] = (int16_t)value;
+      averageSum += value;
+      averagePos = (averagePos + 1) % filter.average;
+      value = (int)((averageSum + averageFill / 2) / averageFill);
+    }
+
+    if (filter.ema > 0) {
+      emaValue = emaPrimed ? emaValue + filter.ema * (value - emaValue) : value;
+      emaPrimed = true;
+      value = (int)(emaValue + 0.5f);
+    }
+
+    return value;
+  }
+
+private:
+  int _median() const {
+    int16_t sorted[VWIRE_GPIO_FILTER_WINDOW];
+    for (uint8_t i = 0; i < medianFill; i++) {
+      int16_t v = medianRing[i];
+      uint8_t j = i;
+      while (j > 0 && sorted[j - 1] > v) {
+        sorted[j] = sorted[j - 1];
+        j--;
+      }
+      sorted[j] = v;
+    }
+    return sorted[medianFill / 2];
+  }
+};
+
+#endif // VWIRE_ANALOG_FILTER_H
@@ -0,0 +1,104 @@
+/*
+ * Vwire IOT Arduino Library - Memory Budget
+ *
+ * setMemoryBudget() splits the budget once: the arena block is sized for
+ * what this build carves from it, the MQTT packet buffer (PubSubClient owns
+ * it) gets the rest. Both happen before begin(), while the heap is still
+ * unfragmented.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+#include "VwireOTA.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_ARENA
+
+bool VwireClass::setMemoryBudget(size_t bytes) {
+  if (_arena.active()) {
+    VWIRE_LOG("[Vwire] Error: memory budget is already set");
+    return false;
+  }
+
+  if (bytes < 256) {
+    VWIRE_LOGF("[Vwire] Error: memory budget of %u bytes is too small", (unsigned)bytes);
+    return false;
+  }
+
+  // A bigger block would only strand RAM: nothing else carves from it
+  size_t blockSize = _arenaDemand(bytes - 256);
+  size_t mqttSize = bytes - blockSize;
+  if (mqttSize > VWIRE_MAX_PAYLOAD_LENGTH) mqttSize = VWIRE_MAX_PAYLOAD_LENGTH;
+
+  // Resize before taking the block so the old buffer's hole is not stranded
+  // underneath it
+  if (!_mqttClient.setBufferSize((uint16_t)mqttSize)) {
+    VWIRE_LOG("[Vwire] Error: could not allocate the MQTT buffer");
+    return false;
+  }
+  _mqttBufferSize = (uint16_t)mqttSize;
+
+  void* block = nullptr;
+  if (blockSize > 0) {
+    block = malloc(blockSize);
+    if (!block) {
+      VWIRE_LOGF("[Vwire] Error: could not allocate a %u byte arena", (unsigned)blockSize);
+      return false;
+    }
+  }
+
+  _arena.begin(block, blockSize);
+  _arena.note("mqtt", mqttSize);
+  VWIRE_LOGF("[Vwire] Memory budget: %u bytes (MQTT %u, arena %u, unused %u)",
+             (unsigned)bytes, (unsigned)mqttSize, (unsigned)blockSize,
+             (unsigned)(bytes - mqttSize - blockSize));
+  return true;
+}
+
+// Subsystems that carve from the arena, each counted only if it fits whole
+// in available; one that does not fit uses the heap, as it would anyway
+size_t VwireClass::_arenaDemand(size_t available) const {
+  size_t demand = 0;
+  #if VWIRE_ENABLE_CLOUD_OTA
+  size_t ota = VwireOTAAddon::arenaDemand();
+  if (ota <= available) demand += ota;
+  #endif
+  #if VWIRE_ENABLE_NETWORK_TASK
+  size_t net = (demand > 0 ? 7 : 0) + _netArenaDemand(VWIRE_NET_TASK_STACK);
+  if (demand + net <= available) demand += net;
+  #endif
+  (void)available;
+  return demand;
+}
+
+void VwireClass::printMemoryReport(Print& out) {
+  if (!_arena.active()) {
+    out.println(F("[Vwire] No memory budget set"));
+    return;
+  }
+  _arena.printReport(out);
+}
+
+#else
+
+bool VwireClass::setMemoryBudget(size_t bytes) {
+  (void)bytes;
+  _debugPrint("[Vwire] Memory arena is not available in this build");
+  return false;
+}
+
+void VwireClass::printMemoryReport(Print& out) {
+  out.println(F("[Vwire] Memory arena is not available in this build"));
+}
+
+#endif // VWIRE_ENABLE_ARENA
@@ -0,0 +1,137 @@
+/*
+ * Vwire IOT Arduino Library - Memory Arena
+ *
+ * One block, taken from the heap once by Vwire.setMemoryBudget(), that the
+ * library's long-lived buffers are carved from. Allocation only moves a
+ * pointer forward and nothing is ever freed, so after start-up the block
+ * cannot fragment and the library's RAM use is fixed. Every carve is
+ * recorded under its owner for printMemoryReport().
+ *
+ * Buffers owned by other libraries (the PubSubClient packet buffer) cannot
+ * live in the block; they are sized from the budget and recorded as
+ * external regions so the report still adds up.
+ *
+ * Strip from the build with VWIRE_DISABLE_ARENA.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_ARENA_H
+#define VWIRE_ARENA_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+/** @brief Distinct owners listed in the memory report */
+#ifndef VWIRE_ARENA_MAX_REGIONS
+  #define VWIRE_ARENA_MAX_REGIONS 8
+#endif
+
+/**
+ * @brief Bump allocator over a fixed block
+ *
+ * Carves are 8-byte aligned. allocate() returns nullptr when the arena is
+ * not set up or the block is exhausted; callers fall back to the heap and
+ * the shortfall is reported.
+ */
+class VwireArena {
+public:
+  VwireArena() : _base(nullptr), _size(0), _used(0), _shortfall(0), _count(0), _active(false) {}
+
+  /** @brief Use block (size bytes, may be empty) for all further carves */
+  void begin(void* block, size_t size) {
+    _base = (uint8_t*)block;
+    _size = block ? size : 0;
+    _used = 0;
+    _active = true;
+  }
+
+  /** @brief Whether a budget was set (the block itself may be empty) */
+  bool active() const { return _active; }
+
+  /** @brief Carve size bytes for owner (a string literal) */
+  void* allocate(size_t size, const char* owner) {
+    if (!_active) return nullptr;
+    size_t offset = _align(_used);
+    if (offset + size > _size) {
+      _shortfall += size;
+      return nullptr;
+    }
+    _used = offset + size;
+    _record(owner, size, false);
+    return _base + offset;
+  }
+
+  /** @brief Whether sizes (pieces separate carves) fit in what is left */
+  bool fits(size_t size, uint8_t pieces) const {
+    return _base && _align(_used) + size + (size_t)(pieces - 1) * 7 <= _size;
+  }
+
+  /** @brief Record memory budgeted outside the block */
+  void note(const char* owner, size_t size) { _record(owner, size, true); }
+
+  /** @brief Whether block points into the arena */
+  bool owns(const void* block) const {
+    return _base && block >= _base && (const uint8_t*)block < _base + _size;
+  }
+
+  size_t capacity() const { return _size; }
+  size_t used() const { return _used; }
+  size_t remaining() const { return _size - _used; }
+
+  void printReport(Print& out) const {
+    out.println(F("\n=== Vwire IOT Memory ==="));
+    size_t external = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      out.print(_regions[i].owner);
+      for (size_t pad = strlen(_regions[i].owner); pad < 10; pad++) out.print(' ');
+      out.print(_regions[i].bytes);
+      out.println(_regions[i].external ? F(" bytes (client heap)") : F(" bytes"));
+      if (_regions[i].external) external += _regions[i].bytes;
+    }
+    out.print(F("Arena: ")); out.print(_used);
+    out.print(F(" / ")); out.print(_size); out.println(F(" bytes used"));
+    out.print(F("Budget: ")); out.print(_size + external); out.println(F(" bytes"));
+    if (_shortfall > 0) {
+      out.print(F("Shortfall: ")); out.print(_shortfall);
+      out.println(F(" bytes taken from the heap instead"));
+    }
+    out.println(F("========================\n"));
+  }
+
+private:
+  struct Region {
+    const char* owner;
+    uint32_t bytes;
+    bool external;
+  };
+
+  uint8_t* _base;
+  size_t _size;
+  size_t _used;
+  size_t _shortfall;
+  Region _regions[VWIRE_ARENA_MAX_REGIONS];
+  uint8_t _count;
+  bool _active;
+
+  static size_t _align(size_t offset) { return (offset + 7) & ~(size_t)7; }
+
+  void _record(const char* owner, size_t size, bool external) {
+    for (uint8_t i = 0; i < _count; i++) {
+      if (_regions[i].external == external && strcmp(_regions[i].owner, owner) == 0) {
+        _regions[i].bytes += size;
+        return;
+      }
+    }
+    if (_count < VWIRE_ARENA_MAX_REGIONS) {
+      _regions[_count].owner = owner;
+      _regions[_count].bytes = (uint32_t)size;
+      _regions[_count].external = external;
+      _count++;
+    }
+  }
+};
+
+#endif // VWIRE_ARENA_H
@@ -0,0 +1,217 @@
+/*
+ * Vwire IOT Arduino Library - Batched Publishing
+ * 
+ * Collects virtual pin writes into a fixed buffer and publishes them as a
+ * single MQTT message on vwire/{deviceId}/batch, instead of one publish (and
+ * one TLS record) per pin.
+ * 
+ * Batch payload format (JSON array of [pin, value] pairs, in write order):
+ *   [[0,"23.50"],[1,"61"],[7,"Door open"]]
+ * 
+ * Writes replayed from the offline queue carry a third element, the age of
+ * the write in milliseconds at the time it is sent:
+ *   [[0,"23.10",61250],[0,"23.20",1250]]
+ * 
+ * With CBOR encoding active the same entries are CBOR arrays inside an
+ * indefinite-length array, values encoded by VwireCborWriter::writeValue().
+ * 
+ * Batching can be stripped from the build globally with VWIRE_DISABLE_BATCH.
+ * 
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_BATCH
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+void VwireClass::beginBatch() {
+  #if VWIRE_ENABLE_NETWORK_TASK
+  // Queued in order with the writes, so the task batches the same ones
+  if (_netTask && _onAppSide()) {
+    _netSend(VWIRE_NET_OP_BATCH_BEGIN, 0, "");
+    return;
+  }
+  #endif
+  _batchActive = true;
+}
+
+bool VwireClass::commitBatch() {
+  #if VWIRE_ENABLE_NETWORK_TASK
+  if (_netTask && _onAppSide()) {
+    return _netSend(VWIRE_NET_OP_BATCH_COMMIT, 0, "");
+  }
+  #endif
+  _batchActive = false;
+  return _batchFlush();
+}
+
+void VwireClass::setBatchWindow(unsigned long window) {
+  NetGuard guard(this, true);
+  _batchWindow = window;
+  if (window == 0 && !_batchActive) {
+    _batchFlush();
+  }
+}
+
+bool VwireClass::isBatching() const {
+  return _batchActive || _batchWindow > 0;
+}
+
+uint8_t VwireClass::getBatchCount() const {
+  return _batchCount;
+}
+
+// =============================================================================
+// INTERNAL HELPERS
+// =============================================================================
+
+bool VwireClass::_batchAppend(uint8_t pin, const char* value, long ageMs) {
+  #if VWIRE_ENABLE_CBOR
+  if (_cborActive) {
+    return _batchAppendCbor(pin, value, ageMs);
+  }
+  #endif
+
+  uint8_t pinDigits = pin >= 100 ? 3 : (pin >= 10 ? 2 : 1);
+
+  // Optional ",age" suffix for replayed writes
+  char age[12];
+  int ageLen = 0;
+  if (ageMs >= 0) {
+    ageLen = snprintf(age, sizeof(age), ",%ld", ageMs);
+  }
+
+  // [pin,"value"]  -> brackets + comma + quotes = 5 bytes around the data
+  size_t entryLen = 5 + pinDigits + VwireJsonWriter::escapedLength(value) + ageLen;
+
+  // Frame overhead: leading '[' for the first entry, ',' separator otherwise,
+  // and one byte kept free for the closing ']'.
+  if (_batchCount > 0 &&
+      (_batchLength + 1 + entryLen + 1 > sizeof(_batchBuffer) || _batchCount == 255)) {
+    _batchFlush();
+  }
+  if (_batchCount == 0 && 1 + entryLen + 1 > sizeof(_batchBuffer)) {
+    return false;  // Never fits - caller publishes this write on its own topic
+  }
+
+  char* out = _batchBuffer + _batchLength;
+  *out++ = (_batchCount == 0) ? '[' : ',';
+  *out++ = '[';
+  if (pin >= 100) *out++ = '0' + pin / 100;
+  if (pin >= 10)  *out++ = '0' + (pin / 10) % 10;
+  *out++ = '0' + pin % 10;
+  *out++ = ',';
+  *out++ = '"';
+  out = VwireJsonWriter::escapeInto(out, value);
+  *out++ = '"';
+  memcpy(out, age, ageLen);
+  out += ageLen;
+  *out++ = ']';
+
+  if (_batchCount == 0) {
+    _batchStartedAt = millis();
+  }
+  _batchLength = (uint16_t)(out - _batchBuffer);
+  _batchCount++;
+  return true;
+}
+
+#if VWIRE_ENABLE_CBOR
+static void _vwireCborEntry(VwireCborWriter& out, uint8_t pin, const char* value, long ageMs) {
+  out.writeArray(ageMs >= 0 ? 3 : 2);
+  out.writeUInt(pin);
+  out.writeValue(value);
+  if (ageMs >= 0) out.writeUInt((uint32_t)ageMs);
+}
+
+bool VwireClass::_batchAppendCbor(uint8_t pin, const char* value, long ageMs) {
+  VwireCborWriter sizer;
+  _vwireCborEntry(sizer, pin, value, ageMs);
+  size_t entryLen = sizer.length();
+
+  // Same framing as the JSON form: 0x9F opens, one byte stays free for 0xFF
+  if (_batchCount > 0 &&
+      (_batchLength + entryLen + 1 > sizeof(_batchBuffer) || _batchCount == 255)) {
+    _batchFlush();
+  }
+  if (_batchCount == 0 && 1 + entryLen + 1 > sizeof(_batchBuffer)) {
+    return false;
+  }
+
+  VwireCborWriter out((uint8_t*)_batchBuffer + _batchLength, sizeof(_batchBuffer) - _batchLength);
+  if (_batchCount == 0) {
+    out.beginArray();
+    _batchStartedAt = millis();
+  }
+  _vwireCborEntry(out, pin, value, ageMs);
+
+  _batchLength += (uint16_t)out.length();
+  _batchCount++;
+  return true;
+}
+#endif
+
+bool VwireClass::_batchFlush() {
+  if (_batchCount == 0) return true;
+
+  bool ok = false;
+  if (connected()) {
+    char topic[96];
+    _topic(topic, sizeof(topic), "batch");
+
+    #if VWIRE_ENABLE_CBOR
+    _batchBuffer[_batchLength++] = _cborActive ? (char)0xFF : ']';
+    #else
+    _batchBuffer[_batchLength++] = ']';
+    #endif
+
+    VWIRE_METRIC_START(publishStart);
+    ok = _streamPublish(topic, _batchBuffer, _batchLength, _settings.dataRetain);
+    #if VWIRE_ENABLE_METRICS
+    _recordPublish(publishStart, strlen(topic) + _batchLength, ok);
+    #endif
+    VWIRE_LOGF("[Vwire] Batch sent: %d writes, %d bytes", _batchCount, _batchLength);
+  } else {
+    _setError(VWIRE_ERR_NOT_CONNECTED);
+    VWIRE_LOGF("[Vwire] Batch dropped (not connected): %d writes", _batchCount);
+    VWIRE_METRIC_COUNT(_metrics.messagesDropped, _batchCount);
+  }
+
+  _batchLength = 0;
+  _batchCount = 0;
+  if (!ok) _batchLost = true;          // Also covers flushes made by _batchAppend()
+  return ok;
+}
+
+#else
+
+void VwireClass::beginBatch() {}
+bool VwireClass::commitBatch() { return true; }
+void VwireClass::setBatchWindow(unsigned long window) { (void)window; }
+bool VwireClass::isBatching() const { return false; }
+uint8_t VwireClass::getBatchCount() const { return 0; }
+
+bool VwireClass::_batchAppend(uint8_t pin, const char* value, long ageMs) {
+  (void)pin;
+  (void)value;
+  (void)ageMs;
+  return false;
+}
+
+bool VwireClass::_batchFlush() { return true; }
+
+#endif
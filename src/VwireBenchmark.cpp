@@ -0,0 +1,342 @@
+/*
+ * Vwire IOT Arduino Library - On-Device Benchmark Implementation
+ *
+ * The benchmark is an addon registered on the first startBenchmark().
+ * onRun() samples the run() interval and the heap, publishes the next
+ * burst or probe, and sends the report when the probe phase is over.
+ * Probes go to vwire/<deviceId>/cmd/V<pin> and come back through the
+ * normal subscription; onMessage() claims them before pin handlers see
+ * them.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _vwire->_debugPrint(message)
+  #define VWIRE_LOGF(...) _vwire->_debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_BENCHMARK
+
+// =============================================================================
+// BENCHMARK ADDON
+// =============================================================================
+
+class VwireBenchmarkAddon : public VwireAddon {
+public:
+  VwireBenchmarkAddon()
+    : _vwire(nullptr), _phase(PHASE_IDLE), _pin(0), _publishMs(0), _startedAt(0),
+      _phaseAt(0), _lastRunUs(0), _probeAt(0), _probeUs(0), _waiting(false),
+      _rttTotalUs(0), _intervals(0), _sampled(0) {}
+
+  bool start(VwireClass& vwire, unsigned long publishMs, uint8_t pin);
+  bool running() const { return _phase != PHASE_IDLE; }
+  const VwireBenchmarkResult& result() const { return _result; }
+
+  void onAttach(VwireClass& vwire) override { _vwire = &vwire; }
+  void onDisconnect() override;
+  using VwireAddon::onMessage;
+  bool onMessage(const VwireMessage& message) override;
+  void onRun() override;
+
+private:
+  enum Phase : uint8_t { PHASE_IDLE, PHASE_PUBLISH, PHASE_PROBE };
+
+  VwireClass* _vwire;
+  Phase _phase;
+  uint8_t _pin;
+  unsigned long _publishMs;
+  unsigned long _startedAt;
+  unsigned long _phaseAt;
+  uint32_t _lastRunUs;
+  unsigned long _probeAt;                   // millis() of the outstanding probe
+  uint32_t _probeUs;                        // micros() of the outstanding probe
+  bool _waiting;
+  uint64_t _rttTotalUs;
+  uint32_t _intervals;                      // run() intervals seen
+  uint8_t _sampled;                         // Entries used in _samples
+  uint32_t _samples[VWIRE_BENCH_SAMPLES];   // Uniform sample of the intervals
+  uint32_t _rtts[VWIRE_BENCH_PROBES];
+  VwireBenchmarkResult _result;
+
+  void _sampleInterval(uint32_t us);
+  void _sampleHeap();
+  void _publishBurst();
+  void _sendProbe();
+  void _finish();
+  void _report();
+  static uint32_t _percentile(uint32_t* values, uint8_t count, uint8_t percent);
+};
+
+static VwireBenchmarkAddon _vwireDefaultBenchmarkAddon;
+
+bool VwireBenchmarkAddon::start(VwireClass& vwire, unsigned long publishMs, uint8_t pin) {
+  if (running()) return false;
+  if (!_vwire) {
+    vwire.addAddon(*this);
+    if (!_vwire) return false;                // No addon slot left
+  }
+
+  _result = VwireBenchmarkResult();
+  _result.tls = vwire._settings.transport == VWIRE_TRANSPORT_TCP_SSL;
+  _result.heapStart = _result.heapMin = vwire.getFreeHeap();
+  _pin = pin;
+  _publishMs = publishMs;
+  _startedAt = _phaseAt = millis();
+  _lastRunUs = 0;
+  _waiting = false;
+  _rttTotalUs = 0;
+  _intervals = 0;
+  _sampled = 0;
+  _phase = PHASE_PUBLISH;
+  VWIRE_LOGF("[Vwire] Benchmark: publishing on V%d for %lu ms", pin, publishMs);
+  return true;
+}
+
+// =============================================================================
+// ADDON LIFECYCLE
+// =============================================================================
+
+void VwireBenchmarkAddon::onDisconnect() {
+  if (!running()) return;
+  VWIRE_LOG("[Vwire] Benchmark aborted: connection lost");
+  _finish();
+}
+
+bool VwireBenchmarkAddon::onMessage(const VwireMessage& message) {
+  if (_phase != PHASE_PROBE || message.type != VWIRE_MSG_CMD || message.pinType != 'V' ||
+      message.pin != _pin) {
+    return false;
+  }
+
+  // Our probe, or one sent by the server for us: echo it like a handler
+  // that acknowledges a dashboard command would
+  _vwire->virtualSend(_pin, message.payload);
+  if (_waiting) {
+    uint32_t rtt = micros() - _probeUs;
+    _rtts[_result.probesReceived++] = rtt;
+    _rttTotalUs += rtt;
+    if (rtt > _result.rttMaxUs) _result.rttMaxUs = rtt;
+    _waiting = false;
+  }
+  return true;
+}
+
+void VwireBenchmarkAddon::onRun() {
+  if (!running()) return;
+
+  uint32_t nowUs = micros();
+  if (_lastRunUs != 0) _sampleInterval(nowUs - _lastRunUs);
+  _lastRunUs = nowUs;
+  _result.runs++;
+  _sampleHeap();
+
+  unsigned long now = millis();
+  if (_phase == PHASE_PUBLISH) {
+    if (now - _phaseAt < _publishMs) {
+      _publishBurst();
+      return;
+    }
+    _result.valuesPerSec = (uint32_t)((uint64_t)_result.valuesSent * 1000 / (now - _phaseAt));
+    _result.bytesPerSec = (uint32_t)((uint64_t)_result.bytesSent * 1000 / (now - _phaseAt));
+    VWIRE_LOGF("[Vwire] Benchmark: %lu values/s, sending %d probes",
+               (unsigned long)_result.valuesPerSec, VWIRE_BENCH_PROBES);
+    _phase = PHASE_PROBE;
+    _phaseAt = now;
+  }
+
+  // PHASE_PROBE: one probe in flight at a time
+  if (_waiting) {
+    if (now - _probeAt < VWIRE_BENCH_PROBE_TIMEOUT) return;
+    _waiting = false;                       // Lost
+  }
+  if (_result.probesSent < VWIRE_BENCH_PROBES) {
+    _sendProbe();
+    return;
+  }
+  _report();
+}
+
+// =============================================================================
+// PHASES
+// =============================================================================
+
+void VwireBenchmarkAddon::_publishBurst() {
+  char value[12];
+  char topic[96];
+  size_t topicLength = _vwire->_pinTopic(topic, sizeof(topic), "pin/V", _pin);
+  for (uint8_t i = 0; i < VWIRE_BENCH_BURST; i++) {
+    snprintf(value, sizeof(value), "%lu", (unsigned long)_result.valuesSent);
+    _vwire->virtualSend(_pin, value);
+    _result.valuesSent++;
+    _result.bytesSent += topicLength + strlen(value);
+  }
+}
+
+void VwireBenchmarkAddon::_sendProbe() {
+  char topic[96];
+  char value[12];
+  _vwire->_pinTopic(topic, sizeof(topic), "cmd/V", _pin);
+  snprintf(value, sizeof(value), "%u", (unsigned)_result.probesSent);
+  _probeAt = millis();
+  _probeUs = micros();
+  _waiting = _vwire->publish(topic, value);
+  _result.probesSent++;
+}
+
+void VwireBenchmarkAddon::_finish() {
+  _result.durationMs = millis() - _startedAt;
+  _result.heapEnd = _vwire->getFreeHeap();
+
+  uint8_t received = _result.probesReceived;
+  if (received > 0) {
+    _result.rttAvgUs = (uint32_t)(_rttTotalUs / received);
+    _result.rttP50Us = _percentile(_rtts, received, 50);
+    _result.rttP90Us = _percentile(_rtts, received, 90);
+  }
+  _result.loopP50Us = _percentile(_samples, _sampled, 50);
+  _result.loopP90Us = _percentile(_samples, _sampled, 90);
+  _result.loopP99Us = _percentile(_samples, _sampled, 99);
+  _phase = PHASE_IDLE;
+}
+
+void VwireBenchmarkAddon::_report() {
+  _finish();
+
+  char topic[96];
+  _vwire->_topic(topic, sizeof(topic), "bench");
+  const VwireBenchmarkResult& r = _result;
+  _result.complete = _vwire->_publishJson(topic, false, [&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("board", VWIRE_BOARD_NAME);
+    json.field("version", VWIRE_VERSION);
+    json.field("transport", r.tls ? "tls" : "tcp");
+    json.field("durationMs", (unsigned long)r.durationMs);
+    json.key("publish");
+    json.beginObject();
+    json.field("values", (unsigned long)r.valuesSent);
+    json.field("bytes", (unsigned long)r.bytesSent);
+    json.field("valuesPerSec", (unsigned long)r.valuesPerSec);
+    json.field("bytesPerSec", (unsigned long)r.bytesPerSec);
+    json.endObject();
+    json.key("roundTrip");
+    json.beginObject();
+    json.field("sent", (int)r.probesSent);
+    json.field("received", (int)r.probesReceived);
+    json.field("avgUs", (unsigned long)r.rttAvgUs);
+    json.field("p50Us", (unsigned long)r.rttP50Us);
+    json.field("p90Us", (unsigned long)r.rttP90Us);
+    json.field("maxUs", (unsigned long)r.rttMaxUs);
+    json.endObject();
+    json.key("loop");
+    json.beginObject();
+    json.field("runs", (unsigned long)r.runs);
+    json.field("p50Us", (unsigned long)r.loopP50Us);
+    json.field("p90Us", (unsigned long)r.loopP90Us);
+    json.field("p99Us", (unsigned long)r.loopP99Us);
+    json.field("maxUs", (unsigned long)r.loopMaxUs);
+    json.endObject();
+    json.key("heap");
+    json.beginObject();
+    json.field("start", (unsigned long)r.heapStart);
+    json.field("min", (unsigned long)r.heapMin);
+    json.field("end", (unsigned long)r.heapEnd);
+    json.endObject();
+    json.endObject();
+  });
+
+  VWIRE_LOGF("[Vwire] Benchmark done: %lu values/s, round trip p50 %lu us (%d/%d), "
+             "run() p99 %lu us, min heap %lu",
+             (unsigned long)r.valuesPerSec, (unsigned long)r.rttP50Us, r.probesReceived,
+             r.probesSent, (unsigned long)r.loopP99Us, (unsigned long)r.heapMin);
+}
+
+// =============================================================================
+// SAMPLING
+// =============================================================================
+
+void VwireBenchmarkAddon::_sampleInterval(uint32_t us) {
+  if (us > _result.loopMaxUs) _result.loopMaxUs = us;
+
+  // Reservoir sampling: every interval has the same chance of being kept
+  _intervals++;
+  if (_sampled < VWIRE_BENCH_SAMPLES) {
+    _samples[_sampled++] = us;
+    return;
+  }
+  uint32_t slot = (uint32_t)random((long)_intervals);
+  if (slot < VWIRE_BENCH_SAMPLES) _samples[slot] = us;
+}
+
+void VwireBenchmarkAddon::_sampleHeap() {
+  uint32_t freeHeap = _vwire->getFreeHeap();
+  if (freeHeap > 0 && freeHeap < _result.heapMin) _result.heapMin = freeHeap;
+}
+
+uint32_t VwireBenchmarkAddon::_percentile(uint32_t* values, uint8_t count, uint8_t percent) {
+  if (count == 0) return 0;
+
+  // Insertion sort: at most VWIRE_BENCH_SAMPLES entries, once per run
+  for (uint8_t i = 1; i < count; i++) {
+    uint32_t value = values[i];
+    uint8_t k = i;
+    while (k > 0 && values[k - 1] > value) {
+      values[k] = values[k - 1];
+      k--;
+    }
+    values[k] = value;
+  }
+  uint8_t index = (uint8_t)(((uint16_t)count * percent + 99) / 100);
+  return values[index > 0 ? index - 1 : 0];
+}
+
+// =============================================================================
+// VwireClass BRIDGE METHODS
+// =============================================================================
+
+bool VwireClass::startBenchmark(unsigned long publishMs, uint8_t pin) {
+  if (pin >= VWIRE_MAX_VIRTUAL_PINS) {
+    _setError(VWIRE_ERR_INVALID_PIN);
+    return false;
+  }
+  if (!connected()) {
+    _setError(VWIRE_ERR_NOT_CONNECTED);
+    return false;
+  }
+  return _vwireDefaultBenchmarkAddon.start(*this, publishMs, pin);
+}
+
+bool VwireClass::isBenchmarkRunning() const {
+  return _vwireDefaultBenchmarkAddon.running();
+}
+
+const VwireBenchmarkResult& VwireClass::getBenchmarkResult() const {
+  return _vwireDefaultBenchmarkAddon.result();
+}
+
+#else
+
+bool VwireClass::startBenchmark(unsigned long publishMs, uint8_t pin) {
+  (void)publishMs;
+  (void)pin;
+  _debugPrint("[Vwire] Benchmark is not available in this build");
+  return false;
+}
+
+bool VwireClass::isBenchmarkRunning() const {
+  return false;
+}
+
+const VwireBenchmarkResult& VwireClass::getBenchmarkResult() const {
+  static const VwireBenchmarkResult empty;
+  return empty;
+}
+
+#endif // VWIRE_ENABLE_BENCHMARK
@@ -0,0 +1,73 @@
+/*
+ * Vwire IOT Arduino Library - On-Device Benchmark
+ *
+ * Measures the library on real hardware and a real broker, in three
+ * phases driven by run():
+ *   1. publish  - VWIRE_BENCH_BURST values per run() on the benchmark pin
+ *                 for publishMs: values and bytes per second
+ *   2. probe    - VWIRE_BENCH_PROBES commands sent to the device's own
+ *                 cmd topic, one at a time; each is echoed on the pin when
+ *                 it comes back: command round-trip latency
+ *   3. report   - one JSON message on vwire/<deviceId>/bench
+ * The interval between run() calls and the free heap are sampled
+ * throughout. Run it once per transport (TCP, TLS) and board to compare.
+ *
+ * Usage:
+ *   Vwire.startBenchmark();                  // 5 s publish phase on V127
+ *   ...
+ *   if (!Vwire.isBenchmarkRunning()) {
+ *     const VwireBenchmarkResult& r = Vwire.getBenchmarkResult();
+ *     Serial.println(r.valuesPerSec);
+ *   }
+ *
+ * Strip from the build with VWIRE_DISABLE_BENCHMARK.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_BENCHMARK_H
+#define VWIRE_BENCHMARK_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+/**
+ * @brief Figures from the last benchmark run
+ *
+ * Latencies are in microseconds. Percentiles of run() intervals come from
+ * a uniform sample of VWIRE_BENCH_SAMPLES intervals; round-trip ones are
+ * exact. Heap figures are 0 on boards that cannot report free memory.
+ */
+struct VwireBenchmarkResult {
+  bool complete;              ///< All phases ran and the report was published
+  bool tls;                   ///< Measured over TLS (false: plain TCP)
+  unsigned long durationMs;   ///< Whole run, start to report
+
+  uint32_t valuesSent;        ///< virtualSend() calls in the publish phase
+  uint32_t bytesSent;         ///< Topic + payload bytes of those values
+  uint32_t valuesPerSec;
+  uint32_t bytesPerSec;
+
+  uint8_t probesSent;         ///< Round-trip probes published
+  uint8_t probesReceived;     ///< Probes that came back before the timeout
+  uint32_t rttAvgUs;
+  uint32_t rttP50Us;
+  uint32_t rttP90Us;
+  uint32_t rttMaxUs;
+
+  uint32_t runs;              ///< run() calls seen while running
+  uint32_t loopP50Us;         ///< Interval between run() calls
+  uint32_t loopP90Us;
+  uint32_t loopP99Us;
+  uint32_t loopMaxUs;
+
+  uint32_t heapStart;         ///< Free heap when started (bytes)
+  uint32_t heapMin;           ///< Lowest free heap seen while running
+  uint32_t heapEnd;           ///< Free heap when the report was sent
+
+  VwireBenchmarkResult() { memset(this, 0, sizeof(*this)); }
+};
+
+#endif // VWIRE_BENCHMARK_H
@@ -0,0 +1,232 @@
+/*
+ * Vwire IOT Arduino Library - CBOR Encoder
+ *
+ * Minimal CBOR (RFC 8949) writer for binary pin values, arrays and batches.
+ * A writer either counts bytes (no sink), fills a memory buffer, or streams
+ * to a Print through a small staging buffer. Publishing runs it twice: once
+ * to learn the length for beginPublish(), once into the MQTT client.
+ *
+ * Encodings used by Vwire:
+ *   scalar pin value   integer, float32/float64 or text string
+ *   float array        array of float32 (raw values, no rounding)
+ *   int array          array of integers
+ *   batch              indefinite array of [pin, value] / [pin, value, ageMs]
+ *
+ * Strip from the build with VWIRE_DISABLE_CBOR.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_CBOR_H
+#define VWIRE_CBOR_H
+
+#include <Arduino.h>
+#include <errno.h>
+#include "VwireConfig.h"
+
+/** @brief Bytes collected before each write to a Print sink */
+#ifndef VWIRE_CBOR_STAGE_SIZE
+  #define VWIRE_CBOR_STAGE_SIZE 32
+#endif
+
+/**
+ * @brief Streaming CBOR writer
+ *
+ * length() counts every byte written, including bytes that did not fit a
+ * memory buffer; overflow() reports that case.
+ */
+class VwireCborWriter {
+public:
+  /** @brief Count bytes only, or stream to out */
+  explicit VwireCborWriter(Print* out = nullptr)
+    : _out(out), _buffer(nullptr), _size(0), _length(0), _staged(0), _overflow(false) {}
+
+  /** @brief Write into a memory buffer */
+  VwireCborWriter(uint8_t* buffer, size_t size)
+    : _out(nullptr), _buffer(buffer), _size(size), _length(0), _staged(0), _overflow(false) {}
+
+  ~VwireCborWriter() { flush(); }
+
+  /** @brief Definite-length array header */
+  void writeArray(uint32_t count) { _head(4, count); }
+
+  /** @brief Indefinite-length array start (close with writeBreak()) */
+  void beginArray() { _byte(0x9F); }
+
+  /** @brief Close an indefinite-length item */
+  void writeBreak() { _byte(0xFF); }
+
+  void writeUInt(uint32_t value) { _head(0, value); }
+
+  void writeInt(int32_t value) {
+    if (value >= 0) {
+      _head(0, (uint32_t)value);
+    } else {
+      _head(1, (uint32_t)(-1 - value));
+    }
+  }
+
+  void writeFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _byte(0xFA);
+    _be(bits, 4);
+  }
+
+  void writeDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _byte(0xFB);
+    _be((uint32_t)(bits >> 32), 4);
+    _be((uint32_t)bits, 4);
+  }
+
+  void writeText(const char* text, size_t length) {
+    _head(3, (uint32_t)length);
+    _put((const uint8_t*)text, length);
+  }
+
+  /**
+   * @brief Encode a pin value given as text in its narrowest form
+   *
+   * Only canonical decimal text counts as a number: optional '-', no leading
+   * zeros, digits, optional fraction and exponent ("00501", "+5", "0x1F",
+   * "nan" and "inf" stay text). Whole numbers in int32 range become
+   * integers; other numbers become float32 when the text has at most 7
+   * significant digits (so nothing the text carried is lost), float64
+   * otherwise.
+   */
+  void writeValue(const char* text) {
+    size_t length = strlen(text);
+    uint8_t syntax = length < 24 ? _numberSyntax(text) : VWIRE_CBOR_NOT_NUMBER;
+    // "-0" goes the float route so it keeps its sign
+    if (syntax == VWIRE_CBOR_WHOLE && strcmp(text, "-0") != 0) {
+      // A 32-bit long saturates out-of-range text; leave that to strtod()
+      errno = 0;
+      long whole = strtol(text, nullptr, 10);
+      if (errno != ERANGE && whole >= -2147483647L - 1 && whole <= 2147483647L) {
+        writeInt((int32_t)whole);
+        return;
+      }
+    }
+    if (syntax != VWIRE_CBOR_NOT_NUMBER) {
+      double number = strtod(text, nullptr);
+      if (_significantDigits(text) <= 7) {
+        writeFloat((float)number);
+      } else {
+        writeDouble(number);
+      }
+      return;
+    }
+    writeText(text, length);
+  }
+
+  /** @brief Send staged bytes to the Print sink */
+  void flush() {
+    if (_out && _staged > 0) {
+      _out->write(_stage, _staged);
+    }
+    _staged = 0;
+  }
+
+  /** @brief Bytes written so far */
+  size_t length() const { return _length; }
+
+  /** @brief A memory buffer was too small */
+  bool overflow() const { return _overflow; }
+
+private:
+  Print* _out;
+  uint8_t* _buffer;
+  size_t _size;
+  size_t _length;
+  uint8_t _stage[VWIRE_CBOR_STAGE_SIZE];
+  uint8_t _staged;
+  bool _overflow;
+
+  void _head(uint8_t major, uint32_t value) {
+    uint8_t type = (uint8_t)(major << 5);
+    if (value < 24) {
+      _byte(type | (uint8_t)value);
+    } else if (value <= 0xFF) {
+      _byte(type | 24);
+      _byte((uint8_t)value);
+    } else if (value <= 0xFFFF) {
+      _byte(type | 25);
+      _be(value, 2);
+    } else {
+      _byte(type | 26);
+      _be(value, 4);
+    }
+  }
+
+  void _be(uint32_t value, uint8_t bytes) {
+    while (bytes-- > 0) {
+      _byte((uint8_t)(value >> (8 * bytes)));
+    }
+  }
+
+  void _byte(uint8_t value) { _put(&value, 1); }
+
+  void _put(const uint8_t* data, size_t length) {
+    if (_buffer) {
+      if (_length + length <= _size) {
+        memcpy(_buffer + _length, data, length);
+      } else {
+        _overflow = true;
+      }
+    } else if (_out) {
+      for (size_t i = 0; i < length; i++) {
+        if (_staged == sizeof(_stage)) flush();
+        _stage[_staged++] = data[i];
+      }
+    }
+    _length += length;
+  }
+
+  enum { VWIRE_CBOR_NOT_NUMBER, VWIRE_CBOR_WHOLE, VWIRE_CBOR_REAL };
+
+  /** @brief Classify text against the JSON number grammar */
+  static uint8_t _numberSyntax(const char* text) {
+    const char* c = text;
+    if (*c == '-') c++;
+    if (*c == '0') {
+      c++;
+    } else if (*c >= '1' && *c <= '9') {
+      while (isdigit((unsigned char)*c)) c++;
+    } else {
+      return VWIRE_CBOR_NOT_NUMBER;
+    }
+    uint8_t syntax = VWIRE_CBOR_WHOLE;
+    if (*c == '.') {
+      c++;
+      if (!isdigit((unsigned char)*c)) return VWIRE_CBOR_NOT_NUMBER;
+      while (isdigit((unsigned char)*c)) c++;
+      syntax = VWIRE_CBOR_REAL;
+    }
+    if (*c == 'e' || *c == 'E') {
+      c++;
+      if (*c == '+' || *c == '-') c++;
+      if (!isdigit((unsigned char)*c)) return VWIRE_CBOR_NOT_NUMBER;
+      while (isdigit((unsigned char)*c)) c++;
+      syntax = VWIRE_CBOR_REAL;
+    }
+    return *c == '\0' ? syntax : VWIRE_CBOR_NOT_NUMBER;
+  }
+
+  static uint8_t _significantDigits(const char* text) {
+    uint8_t digits = 0;
+    bool leading = true;
+    for (const char* c = text; *c && *c != 'e' && *c != 'E'; c++) {
+      if (!isdigit((unsigned char)*c)) continue;
+      if (leading && *c == '0') continue;
+      leading = false;
+      digits++;
+    }
+    return digits;
+  }
+};
+
+#endif // VWIRE_CBOR_H
@@ -0,0 +1,138 @@
+/*
+ * Vwire IOT Arduino Library - Command Coalescing (virtual pins)
+ *
+ * Latest-wins pins get one slot holding the newest inbound command.
+ * _runPinHandler() overwrites the slot instead of calling the handler,
+ * counting the value it replaces; run() then calls each pending pin's
+ * handler once, after the MQTT client (or the network task queue) has
+ * been read.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_COALESCING
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+bool VwireClass::setCommandCoalescing(uint8_t pin, bool enable) {
+  if (pin >= VWIRE_MAX_VIRTUAL_PINS) {
+    _setError(VWIRE_ERR_INVALID_PIN);
+    return false;
+  }
+
+  uint8_t slot = _coalesceIndex[pin];
+  if (!enable) {
+    if (slot == 0xFF) return true;
+    _coalesceIndex[pin] = 0xFF;
+    if (_coalesce[slot].pending) _coalescePending--;   // Discarded, not delivered
+
+    // Keep slots packed: move the last one into the gap
+    uint8_t last = --_coalesceCount;
+    if (slot != last) {
+      _coalesce[slot] = _coalesce[last];
+      _coalesceIndex[_coalesce[slot].pin] = slot;
+    }
+    return true;
+  }
+
+  if (slot != 0xFF) return true;
+  if (_coalesceCount >= VWIRE_MAX_COALESCED_PINS) {
+    VWIRE_LOGF("[Vwire] Error: no coalescing slot for V%d (max %d)",
+               pin, VWIRE_MAX_COALESCED_PINS);
+    return false;
+  }
+  slot = _coalesceCount++;
+  _coalesce[slot].pin = pin;
+  _coalesce[slot].pending = false;
+  _coalesce[slot].length = 0;
+  _coalesce[slot].dropped = 0;
+  _coalesceIndex[pin] = slot;
+  return true;
+}
+
+uint16_t VwireClass::getDroppedCommands() const {
+  return _coalesceDropped;
+}
+
+// =============================================================================
+// INTERNAL
+// =============================================================================
+
+bool VwireClass::_coalesceStore(uint8_t pin, const char* payload, unsigned int length) {
+  CoalesceSlot& slot = _coalesce[_coalesceIndex[pin]];
+
+  if (slot.pending) {
+    // The held value is stale either way
+    VWIRE_METRIC_COUNT(_metrics.commandsCoalesced, 1);
+    if (slot.dropped < 0xFFFF) slot.dropped++;
+  }
+
+  if (length >= sizeof(slot.value)) {
+    // Too long to hold: deliver now, after everything older
+    if (slot.pending) {
+      slot.pending = false;
+      _coalescePending--;
+    }
+    _coalesceDropped = slot.dropped;
+    slot.dropped = 0;
+    return false;
+  }
+
+  memcpy(slot.value, payload, length);
+  slot.value[length] = '\0';
+  slot.length = (uint16_t)length;
+  if (!slot.pending) {
+    slot.pending = true;
+    _coalescePending++;
+  }
+  _coalesceStored = true;
+  return true;
+}
+
+void VwireClass::_coalesceRun() {
+  for (uint8_t i = 0; i < _coalesceCount; i++) {
+    CoalesceSlot& slot = _coalesce[i];
+    if (!slot.pending) continue;
+
+    // Copy out so the handler may receive or reconfigure the pin
+    char value[VWIRE_COALESCE_VALUE_SIZE];
+    unsigned int length = slot.length;
+    memcpy(value, slot.value, length + 1);
+    slot.pending = false;
+    _coalescePending--;
+    _coalesceDropped = slot.dropped;
+    slot.dropped = 0;
+
+    _callPinHandler(slot.pin, value, length);
+    _coalesceDropped = 0;
+  }
+}
+
+#else
+
+bool VwireClass::setCommandCoalescing(uint8_t pin, bool enable) {
+  (void)pin;
+  (void)enable;
+  _debugPrint("[Vwire] Command coalescing is not available in this build");
+  return false;
+}
+
+uint16_t VwireClass::getDroppedCommands() const {
+  return 0;
+}
+
+#endif // VWIRE_ENABLE_COALESCING
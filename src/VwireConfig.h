@@ -37,6 +37,8 @@
  * - VWIRE_HAS_SSL: TLS/SSL support available
  * - VWIRE_HAS_OTA: Over-the-air updates supported
  * - VWIRE_HAS_DEEP_SLEEP: Deep sleep mode available
+ * - VWIRE_HAS_FS: LittleFS flash filesystem available
+ * - VWIRE_HAS_CONFIG_STORE: Persistent config store (VwireStore) available
  */
 
 #if defined(ESP32)
@@ -46,6 +48,8 @@
   #define VWIRE_HAS_SSL 1
   #define VWIRE_HAS_OTA 1
   #define VWIRE_HAS_DEEP_SLEEP 1
+  #define VWIRE_HAS_FS 1
+  #define VWIRE_HAS_CONFIG_STORE 1
   #define VWIRE_MAX_PAYLOAD_LENGTH 2048   ///< Maximum MQTT payload size
   #define VWIRE_JSON_BUFFER_SIZE 1024     ///< JSON parsing buffer size
 
@@ -56,6 +60,8 @@
   #define VWIRE_HAS_SSL 1
   #define VWIRE_HAS_OTA 1
   #define VWIRE_HAS_DEEP_SLEEP 1
+  #define VWIRE_HAS_FS 1
+  #define VWIRE_HAS_CONFIG_STORE 1
   #define VWIRE_MAX_PAYLOAD_LENGTH 1024   ///< Limited by ESP8266 RAM
   #define VWIRE_JSON_BUFFER_SIZE 512      ///< Smaller buffer for ESP8266
 
@@ -66,6 +72,8 @@
   #define VWIRE_HAS_SSL 0                 ///< Limited SSL support on RP2040
   #define VWIRE_HAS_OTA 0
   #define VWIRE_HAS_DEEP_SLEEP 1
+  #define VWIRE_HAS_FS 0
+  #define VWIRE_HAS_CONFIG_STORE 0
   #define VWIRE_MAX_PAYLOAD_LENGTH 1024
   #define VWIRE_JSON_BUFFER_SIZE 512
 
@@ -76,6 +84,8 @@
   #define VWIRE_HAS_SSL 0
   #define VWIRE_HAS_OTA 0
   #define VWIRE_HAS_DEEP_SLEEP 0
+  #define VWIRE_HAS_FS 0
+  #define VWIRE_HAS_CONFIG_STORE 0
   #define VWIRE_MAX_PAYLOAD_LENGTH 512
   #define VWIRE_JSON_BUFFER_SIZE 256
 
@@ -86,6 +96,8 @@
   #define VWIRE_HAS_SSL 0
   #define VWIRE_HAS_OTA 0
   #define VWIRE_HAS_DEEP_SLEEP 0
+  #define VWIRE_HAS_FS 0
+  #define VWIRE_HAS_CONFIG_STORE 0
   #define VWIRE_MAX_PAYLOAD_LENGTH 512
   #define VWIRE_JSON_BUFFER_SIZE 256
 #endif
@@ -131,6 +143,160 @@
   #define VWIRE_ENABLE_ALERTS 0
 #endif
 
+#if !defined(VWIRE_DISABLE_BATCH)
+  #define VWIRE_ENABLE_BATCH 1
+#else
+  #define VWIRE_ENABLE_BATCH 0
+#endif
+
+/**
+ * @brief Dispatch inbound payloads straight from the MQTT receive buffer
+ *
+ * Payloads are null-terminated in place inside PubSubClient's buffer and
+ * handed to handlers, addons and VirtualPin without copying; outgoing
+ * packets are framed by the library and never touch that buffer. Define
+ * VWIRE_DISABLE_ZERO_COPY to go back to copying each payload into a
+ * VWIRE_MAX_PAYLOAD_LENGTH stack buffer.
+ */
+#if !defined(VWIRE_DISABLE_ZERO_COPY)
+  #define VWIRE_ENABLE_ZERO_COPY 1
+#else
+  #define VWIRE_ENABLE_ZERO_COPY 0
+#endif
+
+/**
+ * @brief Enable the persistent offline queue (LittleFS boards only)
+ *
+ * Pin writes made while disconnected are journaled to flash and replayed
+ * after reconnecting. The queue is only linked in when a sketch calls
+ * Vwire.setOfflineQueue(true); define VWIRE_DISABLE_OFFLINE_QUEUE to strip it.
+ */
+#if VWIRE_HAS_FS && !defined(VWIRE_DISABLE_OFFLINE_QUEUE)
+  #define VWIRE_ENABLE_OFFLINE_QUEUE 1
+#else
+  #define VWIRE_ENABLE_OFFLINE_QUEUE 0
+#endif
+
+/**
+ * @brief Per-pin deadband / rate-limit policies for outgoing values
+ *
+ * Policies only cost CPU for pins that have one; the slot table is
+ * VWIRE_MAX_PUBLISH_POLICIES entries plus a byte per virtual pin. Define
+ * VWIRE_DISABLE_PUBLISH_POLICY to strip it.
+ */
+#if !defined(VWIRE_DISABLE_PUBLISH_POLICY)
+  #define VWIRE_ENABLE_PUBLISH_POLICY 1
+#else
+  #define VWIRE_ENABLE_PUBLISH_POLICY 0
+#endif
+
+/**
+ * @brief Latest-wins coalescing of inbound virtual pin commands
+ *
+ * Only pins set up with Vwire.setCommandCoalescing() are affected; the
+ * mailbox table is VWIRE_MAX_COALESCED_PINS entries plus a byte per
+ * virtual pin. Define VWIRE_DISABLE_COALESCING to strip it.
+ */
+#if !defined(VWIRE_DISABLE_COALESCING)
+  #define VWIRE_ENABLE_COALESCING 1
+#else
+  #define VWIRE_ENABLE_COALESCING 0
+#endif
+
+/**
+ * @brief On-device benchmark (Vwire.startBenchmark())
+ *
+ * Publish throughput, command round trip, run() interval percentiles and
+ * heap low-water mark, reported as one JSON message on vwire/<id>/bench.
+ * Define VWIRE_DISABLE_BENCHMARK to strip it.
+ */
+#if !defined(VWIRE_DISABLE_BENCHMARK)
+  #define VWIRE_ENABLE_BENCHMARK 1
+#else
+  #define VWIRE_ENABLE_BENCHMARK 0
+#endif
+
+/**
+ * @brief Collect run() latency histograms and traffic/heap counters
+ *
+ * Adds a few micros() reads per run() call and a VwireMetrics block
+ * (about 0.5 KB) to VwireClass. Define VWIRE_DISABLE_METRICS to strip it.
+ */
+#if !defined(VWIRE_DISABLE_METRICS)
+  #define VWIRE_ENABLE_METRICS 1
+#else
+  #define VWIRE_ENABLE_METRICS 0
+#endif
+
+/**
+ * @brief Cooperative scheduler for addons and registered VwireTimers
+ *
+ * Gives each addon a period, priority and soft time budget, and caps the
+ * time one run() call spends on them. With no schedule set, addons run
+ * every call as before. Define VWIRE_DISABLE_SCHEDULER to strip it.
+ */
+#if !defined(VWIRE_DISABLE_SCHEDULER)
+  #define VWIRE_ENABLE_SCHEDULER 1
+#else
+  #define VWIRE_ENABLE_SCHEDULER 0
+#endif
+
+/**
+ * @brief Binary (CBOR) payloads for pin values, arrays and batches
+ *
+ * Only used after Vwire.setPayloadEncoding(VWIRE_ENCODING_CBOR) and the
+ * server accepting it; the encoder is header-only and small. Define
+ * VWIRE_DISABLE_CBOR to strip it.
+ */
+#if !defined(VWIRE_DISABLE_CBOR)
+  #define VWIRE_ENABLE_CBOR 1
+#else
+  #define VWIRE_ENABLE_CBOR 0
+#endif
+
+/**
+ * @brief Memory arena for the library's long-lived buffers
+ *
+ * Only used after Vwire.setMemoryBudget(); costs about 120 bytes of RAM
+ * for the region table otherwise. Define VWIRE_DISABLE_ARENA to strip it.
+ */
+#if !defined(VWIRE_DISABLE_ARENA)
+  #define VWIRE_ENABLE_ARENA 1
+#else
+  #define VWIRE_ENABLE_ARENA 0
+#endif
+
+/**
+ * @brief Optional FreeRTOS network task (ESP32 only)
+ *
+ * Vwire.startNetworkTask() moves the MQTT client, reconnects and addons to
+ * a task pinned to the protocol core; pin writes and inbound commands cross
+ * over through FreeRTOS queues. Nothing is created until it is called.
+ * Define VWIRE_DISABLE_NETWORK_TASK to strip it.
+ */
+#if defined(VWIRE_BOARD_ESP32) && !defined(VWIRE_DISABLE_NETWORK_TASK)
+  #define VWIRE_ENABLE_NETWORK_TASK 1
+#else
+  #define VWIRE_ENABLE_NETWORK_TASK 0
+#endif
+
+/**
+ * @brief Multi-network WiFi with roaming (ESP32/ESP8266)
+ *
+ * Vwire.addNetwork() keeps up to VWIRE_MAX_NETWORKS networks. With more
+ * than one, or after Vwire.setRoaming(true), connecting scans first and
+ * joins the strongest access point of any known network on its channel,
+ * and a connected device whose signal drops below the roaming threshold
+ * rescans in the background and moves to a clearly stronger access point
+ * of the same network. Costs about 400 bytes of RAM with the default four
+ * networks. Define VWIRE_DISABLE_ROAMING to strip it.
+ */
+#if (defined(VWIRE_BOARD_ESP32) || defined(VWIRE_BOARD_ESP8266)) && !defined(VWIRE_DISABLE_ROAMING)
+  #define VWIRE_ENABLE_ROAMING 1
+#else
+  #define VWIRE_ENABLE_ROAMING 0
+#endif
+
 /**
  * @brief Enable Cloud OTA firmware updates via VWire server
  *
@@ -147,6 +313,36 @@
   #define VWIRE_ENABLE_CLOUD_OTA 0
 #endif
 
+#if VWIRE_ENABLE_CLOUD_OTA
+  /**
+   * @brief Cloud OTA download tuning
+   *
+   * The download is read from run() in slices of at most
+   * VWIRE_OTA_SLICE_MS. A connection that drops or stalls for
+   * VWIRE_OTA_STALL_TIMEOUT is resumed with an HTTP Range request after a
+   * backoff (2 s doubling to 60 s); the update fails after
+   * VWIRE_OTA_MAX_RETRIES attempts in a row without new data.
+   */
+  #ifndef VWIRE_OTA_CHUNK_SIZE
+    #define VWIRE_OTA_CHUNK_SIZE 1024        ///< Bytes per read from the HTTP stream
+  #endif
+  #ifndef VWIRE_OTA_SLICE_MS
+    #define VWIRE_OTA_SLICE_MS 20            ///< Download time per run() call
+  #endif
+  #ifndef VWIRE_OTA_HTTP_TIMEOUT
+    #define VWIRE_OTA_HTTP_TIMEOUT 10000     ///< Connect / response header timeout (ms)
+  #endif
+  #ifndef VWIRE_OTA_STALL_TIMEOUT
+    #define VWIRE_OTA_STALL_TIMEOUT 15000    ///< No data for this long reopens the connection (ms)
+  #endif
+  #ifndef VWIRE_OTA_MAX_RETRIES
+    #define VWIRE_OTA_MAX_RETRIES 30
+  #endif
+  #ifndef VWIRE_OTA_PROGRESS_STEP
+    #define VWIRE_OTA_PROGRESS_STEP 5        ///< Percent between progress reports
+  #endif
+#endif
+
 // =============================================================================
 // DEFAULT SERVER CONFIGURATION
 // =============================================================================
@@ -182,12 +378,95 @@ typedef enum {
 /** @brief Maximum number of manually registered handlers */
 #define VWIRE_MAX_HANDLERS 32
 
+/** @brief Maximum virtual pins with a publish policy */
+#ifndef VWIRE_MAX_PUBLISH_POLICIES
+#define VWIRE_MAX_PUBLISH_POLICIES 8
+#endif
+
+/** @brief Longest value a publish policy can hold back for coalescing (bytes) */
+#ifndef VWIRE_POLICY_VALUE_SIZE
+#define VWIRE_POLICY_VALUE_SIZE 24
+#endif
+
+/** @brief Maximum virtual pins with latest-wins command coalescing */
+#ifndef VWIRE_MAX_COALESCED_PINS
+#define VWIRE_MAX_COALESCED_PINS 8
+#endif
+
+/** @brief Longest command a coalesced pin can hold (bytes); longer ones are delivered at once */
+#ifndef VWIRE_COALESCE_VALUE_SIZE
+#define VWIRE_COALESCE_VALUE_SIZE 32
+#endif
+
+/** @brief Extra packets run() reads while they only land in coalescing mailboxes */
+#ifndef VWIRE_COALESCE_MAX_READS
+#define VWIRE_COALESCE_MAX_READS 16
+#endif
+
 /** @brief Maximum auth token length */
 #define VWIRE_MAX_TOKEN_LENGTH 64
 
 /** @brief Maximum server hostname length */
 #define VWIRE_MAX_SERVER_LENGTH 64
 
+/**
+ * @brief Inline storage for a VirtualPin value (bytes, including terminator)
+ *
+ * Values that fit are stored inside the VirtualPin object itself, so numbers,
+ * short strings and small arrays never touch the heap. Longer values fall
+ * back to a single heap block sized to the value.
+ */
+#ifndef VWIRE_PIN_INLINE_SIZE
+  #define VWIRE_PIN_INLINE_SIZE 64
+#endif
+
+/**
+ * @brief Number of array element offsets cached per VirtualPin
+ *
+ * The first access to an array element indexes the value in one pass.
+ * Elements beyond this count are still reachable, but are located by
+ * scanning forward from the last cached offset.
+ */
+#ifndef VWIRE_PIN_ARRAY_CACHE
+  #define VWIRE_PIN_ARRAY_CACHE 16
+#endif
+
+// =============================================================================
+// BATCH PUBLISH CONFIGURATION
+// =============================================================================
+
+/**
+ * @brief Size of the buffer that collects batched pin writes
+ *
+ * All writes queued between beginBatch() and commitBatch() (or within one
+ * auto-batch window) are published together as a single MQTT message on
+ * vwire/{deviceId}/batch. When the buffer fills up, the pending writes are
+ * flushed early and collection continues in a fresh frame.
+ */
+#ifndef VWIRE_BATCH_BUFFER_SIZE
+  #define VWIRE_BATCH_BUFFER_SIZE VWIRE_JSON_BUFFER_SIZE
+#endif
+
+// =============================================================================
+// OFFLINE QUEUE CONFIGURATION
+// =============================================================================
+
+/** @brief Number of pin writes the flash journal can hold (oldest overwritten) */
+#ifndef VWIRE_OFFLINE_QUEUE_RECORDS
+  #define VWIRE_OFFLINE_QUEUE_RECORDS 512
+#endif
+
+/** @brief Maximum stored value length per journaled write (longer values are truncated) */
+#ifndef VWIRE_OFFLINE_VALUE_SIZE
+  #define VWIRE_OFFLINE_VALUE_SIZE 40
+#endif
+
+/** @brief Default number of journaled writes replayed per batch message */
+#define VWIRE_DEFAULT_OFFLINE_DRAIN_BATCH 16
+
+/** @brief Default delay between replay batches after reconnecting (ms) */
+#define VWIRE_DEFAULT_OFFLINE_DRAIN_INTERVAL 250
+
 // =============================================================================
 // TIMING CONFIGURATION
 // =============================================================================
@@ -195,15 +474,51 @@ typedef enum {
 /** @brief Default heartbeat interval (15 seconds) */
 #define VWIRE_DEFAULT_HEARTBEAT_INTERVAL 15000
 
-/** @brief Default reconnect attempt interval (5 seconds) */
+/** @brief Default initial reconnect backoff (5 seconds) */
 #define VWIRE_DEFAULT_RECONNECT_INTERVAL 5000
 
+/** @brief Default reconnect backoff limit (60 seconds) */
+#define VWIRE_DEFAULT_MAX_RECONNECT_INTERVAL 60000
+
+/** @brief Default lifetime of the cached broker address (5 minutes, 0 = no cache) */
+#define VWIRE_DEFAULT_DNS_CACHE_TTL 300000
+
 /** @brief Default WiFi connection timeout (30 seconds) */
 #define VWIRE_DEFAULT_WIFI_TIMEOUT 30000
 
 /** @brief Default MQTT connection timeout (10 seconds) */
 #define VWIRE_DEFAULT_MQTT_TIMEOUT 10000
 
+// =============================================================================
+// TLS CONFIGURATION
+// =============================================================================
+
+/** @brief Default BearSSL receive buffer on ESP8266 (bytes, 0 = size automatically) */
+#ifndef VWIRE_TLS_RX_BUFFER_SIZE
+#define VWIRE_TLS_RX_BUFFER_SIZE 2048
+#endif
+
+/** @brief Default BearSSL transmit buffer on ESP8266 (bytes) */
+#ifndef VWIRE_TLS_TX_BUFFER_SIZE
+#define VWIRE_TLS_TX_BUFFER_SIZE 1024
+#endif
+
+/** @brief WiFi timeout for a fast-wake reconnect before falling back to scan + DHCP (ms) */
+#ifndef VWIRE_FAST_WAKE_WIFI_TIMEOUT
+#define VWIRE_FAST_WAKE_WIFI_TIMEOUT 3000
+#endif
+
+/** @brief Interval between heap watermark samples in run() (ms) */
+#define VWIRE_METRICS_SAMPLE_INTERVAL 1000
+
+/** @brief Default time publishAndSleep() waits for delivery before sleeping (ms) */
+#define VWIRE_DEFAULT_SLEEP_WAIT 5000
+
+/** @brief ESP8266 RTC user memory offset (4-byte blocks) of the saved connection cache */
+#ifndef VWIRE_RTC_CACHE_OFFSET
+#define VWIRE_RTC_CACHE_OFFSET 64
+#endif
+
 // =============================================================================
 // RELIABLE DELIVERY CONFIGURATION
 // =============================================================================
@@ -214,8 +529,25 @@ typedef enum {
 /** @brief Default maximum retry attempts */
 #define VWIRE_DEFAULT_MAX_RETRIES 3
 
-/** @brief Maximum queued messages (memory constraint) */
-#define VWIRE_MAX_PENDING_MESSAGES 10
+/**
+ * @brief In-flight window: maximum unacknowledged messages (memory constraint)
+ *
+ * Messages are numbered with increasing sequence numbers and stored in slot
+ * seq % VWIRE_MAX_PENDING_MESSAGES, so an ACK is matched in O(1). A new
+ * message is refused while the oldest unacknowledged one still holds the
+ * slot it would reuse.
+ */
+#ifndef VWIRE_MAX_PENDING_MESSAGES
+  #define VWIRE_MAX_PENDING_MESSAGES 10
+#endif
+
+/** @brief Maximum value length held for retransmission (bytes, including terminator) */
+#ifndef VWIRE_RELIABLE_VALUE_SIZE
+  #define VWIRE_RELIABLE_VALUE_SIZE 64
+#endif
+
+/** @brief Upper bound for the exponential retry backoff (60 seconds) */
+#define VWIRE_MAX_ACK_BACKOFF 60000
 
 // =============================================================================
 // CONNECTION STATES
@@ -233,6 +565,22 @@ typedef enum {
   VWIRE_STATE_ERROR              ///< Error state
 } VwireState;
 
+/**
+ * @brief Step of the non-blocking connection engine
+ *
+ * VwireState is the public summary; this is the finer-grained position
+ * run() uses to resume connecting where the previous call left off.
+ */
+typedef enum {
+  VWIRE_STEP_IDLE = 0,           ///< Connected, or not trying to connect
+  VWIRE_STEP_SCAN,               ///< Scanning for the strongest known access point (roaming)
+  VWIRE_STEP_WIFI,               ///< Waiting for WiFi association / DHCP lease
+  VWIRE_STEP_RESOLVE,            ///< Resolving the broker hostname
+  VWIRE_STEP_TRANSPORT,          ///< Opening the TCP connection (and TLS handshake)
+  VWIRE_STEP_MQTT,               ///< Sending MQTT CONNECT, waiting for CONNACK
+  VWIRE_STEP_BACKOFF             ///< Waiting before the next attempt
+} VwireConnectStep;
+
 // =============================================================================
 // ERROR CODES
 // =============================================================================
@@ -267,9 +615,16 @@ typedef enum {
   VWIRE_GPIO_INPUT_PULLUP = 2,   ///< Digital input with pull-up
   VWIRE_GPIO_PWM          = 3,   ///< PWM output alias (kept for compatibility)
   VWIRE_GPIO_ANALOG_INPUT = 4,   ///< Analog input (ADC reading)
+  VWIRE_GPIO_COUNTER      = 5,   ///< Pulse counter (publishes the running total)
+  VWIRE_GPIO_FREQUENCY    = 6,   ///< Pulse rate (publishes Hz)
   VWIRE_GPIO_DISABLED     = 255  ///< Pin not managed
 } VwireGPIOMode;
 
+/** @brief Default debounce time for edge-triggered GPIO inputs (ms) */
+#ifndef VWIRE_GPIO_DEBOUNCE_MS
+  #define VWIRE_GPIO_DEBOUNCE_MS 20
+#endif
+
 /**
  * @brief Callback for log/debug output
  * @param message Log message (newline NOT included)
@@ -289,12 +644,183 @@ typedef void (*DeliveryCallback)(const char* msgId, bool success);
 
 /** @brief Maximum number of addons that can be registered */
 #ifndef VWIRE_MAX_ADDONS
-  #define VWIRE_MAX_ADDONS 4
+  #define VWIRE_MAX_ADDONS 6
+#endif
+
+/** @brief VwireTimer instances that can be registered with Vwire.addTimer() */
+#ifndef VWIRE_MAX_SCHED_TIMERS
+  #define VWIRE_MAX_SCHED_TIMERS 2
+#endif
+
+/** @brief Scheduler task slots: every addon plus the registered timers */
+#define VWIRE_MAX_TASKS (VWIRE_MAX_ADDONS + VWIRE_MAX_SCHED_TIMERS)
+
+/**
+ * @brief Scheduler priority of an addon or timer
+ *
+ * Due tasks run in priority order. Once the run() budget is spent, the
+ * rest wait for the next call and then run ahead of the budget check, so a
+ * low-priority task is never delayed by more than one run() call.
+ */
+typedef enum {
+  VWIRE_PRIORITY_HIGH = 0,      ///< Control loops, command handling
+  VWIRE_PRIORITY_NORMAL,        ///< Default for addons and timers
+  VWIRE_PRIORITY_LOW            ///< Housekeeping that can wait
+} VwireTaskPriority;
+
+// =============================================================================
+// NETWORK TASK (ESP32)
+// =============================================================================
+
+/** @brief Core the network task is pinned to (0 = protocol core) */
+#ifndef VWIRE_NET_TASK_CORE
+  #define VWIRE_NET_TASK_CORE 0
+#endif
+
+/** @brief Network task stack in bytes (TLS handshakes need about 6 KB) */
+#ifndef VWIRE_NET_TASK_STACK
+  #define VWIRE_NET_TASK_STACK 8192
+#endif
+
+/** @brief Network task priority (above the Arduino loop task's 1) */
+#ifndef VWIRE_NET_TASK_PRIORITY
+  #define VWIRE_NET_TASK_PRIORITY 3
+#endif
+
+/** @brief Pin writes queued from the app to the network task */
+#ifndef VWIRE_NET_OUT_QUEUE
+  #define VWIRE_NET_OUT_QUEUE 16
+#endif
+
+/** @brief Inbound virtual pin commands queued for the app */
+#ifndef VWIRE_NET_IN_QUEUE
+  #define VWIRE_NET_IN_QUEUE 8
+#endif
+
+/** @brief Largest value carried by a queue entry, including the terminator */
+#ifndef VWIRE_NET_VALUE_SIZE
+  #define VWIRE_NET_VALUE_SIZE 64
+#endif
+
+/**
+ * @brief Longest an app-side publish waits for the network task, in ms
+ *
+ * The task keeps the client locked through reconnect steps (DNS, TCP/TLS
+ * connect, MQTT CONNECT); publish(), notify(), syncVirtual() and friends
+ * give up after this long with VWIRE_ERR_TIMEOUT instead of stalling loop().
+ */
+#ifndef VWIRE_NET_LOCK_TIMEOUT
+  #define VWIRE_NET_LOCK_TIMEOUT 20
+#endif
+
+// =============================================================================
+// WIFI ROAMING (ESP32/ESP8266)
+// =============================================================================
+
+/** @brief Networks addNetwork() and begin() can register */
+#ifndef VWIRE_MAX_NETWORKS
+  #define VWIRE_MAX_NETWORKS 4
+#endif
+
+/** @brief Default setRoaming() threshold: a weaker signal (dBm) starts a scan */
+#ifndef VWIRE_ROAM_RSSI_THRESHOLD
+  #define VWIRE_ROAM_RSSI_THRESHOLD -72
+#endif
+
+/** @brief dB a new access point must be stronger by before the device moves */
+#ifndef VWIRE_ROAM_HYSTERESIS
+  #define VWIRE_ROAM_HYSTERESIS 8
+#endif
+
+/** @brief RSSI sample period while connected (ms) */
+#ifndef VWIRE_ROAM_CHECK_INTERVAL
+  #define VWIRE_ROAM_CHECK_INTERVAL 5000
+#endif
+
+/** @brief Minimum time between background scans (ms) */
+#ifndef VWIRE_ROAM_SCAN_INTERVAL
+  #define VWIRE_ROAM_SCAN_INTERVAL 60000
+#endif
+
+/** @brief A scan still running after this long is abandoned (ms) */
+#ifndef VWIRE_ROAM_SCAN_TIMEOUT
+  #define VWIRE_ROAM_SCAN_TIMEOUT 8000
+#endif
+
+// =============================================================================
+// BENCHMARK
+// =============================================================================
+
+/** @brief Default length of the publish phase (ms) */
+#ifndef VWIRE_BENCH_PUBLISH_MS
+  #define VWIRE_BENCH_PUBLISH_MS 5000
+#endif
+
+/** @brief Default virtual pin the benchmark publishes and probes on */
+#ifndef VWIRE_BENCH_PIN
+  #define VWIRE_BENCH_PIN 127
+#endif
+
+/** @brief Values published per run() during the publish phase */
+#ifndef VWIRE_BENCH_BURST
+  #define VWIRE_BENCH_BURST 4
+#endif
+
+/** @brief Command round-trip probes, sent one at a time */
+#ifndef VWIRE_BENCH_PROBES
+  #define VWIRE_BENCH_PROBES 16
+#endif
+
+/** @brief A probe not back after this long counts as lost (ms) */
+#ifndef VWIRE_BENCH_PROBE_TIMEOUT
+  #define VWIRE_BENCH_PROBE_TIMEOUT 3000
+#endif
+
+/** @brief run() intervals kept for the percentiles (uniform sample of all) */
+#ifndef VWIRE_BENCH_SAMPLES
+  #define VWIRE_BENCH_SAMPLES 64
 #endif
 
 // Forward declaration
 class VwireClass;
 
+/**
+ * @brief Payload encoding for outgoing pin data
+ */
+typedef enum {
+  VWIRE_ENCODING_TEXT = 0,       ///< Text values, JSON batches (default)
+  VWIRE_ENCODING_CBOR            ///< CBOR values, raw float32/int arrays, CBOR batches
+} VwireEncoding;
+
+/**
+ * @brief Classification of an incoming MQTT topic
+ *
+ * The core parses each topic once against vwire/{deviceId}/ and tags the
+ * message, so addons can route on an integer instead of scanning the topic.
+ */
+typedef enum {
+  VWIRE_MSG_OTHER = 0,           ///< Not under vwire/{deviceId}/ (custom subscription)
+  VWIRE_MSG_DEVICE,              ///< Other vwire/{deviceId}/... topic
+  VWIRE_MSG_CMD,                 ///< vwire/{deviceId}/cmd/{pin}
+  VWIRE_MSG_PINCONFIG,           ///< vwire/{deviceId}/pinconfig
+  VWIRE_MSG_OTA,                 ///< vwire/{deviceId}/ota
+  VWIRE_MSG_ACK                  ///< vwire/{deviceId}/ack
+} VwireMessageType;
+
+/**
+ * @brief Incoming MQTT message, parsed once by the core
+ */
+struct VwireMessage {
+  const char* topic;             ///< Full topic
+  const char* payload;           ///< Null-terminated payload
+  unsigned int length;           ///< Payload length in bytes
+  VwireMessageType type;         ///< Topic classification
+  const char* subtopic;          ///< Topic after "vwire/{deviceId}/" (nullptr for OTHER)
+  const char* pinName;           ///< CMD only: pin name after "/cmd/" ("V3", "D5", "A0")
+  char pinType;                  ///< CMD only: 'V', 'D' or 'A' (0 if unknown)
+  int pin;                       ///< CMD only: pin number (-1 if not parsed)
+};
+
 /**
  * @brief Base class for modular addons
  *
@@ -306,8 +832,12 @@ class VwireClass;
  *   onConnect()    — called after MQTT connects (subscribe here)
  *   onDisconnect() — called when connection drops
  *   onMessage()    — called for every incoming MQTT message; return true
- *                     if the addon handled it (stops further dispatch)
- *   onRun()        — called every run() iteration while connected
+ *                     if the addon handled it (stops further dispatch).
+ *                     Override the VwireMessage overload to route on the
+ *                     pre-parsed topic type; by default it forwards to the
+ *                     (topic, payload) overload.
+ *   onRun()        — called every run() iteration while connected, or
+ *                     on the period set with Vwire.setAddonSchedule()
  */
 class VwireAddon {
 public:
@@ -315,6 +845,9 @@ public:
   virtual void onAttach(VwireClass& vwire) { (void)vwire; }
   virtual void onConnect() {}
   virtual void onDisconnect() {}
+  virtual bool onMessage(const VwireMessage& message) {
+    return onMessage(message.topic, message.payload);
+  }
   virtual bool onMessage(const char* topic, const char* payload) {
     (void)topic; (void)payload; return false;
   }
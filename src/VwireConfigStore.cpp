@@ -0,0 +1,581 @@
+/*
+ * Vwire IOT Arduino Library - Config Store Implementation
+ *
+ * ESP8266 page layout (one flash sector each):
+ *   [magic][sequence][crc]                  page header, written last
+ *   [key][type][length][crc][value ...]     records, padded to 4 bytes
+ *   0xFF ...                                erased, room for appends
+ *
+ * A record whose CRC does not match ends the log: it is a write that was
+ * cut off, and the next write moves to a fresh page.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "VwireConfigStore.h"
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+VwireConfigStoreClass VwireStore;
+
+#if defined(VWIRE_BOARD_ESP32)
+
+// =============================================================================
+// ESP32 (NVS)
+// =============================================================================
+
+/** @brief Values up to this size are compared before they are rewritten */
+#define VWIRE_STORE_COMPARE_SIZE 256
+
+VwireConfigStoreClass::VwireConfigStoreClass() : _mounted(false) {}
+
+void VwireConfigStoreClass::_name(char* out, uint8_t key) {
+  static const char hex[] = "0123456789abcdef";
+  out[0] = 'k';
+  out[1] = hex[key >> 4];
+  out[2] = hex[key & 0x0F];
+  out[3] = '\0';
+}
+
+bool VwireConfigStoreClass::begin() {
+  if (!_mounted) {
+    _mounted = _preferences.begin(VWIRE_CONFIG_STORE_NAMESPACE, false);
+  }
+  return _mounted;
+}
+
+size_t VwireConfigStoreClass::get(uint8_t key, void* data, size_t size) {
+  if (!begin()) return 0;
+  char name[4];
+  _name(name, key);
+  size_t stored = _preferences.getBytesLength(name);
+  if (stored == 0) return 0;
+  if (data && size >= stored && _preferences.getBytes(name, data, stored) != stored) {
+    return 0;
+  }
+  return stored;
+}
+
+size_t VwireConfigStoreClass::length(uint8_t key) {
+  return get(key, nullptr, 0);
+}
+
+bool VwireConfigStoreClass::put(uint8_t key, const void* data, size_t size) {
+  if (key == 0 || key == 0xFF || size == 0 || !data || size > VWIRE_CONFIG_STORE_MAX_VALUE) {
+    return false;
+  }
+  if (!begin()) return false;
+  char name[4];
+  _name(name, key);
+
+  if (size <= VWIRE_STORE_COMPARE_SIZE && _preferences.getBytesLength(name) == size) {
+    uint8_t current[VWIRE_STORE_COMPARE_SIZE];
+    if (_preferences.getBytes(name, current, size) == size && memcmp(current, data, size) == 0) {
+      return true;
+    }
+  }
+  return _preferences.putBytes(name, data, size) == size;
+}
+
+bool VwireConfigStoreClass::remove(uint8_t key) {
+  if (!begin()) return false;
+  char name[4];
+  _name(name, key);
+  return _preferences.getBytesLength(name) == 0 || _preferences.remove(name);
+}
+
+bool VwireConfigStoreClass::clear() {
+  return begin() && _preferences.clear();
+}
+
+#elif defined(VWIRE_BOARD_ESP8266)
+
+// =============================================================================
+// ESP8266 (RAW FLASH LOG)
+// =============================================================================
+
+#include <spi_flash.h>
+
+// Linker symbols of the flash layout (see the board's .ld file)
+extern "C" uint32_t _EEPROM_start;
+extern "C" uint32_t _FS_start;
+extern "C" uint32_t _FS_end;
+
+#define VWIRE_STORE_FLASH_BASE 0x40200000UL   // Flash mapping of the linker symbols
+#define VWIRE_STORE_PAGE_SIZE  SPI_FLASH_SEC_SIZE
+#define VWIRE_STORE_MAGIC      0x31534356UL   // "VCS1"
+#define VWIRE_STORE_VALUE      0x5A           // Record type: value
+#define VWIRE_STORE_REMOVED    0xA5           // Record type: key deleted
+#define VWIRE_STORE_CHUNK      64             // Staging buffer for flash I/O
+
+static_assert(VWIRE_CONFIG_STORE_LEGACY_SIZE % 4 == 0 &&
+              VWIRE_CONFIG_STORE_LEGACY_SIZE <= VWIRE_CONFIG_STORE_MAX_VALUE,
+              "VWIRE_CONFIG_STORE_LEGACY_SIZE must be a multiple of 4 and fit a value");
+
+/** @brief Page header (3 words) */
+struct VwireStorePage {
+  uint32_t magic;
+  uint32_t sequence;                   ///< Highest valid page is the active one
+  uint32_t crc;                        ///< CRC32 of magic and sequence
+};
+
+/** @brief Record header (2 words), followed by the value */
+struct VwireStoreRecord {
+  uint8_t key;
+  uint8_t type;                        ///< VWIRE_STORE_VALUE or VWIRE_STORE_REMOVED
+  uint16_t length;                     ///< Value length
+  uint32_t crc;                        ///< CRC32 of key, type, length and value
+};
+
+// Running CRC32 (IEEE, as in zlib): start at 0xFFFFFFFF, invert when done
+static uint32_t _vwireCrc32(const void* data, size_t length, uint32_t crc = 0xFFFFFFFFUL) {
+  static const uint32_t table[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+  };
+  const uint8_t* bytes = (const uint8_t*)data;
+  while (length--) {
+    crc ^= *bytes++;
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+  }
+  return crc;
+}
+
+static size_t _vwirePad(size_t length) {
+  return (length + 3) & ~(size_t)3;
+}
+
+static size_t _vwireRecordSize(size_t length) {
+  return sizeof(VwireStoreRecord) + _vwirePad(length);
+}
+
+VwireConfigStoreClass::VwireConfigStoreClass()
+  : _mounted(false), _count(0), _pages(1), _page(0), _sequence(0), _tail(0), _dirty(false) {
+  _sectors[0] = 0;
+  _sectors[1] = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+bool VwireConfigStoreClass::begin() {
+  if (_mounted) return true;
+  _locate();
+
+  uint32_t sequences[2];
+  int8_t active = -1;
+  for (uint8_t page = 0; page < _pages; page++) {
+    if (!_readHeader(page, sequences[page])) continue;
+    if (active < 0 || (int32_t)(sequences[page] - sequences[active]) > 0) {
+      active = page;
+    }
+  }
+
+  if (active < 0) {
+    if (!_format()) return false;
+  } else {
+    _page = (uint8_t)active;
+    _sequence = sequences[active];
+    _scan();
+  }
+  _mounted = true;
+  return true;
+}
+
+size_t VwireConfigStoreClass::get(uint8_t key, void* data, size_t size) {
+  if (!begin()) return 0;
+  Entry* entry = _find(key);
+  if (!entry) return 0;
+  if (!data || size < entry->length) return entry->length;
+
+  uint32_t chunk[VWIRE_STORE_CHUNK / 4];
+  uint8_t* out = (uint8_t*)data;
+  uint16_t offset = entry->offset + sizeof(VwireStoreRecord);
+  for (size_t done = 0; done < entry->length; ) {
+    size_t n = entry->length - done;
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    if (!_read(_page, offset + done, chunk, _vwirePad(n))) return 0;
+    memcpy(out + done, chunk, n);
+    done += n;
+  }
+  return entry->length;
+}
+
+size_t VwireConfigStoreClass::length(uint8_t key) {
+  if (!begin()) return 0;
+  Entry* entry = _find(key);
+  return entry ? entry->length : 0;
+}
+
+bool VwireConfigStoreClass::put(uint8_t key, const void* data, size_t size) {
+  if (key == 0 || key == 0xFF || size == 0 || !data || size > VWIRE_CONFIG_STORE_MAX_VALUE) {
+    return false;
+  }
+  if (!begin()) return false;
+  Entry* entry = _find(key);
+  if (entry && _same(*entry, data, size)) return true;
+  if (!entry && _count >= VWIRE_CONFIG_STORE_MAX_KEYS) return false;
+  return _append(key, VWIRE_STORE_VALUE, data, size);
+}
+
+bool VwireConfigStoreClass::remove(uint8_t key) {
+  if (!begin()) return false;
+  if (!_find(key)) return true;
+  return _append(key, VWIRE_STORE_REMOVED, nullptr, 0);
+}
+
+bool VwireConfigStoreClass::clear() {
+  if (!begin()) return false;
+  for (uint8_t page = 0; page < _pages; page++) {
+    if (!_erase(page)) return false;
+  }
+  _count = 0;
+  _page = 0;
+  _tail = sizeof(VwireStorePage);
+  _dirty = false;
+  return _writeHeader(0, ++_sequence);
+}
+
+// -----------------------------------------------------------------------------
+// Log
+// -----------------------------------------------------------------------------
+
+void VwireConfigStoreClass::_locate() {
+  #if defined(VWIRE_CONFIG_STORE_SECTOR)
+  _sectors[0] = VWIRE_CONFIG_STORE_SECTOR;
+  #else
+  _sectors[0] = ((uint32_t)&_EEPROM_start - VWIRE_STORE_FLASH_BASE) / VWIRE_STORE_PAGE_SIZE;
+  #endif
+
+  #if defined(VWIRE_CONFIG_STORE_SPARE_SECTOR)
+  _sectors[1] = VWIRE_CONFIG_STORE_SPARE_SECTOR;
+  #else
+  // Free only when a filesystem ends below it: without one, OTA images are
+  // staged right under the EEPROM
+  uint32_t fsEnd = ((uint32_t)&_FS_end - VWIRE_STORE_FLASH_BASE) / VWIRE_STORE_PAGE_SIZE;
+  bool hasFs = (uint32_t)&_FS_end > (uint32_t)&_FS_start;
+  _sectors[1] = (hasFs && fsEnd < _sectors[0]) ? _sectors[0] - 1 : 0;
+  #endif
+
+  _pages = _sectors[1] != 0 ? 2 : 1;
+}
+
+bool VwireConfigStoreClass::_format() {
+  // Keep what the EEPROM library (or an older version of this library)
+  // left in the sector
+  uint32_t legacy[VWIRE_CONFIG_STORE_LEGACY_SIZE / 4];
+  bool keep = false;
+  if (_read(0, 0, legacy, sizeof(legacy))) {
+    for (size_t i = 0; i < sizeof(legacy) / 4 && !keep; i++) {
+      keep = legacy[i] != 0xFFFFFFFFUL;
+    }
+  }
+
+  // On the spare sector when there is one, so the EEPROM sector survives
+  // until the new log is committed
+  uint8_t page = _pages - 1;
+  uint16_t offset = sizeof(VwireStorePage);
+  if (!_erase(page)) return false;
+  if (keep && !_writeRecord(page, offset, VWIRE_CONFIG_LEGACY_EEPROM, VWIRE_STORE_VALUE,
+                            legacy, sizeof(legacy))) {
+    return false;
+  }
+  if (!_writeHeader(page, 1)) return false;
+
+  _page = page;
+  _sequence = 1;
+  _count = 0;
+  _tail = offset;
+  _dirty = false;
+  if (keep) {
+    _index(VWIRE_CONFIG_LEGACY_EEPROM, offset, sizeof(legacy));
+    _tail += _vwireRecordSize(sizeof(legacy));
+  }
+  return true;
+}
+
+void VwireConfigStoreClass::_scan() {
+  _count = 0;
+  _dirty = false;
+  uint16_t offset = sizeof(VwireStorePage);
+
+  while (offset + sizeof(VwireStoreRecord) <= VWIRE_STORE_PAGE_SIZE) {
+    uint32_t words[2];
+    if (!_read(_page, offset, words, sizeof(words))) {
+      _dirty = true;
+      break;
+    }
+    if (words[0] == 0xFFFFFFFFUL && words[1] == 0xFFFFFFFFUL) break;   // End of log
+
+    VwireStoreRecord record;
+    memcpy(&record, words, sizeof(record));
+    size_t size = _vwireRecordSize(record.length);
+    uint32_t crc = _vwireCrc32(&record, 4);
+    bool valid = (record.type == VWIRE_STORE_VALUE || record.type == VWIRE_STORE_REMOVED) &&
+                 record.key != 0 && record.key != 0xFF &&
+                 offset + size <= VWIRE_STORE_PAGE_SIZE &&
+                 _flashCrc(_page, offset + sizeof(record), record.length, crc) &&
+                 ~crc == record.crc;
+    if (!valid) {
+      _dirty = true;                   // Cut-off write: nothing after it is trusted
+      break;
+    }
+
+    if (record.type == VWIRE_STORE_VALUE) {
+      _index(record.key, offset, record.length);
+    } else {
+      _drop(record.key);
+    }
+    offset += size;
+  }
+  _tail = offset;
+}
+
+bool VwireConfigStoreClass::_append(uint8_t key, uint8_t type, const void* data, size_t size) {
+  size_t recordSize = _vwireRecordSize(size);
+  if (_dirty || _tail + recordSize > VWIRE_STORE_PAGE_SIZE) {
+    return _compact(key, type, data, size);
+  }
+  if (!_writeRecord(_page, _tail, key, type, data, size)) {
+    _dirty = true;
+    return false;
+  }
+  if (type == VWIRE_STORE_VALUE) {
+    _index(key, _tail, size);
+  } else {
+    _drop(key);
+  }
+  _tail += recordSize;
+  return true;
+}
+
+bool VwireConfigStoreClass::_compact(uint8_t key, uint8_t type, const void* data, size_t size) {
+  // The surviving records and the new one must fit one empty page
+  size_t live = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_entries[i].key != key) live += _vwireRecordSize(_entries[i].length);
+  }
+  size_t needed = sizeof(VwireStorePage) + live +
+                  (type == VWIRE_STORE_VALUE ? _vwireRecordSize(size) : 0);
+  if (needed > VWIRE_STORE_PAGE_SIZE) return false;
+
+  uint8_t target = _pages == 2 ? (uint8_t)(1 - _page) : _page;
+  uint32_t* saved = nullptr;
+  if (target == _page && live > 0) {
+    // Single sector: the live records have to sit in RAM across the erase
+    saved = (uint32_t*)malloc(live);
+    if (!saved) return false;
+    size_t at = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (_entries[i].key == key) continue;
+      size_t recordSize = _vwireRecordSize(_entries[i].length);
+      if (!_read(_page, _entries[i].offset, saved + at / 4, recordSize)) {
+        free(saved);
+        return false;
+      }
+      at += recordSize;
+    }
+  }
+
+  bool ok = _erase(target);
+  uint16_t offset = sizeof(VwireStorePage);
+  size_t at = 0;
+  for (uint8_t i = 0; ok && i < _count; i++) {
+    if (_entries[i].key == key) continue;
+    size_t recordSize = _vwireRecordSize(_entries[i].length);
+    ok = saved ? _write(target, offset, saved + at / 4, recordSize)
+               : _copy(target, offset, _entries[i].offset, recordSize);
+    _entries[i].offset = offset;
+    offset += recordSize;
+    at += recordSize;
+  }
+  uint16_t recordOffset = offset;
+  if (ok && type == VWIRE_STORE_VALUE) {
+    ok = _writeRecord(target, offset, key, type, data, size);
+    offset += _vwireRecordSize(size);
+  }
+  if (ok) ok = _writeHeader(target, _sequence + 1);
+  free(saved);
+
+  if (!ok) {
+    _scan();                           // The old page is still the valid one
+    return false;
+  }
+
+  _page = target;
+  _sequence++;
+  _tail = offset;
+  _dirty = false;
+  if (type == VWIRE_STORE_VALUE) {
+    _index(key, recordOffset, size);
+  } else {
+    _drop(key);
+  }
+  return true;
+}
+
+bool VwireConfigStoreClass::_writeHeader(uint8_t page, uint32_t sequence) {
+  VwireStorePage header;
+  header.magic = VWIRE_STORE_MAGIC;
+  header.sequence = sequence;
+  header.crc = ~_vwireCrc32(&header, offsetof(VwireStorePage, crc));
+  if (!_write(page, 0, (const uint32_t*)&header, sizeof(header))) return false;
+
+  uint32_t check;
+  return _readHeader(page, check) && check == sequence;
+}
+
+bool VwireConfigStoreClass::_readHeader(uint8_t page, uint32_t& sequence) {
+  VwireStorePage header;
+  if (!_read(page, 0, (uint32_t*)&header, sizeof(header))) return false;
+  if (header.magic != VWIRE_STORE_MAGIC ||
+      header.crc != ~_vwireCrc32(&header, offsetof(VwireStorePage, crc))) {
+    return false;
+  }
+  sequence = header.sequence;
+  return true;
+}
+
+bool VwireConfigStoreClass::_writeRecord(uint8_t page, uint16_t offset, uint8_t key, uint8_t type,
+                                         const void* data, size_t size) {
+  VwireStoreRecord record;
+  record.key = key;
+  record.type = type;
+  record.length = (uint16_t)size;
+  uint32_t crc = _vwireCrc32(&record, 4);
+  record.crc = ~_vwireCrc32(data, size, crc);
+
+  // Header, value and padding go out through one word-aligned staging buffer
+  const uint8_t* header = (const uint8_t*)&record;
+  const uint8_t* value = (const uint8_t*)data;
+  size_t total = _vwireRecordSize(size);
+  uint32_t chunk[VWIRE_STORE_CHUNK / 4];
+  uint8_t* bytes = (uint8_t*)chunk;
+  for (size_t done = 0; done < total; ) {
+    size_t n = total - done;
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    for (size_t i = 0; i < n; i++) {
+      size_t at = done + i;
+      if (at < sizeof(record)) bytes[i] = header[at];
+      else if (at - sizeof(record) < size) bytes[i] = value[at - sizeof(record)];
+      else bytes[i] = 0xFF;
+    }
+    if (!_write(page, offset + done, chunk, n)) return false;
+    done += n;
+  }
+
+  // Read back: the record only counts if flash holds what was meant
+  return _flashCrc(page, offset + sizeof(record), size, crc) && ~crc == record.crc;
+}
+
+bool VwireConfigStoreClass::_copy(uint8_t page, uint16_t to, uint16_t from, size_t size) {
+  uint32_t chunk[VWIRE_STORE_CHUNK / 4];
+  for (size_t done = 0; done < size; ) {
+    size_t n = size - done;
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    if (!_read(_page, from + done, chunk, n) || !_write(page, to + done, chunk, n)) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool VwireConfigStoreClass::_same(const Entry& entry, const void* data, size_t size) {
+  if (entry.length != size) return false;
+  uint32_t chunk[VWIRE_STORE_CHUNK / 4];
+  const uint8_t* value = (const uint8_t*)data;
+  uint16_t offset = entry.offset + sizeof(VwireStoreRecord);
+  for (size_t done = 0; done < size; ) {
+    size_t n = size - done;
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    if (!_read(_page, offset + done, chunk, _vwirePad(n)) ||
+        memcmp(chunk, value + done, n) != 0) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool VwireConfigStoreClass::_flashCrc(uint8_t page, uint16_t offset, size_t size, uint32_t& crc) {
+  uint32_t chunk[VWIRE_STORE_CHUNK / 4];
+  for (size_t done = 0; done < size; ) {
+    size_t n = size - done;
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    if (!_read(page, offset + done, chunk, _vwirePad(n))) return false;
+    crc = _vwireCrc32(chunk, n, crc);
+    done += n;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Flash access (4-byte aligned addresses, lengths and buffers)
+// -----------------------------------------------------------------------------
+
+bool VwireConfigStoreClass::_read(uint8_t page, uint16_t offset, uint32_t* data, size_t size) {
+  return ESP.flashRead(_sectors[page] * VWIRE_STORE_PAGE_SIZE + offset, data, size);
+}
+
+bool VwireConfigStoreClass::_write(uint8_t page, uint16_t offset, const uint32_t* data, size_t size) {
+  return ESP.flashWrite(_sectors[page] * VWIRE_STORE_PAGE_SIZE + offset, (uint32_t*)data, size);
+}
+
+bool VwireConfigStoreClass::_erase(uint8_t page) {
+  return ESP.flashEraseSector(_sectors[page]);
+}
+
+// -----------------------------------------------------------------------------
+// Index
+// -----------------------------------------------------------------------------
+
+VwireConfigStoreClass::Entry* VwireConfigStoreClass::_find(uint8_t key) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_entries[i].key == key) return &_entries[i];
+  }
+  return nullptr;
+}
+
+void VwireConfigStoreClass::_index(uint8_t key, uint16_t offset, uint16_t length) {
+  Entry* entry = _find(key);
+  if (!entry) {
+    if (_count >= VWIRE_CONFIG_STORE_MAX_KEYS) return;
+    entry = &_entries[_count++];
+    entry->key = key;
+  }
+  entry->offset = offset;
+  entry->length = length;
+}
+
+void VwireConfigStoreClass::_drop(uint8_t key) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_entries[i].key == key) {
+      _entries[i] = _entries[--_count];
+      return;
+    }
+  }
+}
+
+#else
+
+// =============================================================================
+// NO PERSISTENT STORAGE
+// =============================================================================
+
+VwireConfigStoreClass::VwireConfigStoreClass() : _mounted(false) {}
+bool VwireConfigStoreClass::begin() { return false; }
+size_t VwireConfigStoreClass::get(uint8_t key, void* data, size_t size) { (void)key; (void)data; (void)size; return 0; }
+size_t VwireConfigStoreClass::length(uint8_t key) { (void)key; return 0; }
+bool VwireConfigStoreClass::put(uint8_t key, const void* data, size_t size) { (void)key; (void)data; (void)size; return false; }
+bool VwireConfigStoreClass::remove(uint8_t key) { (void)key; return false; }
+bool VwireConfigStoreClass::clear() { return false; }
+
+#endif
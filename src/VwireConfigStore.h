@@ -0,0 +1,189 @@
+/*
+ * Vwire IOT Arduino Library - Config Store
+ *
+ * Small key/value store for what the library keeps across power cycles:
+ * the provisioned WiFi credentials and token, the last access point and
+ * the offline queue replay position. Sketches can keep their own values
+ * under keys from VWIRE_CONFIG_USER up.
+ *
+ * ESP8266: a log in two raw flash sectors. A write appends one record
+ * (key, length, CRC32, value) to the active sector without erasing it, and
+ * a value that did not change is not written at all. When the sector is
+ * full the live records, together with the new one, are copied to the
+ * other sector, whose header goes last with a higher sequence number; an
+ * interrupted write or compaction leaves the previous state in charge.
+ * Mounting reads the active sector once and indexes the latest record of
+ * every key, so later reads go straight to the value.
+ *
+ * ESP32: NVS already is a wear-levelled, CRC32-checked log with atomic
+ * updates, so each key is one NVS blob in a namespace opened once.
+ *
+ * Usage:
+ *   struct Settings { uint16_t interval; uint8_t mode; } settings;
+ *   if (VwireStore.get(VWIRE_CONFIG_USER, &settings, sizeof(settings)) != sizeof(settings)) {
+ *     settings = { 60, 0 };
+ *   }
+ *   VwireStore.put(VWIRE_CONFIG_USER, &settings, sizeof(settings));
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_CONFIG_STORE_H
+#define VWIRE_CONFIG_STORE_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+#if defined(VWIRE_BOARD_ESP32)
+  #include <Preferences.h>
+#endif
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+/** @brief Preferences namespace of the store (ESP32) */
+#ifndef VWIRE_CONFIG_STORE_NAMESPACE
+  #define VWIRE_CONFIG_STORE_NAMESPACE "vwire_cfg"
+#endif
+
+/** @brief Distinct keys the store indexes (ESP8266) */
+#ifndef VWIRE_CONFIG_STORE_MAX_KEYS
+  #define VWIRE_CONFIG_STORE_MAX_KEYS 16
+#endif
+
+/** @brief Largest value put() accepts */
+#ifndef VWIRE_CONFIG_STORE_MAX_VALUE
+  #define VWIRE_CONFIG_STORE_MAX_VALUE 512
+#endif
+
+/**
+ * @brief Bytes of the old EEPROM image kept when the store is created (ESP8266)
+ *
+ * The first time the store takes over the EEPROM sector, whatever EEPROM
+ * data it finds there is saved under VWIRE_CONFIG_LEGACY_EEPROM so older
+ * credentials can be migrated.
+ */
+#ifndef VWIRE_CONFIG_STORE_LEGACY_SIZE
+  #define VWIRE_CONFIG_STORE_LEGACY_SIZE 256
+#endif
+
+/*
+ * ESP8266 flash location. VWIRE_CONFIG_STORE_SECTOR defaults to the EEPROM
+ * sector. VWIRE_CONFIG_STORE_SPARE_SECTOR defaults to the sector below it
+ * when that sector lies between the filesystem and the EEPROM (the common
+ * 4 MB layouts leave it unused); define it as 0 to run on one sector, in
+ * which case compaction is not power-safe.
+ */
+
+// =============================================================================
+// KEYS
+// =============================================================================
+
+/**
+ * @brief Keys used by the library
+ *
+ * 0x00 and 0xFF are not valid keys.
+ */
+enum VwireConfigKey : uint8_t {
+  VWIRE_CONFIG_CREDENTIALS   = 0x01,   ///< VwireCredentials (provisioning)
+  VWIRE_CONFIG_ACCESS_POINT  = 0x02,   ///< Last WiFi AP joined: BSSID and channel
+  VWIRE_CONFIG_OFFLINE_INDEX = 0x03,   ///< Offline queue replay position
+  VWIRE_CONFIG_NETWORKS      = 0x04,   ///< Networks saved by Vwire.saveNetworks()
+  VWIRE_CONFIG_LEGACY_EEPROM = 0x3F,   ///< EEPROM image found when the store was created
+  VWIRE_CONFIG_USER          = 0x40    ///< First key for sketch values (0x40-0xFE)
+};
+
+// =============================================================================
+// CONFIG STORE
+// =============================================================================
+
+/**
+ * @brief Persistent key/value store
+ *
+ * The store mounts on first use. All calls return false / 0 on boards
+ * without VWIRE_HAS_CONFIG_STORE.
+ */
+class VwireConfigStoreClass {
+public:
+  VwireConfigStoreClass();
+
+  /** @brief Mount the store (done by the first get/put if not called) */
+  bool begin();
+
+  /**
+   * @brief Read a value
+   * @param data Destination, filled only if size is at least the stored length
+   * @return Stored length, 0 if the key is not set
+   */
+  size_t get(uint8_t key, void* data, size_t size);
+
+  /** @brief Stored length of key, 0 if not set */
+  size_t length(uint8_t key);
+
+  /**
+   * @brief Write a value
+   *
+   * A value equal to the stored one is not written again.
+   */
+  bool put(uint8_t key, const void* data, size_t size);
+
+  /** @brief Delete a key (true if it is gone) */
+  bool remove(uint8_t key);
+
+  /** @brief Delete every key */
+  bool clear();
+
+private:
+  bool _mounted;
+
+  #if defined(VWIRE_BOARD_ESP32)
+  Preferences _preferences;
+
+  static void _name(char* out, uint8_t key);
+  #elif defined(VWIRE_BOARD_ESP8266)
+  /** @brief Latest record of one key */
+  struct Entry {
+    uint8_t key;
+    uint16_t offset;                   ///< Record header offset in the active page
+    uint16_t length;                   ///< Value length
+  };
+
+  Entry _entries[VWIRE_CONFIG_STORE_MAX_KEYS];
+  uint8_t _count;
+  uint32_t _sectors[2];
+  uint8_t _pages;                      ///< 2 when a spare sector is available
+  uint8_t _page;                       ///< Active page
+  uint32_t _sequence;                  ///< Sequence number of the active page
+  uint16_t _tail;                      ///< Next append offset
+  bool _dirty;                         ///< Bytes after _tail are not erased
+
+  void _locate();
+  bool _format();
+  void _scan();
+  bool _append(uint8_t key, uint8_t type, const void* data, size_t size);
+  bool _compact(uint8_t key, uint8_t type, const void* data, size_t size);
+  bool _writeHeader(uint8_t page, uint32_t sequence);
+  bool _writeRecord(uint8_t page, uint16_t offset, uint8_t key, uint8_t type,
+                    const void* data, size_t size);
+  bool _copy(uint8_t page, uint16_t to, uint16_t from, size_t size);
+  bool _same(const Entry& entry, const void* data, size_t size);
+  bool _readHeader(uint8_t page, uint32_t& sequence);
+  bool _flashCrc(uint8_t page, uint16_t offset, size_t size, uint32_t& crc);
+  bool _read(uint8_t page, uint16_t offset, uint32_t* data, size_t size);
+  bool _write(uint8_t page, uint16_t offset, const uint32_t* data, size_t size);
+  bool _erase(uint8_t page);
+  Entry* _find(uint8_t key);
+  void _index(uint8_t key, uint16_t offset, uint16_t length);
+  void _drop(uint8_t key);
+  #endif
+};
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+extern VwireConfigStoreClass VwireStore;
+
+#endif // VWIRE_CONFIG_STORE_H
@@ -0,0 +1,368 @@
+/*
+ * Vwire IOT Arduino Library - Connection Cache
+ *
+ * Shortens reconnects by reusing work from the previous connection:
+ * - The resolved broker address is kept for a configurable TTL
+ * - On ESP8266, the BearSSL session is offered again so the broker can
+ *   resume it without a new key exchange
+ * - Both can be parked in RTC memory across deep sleep, together with the
+ *   WiFi BSSID, channel and IP settings so a woken node skips scan and DHCP
+ * - The last AP (BSSID and channel) also goes to VwireStore, so a cold
+ *   boot can join it directly and fall back to a scan only if that fails
+ * - publishAndSleep() wraps the wake / send / sleep cycle of battery nodes
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+#include "VwireConfigStore.h"
+
+#if defined(VWIRE_BOARD_ESP32)
+  #include <esp_sleep.h>
+#endif
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+// =============================================================================
+// RTC STORAGE
+// =============================================================================
+
+#if defined(VWIRE_BOARD_ESP32) || defined(VWIRE_BOARD_ESP8266)
+#define VWIRE_RTC_CACHE 1
+
+#define VWIRE_RTC_CACHE_MAGIC   0x56434331UL   // "VCC1"
+#define VWIRE_RTC_CACHE_ADDRESS 0x01           // flags: address valid
+#define VWIRE_RTC_CACHE_SESSION 0x02           // flags: TLS session valid
+#define VWIRE_RTC_CACHE_WIFI    0x04           // flags: WiFi AP and IP settings valid
+
+/** @brief Connection cache as saved across deep sleep */
+struct VwireRtcCacheData {
+  uint32_t magic;
+  uint32_t checksum;            ///< FNV-1a over everything after this field
+  uint32_t serverHash;          ///< Cache belongs to this server:port
+  uint32_t ttlRemaining;        ///< DNS TTL left when saved (ms)
+  uint8_t address[4];
+  uint8_t flags;
+  uint8_t channel;              ///< WiFi channel of the saved AP
+  uint8_t bssid[6];             ///< Saved AP
+  uint32_t ssidHash;            ///< WiFi settings belong to this SSID
+  uint8_t localIP[4];
+  uint8_t gateway[4];
+  uint8_t subnet[4];
+  uint8_t dns[4];
+  #if defined(VWIRE_BOARD_ESP8266)
+  uint8_t session[sizeof(BearSSL::Session)];  ///< Raw copy (BearSSL::Session is plain data)
+  #endif
+};
+
+/** @brief Word view for ESP8266 RTC user memory, which is 4-byte addressed */
+union VwireRtcCache {
+  VwireRtcCacheData data;
+  uint32_t words[(sizeof(VwireRtcCacheData) + 3) / 4];
+};
+
+#if defined(VWIRE_BOARD_ESP32)
+RTC_DATA_ATTR static VwireRtcCache _vwireRtcCache;
+#endif
+
+static uint32_t _vwireFnv1a(const uint8_t* data, size_t length, uint32_t hash = 2166136261UL) {
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+static uint32_t _vwireRtcChecksum(const VwireRtcCache& cache) {
+  const uint8_t* bytes = (const uint8_t*)&cache.data;
+  size_t offset = offsetof(VwireRtcCacheData, serverHash);
+  return _vwireFnv1a(bytes + offset, sizeof(VwireRtcCacheData) - offset);
+}
+
+static uint32_t _vwireServerHash(const char* server, uint16_t port) {
+  uint32_t hash = _vwireFnv1a((const uint8_t*)server, strlen(server));
+  return _vwireFnv1a((const uint8_t*)&port, sizeof(port), hash);
+}
+
+static bool _vwireRtcRead(VwireRtcCache& cache) {
+  #if defined(VWIRE_BOARD_ESP32)
+  cache = _vwireRtcCache;
+  #else
+  if (!ESP.rtcUserMemoryRead(VWIRE_RTC_CACHE_OFFSET, cache.words, sizeof(cache.words))) {
+    return false;
+  }
+  #endif
+  return cache.data.magic == VWIRE_RTC_CACHE_MAGIC &&
+         cache.data.checksum == _vwireRtcChecksum(cache);
+}
+
+static bool _vwireRtcWrite(VwireRtcCache& cache) {
+  #if defined(VWIRE_BOARD_ESP32)
+  _vwireRtcCache = cache;
+  return true;
+  #else
+  return ESP.rtcUserMemoryWrite(VWIRE_RTC_CACHE_OFFSET, cache.words, sizeof(cache.words));
+  #endif
+}
+
+static void _vwireStoreIP(uint8_t* out, const IPAddress& ip) {
+  for (uint8_t i = 0; i < 4; i++) out[i] = ip[i];
+}
+
+static IPAddress _vwireLoadIP(const uint8_t* in) {
+  return IPAddress(in[0], in[1], in[2], in[3]);
+}
+
+/** @brief Last AP as kept in VwireStore (VWIRE_CONFIG_ACCESS_POINT) */
+struct VwireStoredAP {
+  uint32_t ssidHash;            ///< AP belongs to this SSID
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t reserved;
+};
+#endif // ESP32 || ESP8266
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void VwireClass::setDnsCacheTtl(unsigned long ttl) {
+  _settings.dnsCacheTtl = ttl;
+  if (ttl == 0) {
+    _brokerIPCached = false;
+  }
+}
+
+void VwireClass::setTlsSessionCache(bool enable) {
+  _settings.tlsSessionCache = enable;
+  #if defined(VWIRE_BOARD_ESP8266)
+  _secureClient.setSession(enable ? &_tlsSession : nullptr);
+  #endif
+}
+
+void VwireClass::setTlsBufferSizes(uint16_t rx, uint16_t tx) {
+  _settings.tlsRxBufferSize = rx;
+  _settings.tlsTxBufferSize = tx > 0 ? tx : VWIRE_TLS_TX_BUFFER_SIZE;
+}
+
+void VwireClass::_applyTlsBufferSizes() {
+  #if defined(VWIRE_BOARD_ESP8266)
+  uint16_t rx = _settings.tlsRxBufferSize;
+  if (rx == 0) {
+    if (_tlsAutoRxSize == 0 && WiFi.status() == WL_CONNECTED) {
+      // BearSSL asks for the max fragment length matching its buffer. Use the
+      // smallest size that still fits a full payload in one record.
+      static const uint16_t sizes[] = { 512, 1024, 2048, 4096 };
+      for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] < VWIRE_MAX_PAYLOAD_LENGTH) continue;
+        if (BearSSL::WiFiClientSecure::probeMaxFragmentLength(_settings.server, _settings.port, sizes[i])) {
+          _tlsAutoRxSize = sizes[i];
+          break;
+        }
+      }
+      if (_tlsAutoRxSize == 0) {
+        _tlsAutoRxSize = 16384;     // No MFLN support: full-size TLS records
+      }
+      VWIRE_LOGF("[Vwire] TLS RX buffer sized to %u bytes", _tlsAutoRxSize);
+    }
+    rx = _tlsAutoRxSize > 0 ? _tlsAutoRxSize : 16384;
+  }
+  _secureClient.setBufferSizes(rx, _settings.tlsTxBufferSize);
+  #endif
+}
+
+// =============================================================================
+// DEEP SLEEP PERSISTENCE
+// =============================================================================
+
+bool VwireClass::saveConnectionCache(unsigned long sleepMs) {
+#if VWIRE_RTC_CACHE
+  VwireRtcCache cache;
+  memset(&cache, 0, sizeof(cache));
+
+  unsigned long now = millis();
+  if (_brokerIPCached && (long)(_brokerIPExpires - now) > (long)sleepMs) {
+    cache.data.ttlRemaining = _brokerIPExpires - now - sleepMs;
+    _vwireStoreIP(cache.data.address, _brokerIP);
+    cache.data.flags |= VWIRE_RTC_CACHE_ADDRESS;
+  }
+  if (WiFi.status() == WL_CONNECTED) {
+    String ssid = WiFi.SSID();
+    const uint8_t* bssid = WiFi.BSSID();
+    if (bssid) {
+      memcpy(cache.data.bssid, bssid, sizeof(cache.data.bssid));
+      cache.data.channel = (uint8_t)WiFi.channel();
+      cache.data.ssidHash = _vwireFnv1a((const uint8_t*)ssid.c_str(), ssid.length());
+      _vwireStoreIP(cache.data.localIP, WiFi.localIP());
+      _vwireStoreIP(cache.data.gateway, WiFi.gatewayIP());
+      _vwireStoreIP(cache.data.subnet, WiFi.subnetMask());
+      _vwireStoreIP(cache.data.dns, WiFi.dnsIP());
+      cache.data.flags |= VWIRE_RTC_CACHE_WIFI;
+    }
+  }
+  #if defined(VWIRE_BOARD_ESP8266)
+  if (_settings.tlsSessionCache && _settings.transport == VWIRE_TRANSPORT_TCP_SSL) {
+    memcpy(cache.data.session, (const void*)&_tlsSession, sizeof(cache.data.session));
+    cache.data.flags |= VWIRE_RTC_CACHE_SESSION;
+  }
+  #endif
+  if (cache.data.flags == 0) {
+    return false;
+  }
+
+  cache.data.magic = VWIRE_RTC_CACHE_MAGIC;
+  cache.data.serverHash = _vwireServerHash(_settings.server, _settings.port);
+  cache.data.checksum = _vwireRtcChecksum(cache);
+  return _vwireRtcWrite(cache);
+#else
+  (void)sleepMs;
+  return false;
+#endif
+}
+
+void VwireClass::clearConnectionCache() {
+  _brokerIPCached = false;
+  #if defined(VWIRE_BOARD_ESP8266)
+  _tlsSession = BearSSL::Session();
+  #endif
+  #if VWIRE_RTC_CACHE
+  VwireRtcCache cache;
+  memset(&cache, 0, sizeof(cache));
+  _vwireRtcWrite(cache);
+  #endif
+}
+
+bool VwireClass::_beginFastWake(const char* ssid, const char* password) {
+#if VWIRE_RTC_CACHE
+  uint32_t ssidHash = _vwireFnv1a((const uint8_t*)ssid, strlen(ssid));
+  VwireRtcCache cache;
+  if (!_vwireRtcRead(cache) || !(cache.data.flags & VWIRE_RTC_CACHE_WIFI) ||
+      cache.data.ssidHash != ssidHash) {
+    // Cold boot: join the AP stored in flash, with DHCP
+    VwireStoredAP ap;
+    if (VwireStore.get(VWIRE_CONFIG_ACCESS_POINT, &ap, sizeof(ap)) != sizeof(ap) ||
+        ap.ssidHash != ssidHash) {
+      return false;
+    }
+    VWIRE_LOGF("[Vwire] Fast join: stored AP on channel %d", ap.channel);
+    WiFi.persistent(false);
+    WiFi.begin(ssid, password, ap.channel, ap.bssid, true);
+    return true;
+  }
+
+  VWIRE_LOGF("[Vwire] Fast wake: channel %d, IP %s", cache.data.channel,
+             _vwireLoadIP(cache.data.localIP).toString().c_str());
+  WiFi.persistent(false);     // Don't rewrite the flash config on every wake
+  WiFi.config(_vwireLoadIP(cache.data.localIP), _vwireLoadIP(cache.data.gateway),
+              _vwireLoadIP(cache.data.subnet), _vwireLoadIP(cache.data.dns));
+  WiFi.begin(ssid, password, cache.data.channel, cache.data.bssid, true);
+  return true;
+#else
+  (void)ssid;
+  (void)password;
+  return false;
+#endif
+}
+
+void VwireClass::_dropFastWake() {
+#if VWIRE_RTC_CACHE
+  VwireRtcCache cache;
+  if (_vwireRtcRead(cache) && (cache.data.flags & VWIRE_RTC_CACHE_WIFI)) {
+    cache.data.flags &= ~VWIRE_RTC_CACHE_WIFI;
+    cache.data.checksum = _vwireRtcChecksum(cache);
+    _vwireRtcWrite(cache);
+  }
+  VwireStore.remove(VWIRE_CONFIG_ACCESS_POINT);
+#endif
+}
+
+void VwireClass::_saveAccessPoint() {
+#if VWIRE_RTC_CACHE
+  const uint8_t* bssid = WiFi.BSSID();
+  if (!bssid) return;
+  String ssid = WiFi.SSID();
+  VwireStoredAP ap;
+  memset(&ap, 0, sizeof(ap));
+  ap.ssidHash = _vwireFnv1a((const uint8_t*)ssid.c_str(), ssid.length());
+  memcpy(ap.bssid, bssid, sizeof(ap.bssid));
+  ap.channel = (uint8_t)WiFi.channel();
+  // Unchanged after most reconnects, in which case nothing is written
+  VwireStore.put(VWIRE_CONFIG_ACCESS_POINT, &ap, sizeof(ap));
+#endif
+}
+
+void VwireClass::_restoreConnectionCache() {
+#if VWIRE_RTC_CACHE
+  VwireRtcCache cache;
+  if (!_vwireRtcRead(cache) ||
+      cache.data.serverHash != _vwireServerHash(_settings.server, _settings.port)) {
+    return;
+  }
+
+  if ((cache.data.flags & VWIRE_RTC_CACHE_ADDRESS) && _settings.dnsCacheTtl > 0) {
+    _brokerIP = _vwireLoadIP(cache.data.address);
+    _brokerIPCached = true;
+    _brokerIPExpires = millis() + cache.data.ttlRemaining;
+  }
+  #if defined(VWIRE_BOARD_ESP8266)
+  if (cache.data.flags & VWIRE_RTC_CACHE_SESSION) {
+    memcpy((void*)&_tlsSession, cache.data.session, sizeof(cache.data.session));
+  }
+  #endif
+  VWIRE_LOG("[Vwire] Connection cache restored from RTC memory");
+#endif
+}
+
+// =============================================================================
+// DEEP SLEEP
+// =============================================================================
+
+bool VwireClass::publishAndSleep(unsigned long sleepMs, unsigned long maxWaitMs) {
+#if VWIRE_RTC_CACHE
+  unsigned long start = millis();
+
+  // Let a connection that is still coming up finish
+  while (!connected() && _connectStep != VWIRE_STEP_IDLE &&
+         _connectStep != VWIRE_STEP_BACKOFF && millis() - start < maxWaitMs) {
+    run();
+    delay(1);
+  }
+
+  if (connected()) {
+    #if VWIRE_ENABLE_BATCH
+    _batchFlush();
+    #endif
+    // Stay up only while something is still owed to the server
+    while (millis() - start < maxWaitMs && connected() &&
+           (isDeliveryPending() || getOfflineQueued() > 0)) {
+      run();
+      delay(1);
+    }
+  }
+
+  saveConnectionCache(sleepMs);
+  disconnect();
+  VWIRE_LOGF("[Vwire] Deep sleep for %lu ms (awake %lu ms)", sleepMs, millis() - start);
+  delay(10);                        // Let the DISCONNECT leave the radio
+
+  #if defined(VWIRE_BOARD_ESP32)
+  esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+  esp_deep_sleep_start();
+  #else
+  ESP.deepSleep((uint64_t)sleepMs * 1000ULL);
+  #endif
+  return true;
+#else
+  (void)sleepMs;
+  (void)maxWaitMs;
+  VWIRE_LOG("[Vwire] Deep sleep is not available on this board");
+  return false;
+#endif
+}
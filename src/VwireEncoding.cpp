@@ -0,0 +1,152 @@
+/*
+ * Vwire IOT Arduino Library - Payload Encoding
+ *
+ * Negotiates CBOR with the server and publishes CBOR pin values and
+ * arrays. Each payload is encoded twice by VwireCborWriter: a counting pass
+ * for the MQTT length, then straight into the client, so no payload buffer
+ * is needed and arrays keep their raw float32/int values.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_CBOR
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void VwireClass::setPayloadEncoding(VwireEncoding encoding, bool force) {
+  NetGuard guard(this, true);
+  bool offer = encoding == VWIRE_ENCODING_CBOR;
+  bool newOffer = offer && !_cborOffered;
+  _cborOffered = offer;
+  _cborForced = offer && force;
+
+  if (!connected()) {
+    return;                          // Applied on the next connect
+  }
+
+  if (newOffer && !force) {
+    // Announce now instead of waiting for a reconnect
+    const char* onlineMessage = "{\"status\":\"online\",\"enc\":\"cbor\"}";
+    char topic[96];
+    _topic(topic, sizeof(topic), "encoding");
+    _streamSubscribe(topic, 1);
+    _topic(topic, sizeof(topic), "status");
+    _streamPublish(topic, onlineMessage, strlen(onlineMessage), true);
+  }
+  if (!offer || force) {
+    _setCborActive(_cborForced);
+  }
+}
+
+VwireEncoding VwireClass::getPayloadEncoding() const {
+  return _cborActive ? VWIRE_ENCODING_CBOR : VWIRE_ENCODING_TEXT;
+}
+
+// =============================================================================
+// INTERNAL
+// =============================================================================
+
+void VwireClass::_setCborActive(bool active) {
+  if (active == _cborActive) return;
+
+  #if VWIRE_ENABLE_BATCH
+  // Pending entries are in the old encoding
+  if (_batchCount > 0) {
+    _batchFlush();
+  }
+  #endif
+  _cborActive = active;
+  VWIRE_LOGF("[Vwire] Payload encoding: %s", active ? "CBOR" : "text");
+}
+
+bool VwireClass::_cborDirect(uint8_t pin) {
+  // Arrays skip the text form only when nothing downstream needs it
+  if (!_cborActive || !connected() || isBatching()) return false;
+  #if VWIRE_ENABLE_NETWORK_TASK
+  if (_netTask && _onAppSide()) return false;
+  #endif
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  if (pin < VWIRE_MAX_VIRTUAL_PINS && _policyIndex[pin] != 0xFF) return false;
+  #else
+  (void)pin;
+  #endif
+  if (_reliableDeliveryAddon && _reliableDeliveryAddon->isEnabled()) return false;
+  return true;
+}
+
+bool VwireClass::_publishCborValue(const char* topic, const char* value) {
+  VwireCborWriter sizer;
+  sizer.writeValue(value);
+
+  VwirePublishStream stream(_transportClient());
+  stream.begin(topic, sizer.length(), _settings.dataRetain);
+  {
+    VwireCborWriter out(&stream);
+    out.writeValue(value);
+  }
+  return stream.end();
+}
+
+void VwireClass::_publishCborArray(uint8_t pin, const float* floats, const int* ints, int count) {
+  if (count < 0) count = 0;
+
+  char topic[96];
+  _pinTopic(topic, sizeof(topic), "pin/V", pin);
+
+  VwireCborWriter sizer;
+  sizer.writeArray((uint32_t)count);
+  for (int i = 0; i < count; i++) {
+    if (floats) sizer.writeFloat(floats[i]);
+    else sizer.writeInt((int32_t)ints[i]);
+  }
+
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
+  VWIRE_METRIC_START(publishStart);
+  VwirePublishStream stream(_transportClient());
+  stream.begin(topic, sizer.length(), _settings.dataRetain);
+  {
+    VwireCborWriter out(&stream);
+    out.writeArray((uint32_t)count);
+    for (int i = 0; i < count; i++) {
+      if (floats) out.writeFloat(floats[i]);
+      else out.writeInt((int32_t)ints[i]);
+    }
+  }
+  bool ok = stream.end();
+  #if VWIRE_ENABLE_METRICS
+  _recordPublish(publishStart, strlen(topic) + sizer.length(), ok);
+  #else
+  (void)ok;
+  #endif
+  VWIRE_LOGF("[Vwire] Send V%d = [%d values, %u bytes CBOR]", pin, count, (unsigned)sizer.length());
+}
+
+#else
+
+void VwireClass::setPayloadEncoding(VwireEncoding encoding, bool force) {
+  (void)force;
+  if (encoding != VWIRE_ENCODING_TEXT) {
+    _debugPrint("[Vwire] CBOR encoding is not available in this build");
+  }
+}
+
+VwireEncoding VwireClass::getPayloadEncoding() const {
+  return VWIRE_ENCODING_TEXT;
+}
+
+#endif // VWIRE_ENABLE_CBOR
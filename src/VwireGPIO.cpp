@@ -10,6 +10,10 @@
 #include "Vwire.h"        // Full VwireClass definition (needed for publish/subscribe)
 #include <ArduinoJson.h>
 
+#if VWIRE_GPIO_HAS_PCNT
+  #include <driver/pulse_cnt.h>
+#endif
+
 #if VWIRE_ENABLE_LOGGING
   #define VWIRE_LOG(message) _vwire->_debugPrint(message)
   #define VWIRE_LOGF(...) _vwire->_debugPrintf(__VA_ARGS__)
@@ -81,17 +85,56 @@ uint8_t VwireClass::getGPIOPinCount() const {
   return _gpioAddon ? _gpioAddon->getPinCount() : 0;
 }
 
+bool VwireClass::setGPIOPublishPolicy(const char* pinName, const VwirePublishPolicy& policy) {
+  return _gpioAddon ? _gpioAddon->setPublishPolicy(pinName, policy) : false;
+}
+
+bool VwireClass::setGPIOAnalogFilter(const char* pinName, const VwireAnalogFilter& filter) {
+  return _gpioAddon ? _gpioAddon->setAnalogFilter(pinName, filter) : false;
+}
+
+bool VwireClass::setGPIOEdgeTrigger(const char* pinName, bool enable, uint16_t debounceMs) {
+  return _gpioAddon ? _gpioAddon->setEdgeTrigger(pinName, enable, debounceMs) : false;
+}
+
+uint32_t VwireClass::getGPIOPulseCount(const char* pinName) const {
+  return _gpioAddon ? _gpioAddon->getPulseCount(pinName) : 0;
+}
+
+float VwireClass::getGPIOFrequency(const char* pinName) const {
+  return _gpioAddon ? _gpioAddon->getFrequency(pinName) : 0;
+}
+
+bool VwireClass::resetGPIOPulseCount(const char* pinName) {
+  return _gpioAddon ? _gpioAddon->resetPulseCount(pinName) : false;
+}
+
 // =============================================================================
 // CONSTRUCTOR
 // =============================================================================
 
-VwireGPIO::VwireGPIO() : _vwire(nullptr), _count(0) {
+VwireGPIO::VwireGPIO()
+  : _vwire(nullptr), _count(0), _inputCount(0)
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  , _adcRate(0), _adcCount(0), _adcRunning(false), _adcDirty(false)
+  #endif
+{
   for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
     _pins[i].active = false;
     _pins[i].lastValue = -32768;  // sentinel — forces first publish
     _pins[i].lastRead = 0;
+    _pins[i].dueAt = 0;
     _pins[i].flags = 0;
+    _pins[i].filter = 0xFF;
+    _pins[i].irq = 0xFF;
+    #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+    _pins[i].adcRaw = -1;
+    #endif
   }
+  memset(_nameIndex, 0xFF, sizeof(_nameIndex));
+  memset(_irqOwner, 0xFF, sizeof(_irqOwner));
+  _irqSettle = 0;
+  memset(_counters, 0, sizeof(_counters));
 }
 
 // =============================================================================
@@ -116,63 +159,639 @@ void VwireGPIO::onConnect() {
 
   // Subscribe to pinconfig topic: vwire/{deviceId}/pinconfig
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/pinconfig", _vwire->getDeviceId());
+  _vwire->_topic(topic, sizeof(topic), "pinconfig");
   _vwire->subscribe(topic, 1);
 }
 
-bool VwireGPIO::onMessage(const char* topic, const char* payload) {
+bool VwireGPIO::onMessage(const VwireMessage& message) {
   // Handle pinconfig: vwire/{deviceId}/pinconfig
-  char* pinconfigPos = strstr(topic, "/pinconfig");
-  if (pinconfigPos && *(pinconfigPos + 10) == '\0') {
-    _applyConfig(payload);
+  if (message.type == VWIRE_MSG_PINCONFIG) {
+    _applyConfig(message.payload);
     return true;
   }
 
   // Handle D*/A* commands: vwire/{deviceId}/cmd/D* or /cmd/A*
-  char* cmdPos = strstr(topic, "/cmd/");
-  if (cmdPos) {
-    char* pinStr = cmdPos + 5;
-    if (*pinStr == 'D' || *pinStr == 'd' || *pinStr == 'A' || *pinStr == 'a') {
-      char gpioName[6];
-      strncpy(gpioName, pinStr, sizeof(gpioName) - 1);
-      gpioName[sizeof(gpioName) - 1] = '\0';
-      for (char* c = gpioName; *c; c++) *c = toupper(*c);
-
-      int value = atoi(payload);
-      handleCommand(gpioName, value);
-      return true;
-    }
+  // (_findPin() matches the name without case, no copy needed)
+  if (message.type == VWIRE_MSG_CMD &&
+      (message.pinType == 'D' || message.pinType == 'A')) {
+    handleCommand(message.pinName, atoi(message.payload));
+    return true;
   }
 
   return false;  // Not handled
 }
 
 void VwireGPIO::onRun() {
-  if (_count == 0 || !_vwire) return;
+  if (!_vwire) return;
+
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  _pollContinuousAdc();
+  #endif
+
+  if (_count == 0) return;
 
   unsigned long now = millis();
+  _drainEdges(now);
+
+  // _inputs is ordered by dueAt: service pins from the front until the
+  // first one that has nothing to do yet. Each serviced pin moves back.
+  for (uint8_t n = _inputCount; n > 0 && _inputCount > 0; n--) {
+    uint8_t slot = _inputs[0];
+    if ((long)(now - _pins[slot].dueAt) < 0) break;
+    _servicePin(_pins[slot], now);
+    _schedule(slot, now);
+  }
+}
 
-  for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
-    VwireGPIOPin& p = _pins[i];
-    if (!p.active) continue;
+void VwireGPIO::_servicePin(VwireGPIOPin& p, unsigned long now) {
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  // A change held back by minInterval, or a maxInterval refresh
+  if (p.gate.due(now)) {
+    if (p.mode == VWIRE_GPIO_FREQUENCY && p.irq != 0xFF) {
+      p.gate.markSent(true, _counters[p.irq].hz, 0, now);
+      _publishFrequency(p.pinName, _counters[p.irq].hz);
+    } else if (p.mode == VWIRE_GPIO_COUNTER && p.irq != 0xFF) {
+      p.gate.markCount(_counters[p.irq].total, now);
+      _publishCount(p.pinName, _counters[p.irq].total);
+    } else {
+      p.gate.markSent(true, p.lastValue, 0, now);
+      _publishValue(p.pinName, p.lastValue);
+    }
+  }
+  #endif
+
+  if (_isPulseMode(p.mode)) {
+    if (p.irq != 0xFF && now - p.lastRead >= p.readInterval) {
+      p.lastRead = now;
+      _readCounter(p, now);
+    }
+    return;
+  }
+
+  if (p.irq != 0xFF) return;        // Reported by _drainEdges()
+
+  if (p.filter != 0xFF && p.mode == VWIRE_GPIO_ANALOG_INPUT) {
+    int value;
+    if (_sampleFiltered(p, now, value)) {
+      _reportInput(p, value, now);
+    }
+    return;
+  }
+
+  if (now - p.lastRead < p.readInterval) return;
+  p.lastRead = now;
+
+  _reportInput(p, _readHardware(p), now);
+}
+
+// =============================================================================
+// INPUT SCHEDULING
+// =============================================================================
+
+static void _vwireEarliest(unsigned long& due, unsigned long at) {
+  if ((long)(at - due) < 0) due = at;
+}
+
+bool VwireGPIO::_isInputMode(VwireGPIOMode mode) {
+  return mode == VWIRE_GPIO_INPUT || mode == VWIRE_GPIO_INPUT_PULLUP ||
+         mode == VWIRE_GPIO_ANALOG_INPUT || _isPulseMode(mode);
+}
+
+unsigned long VwireGPIO::_nextDue(const VwireGPIOPin& p, unsigned long now) const {
+  // Looked at least this often, so nothing can be missed through a bad estimate
+  unsigned long due = now + VWIRE_GPIO_MAX_READ_INTERVAL;
+
+  bool edge = p.irq != 0xFF && !_isPulseMode(p.mode);
+  if (!edge) {
+    if (p.filter != 0xFF && p.mode == VWIRE_GPIO_ANALOG_INPUT) {
+      const VwireAnalogSampler& s = _filters[p.filter];
+      if (s.taken > 0 && s.taken < s.filter.oversample) {
+        _vwireEarliest(due, p.lastRead + s.taken * (p.readInterval / s.filter.oversample));
+      }
+    }
+    _vwireEarliest(due, p.lastRead + p.readInterval);
+  }
+
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  if (p.gate.hasSent) {
+    if (p.gate.pending) {
+      _vwireEarliest(due, p.gate.sentAt + p.gate.policy.minInterval);
+    } else if (p.gate.policy.maxInterval > 0) {
+      _vwireEarliest(due, p.gate.sentAt + p.gate.policy.maxInterval);
+    }
+  }
+  #endif
+
+  // Work that is already due runs on the next onRun(), not again in this one
+  if ((long)(due - now) <= 0) due = now + 1;
+  return due;
+}
+
+void VwireGPIO::_unschedule(uint8_t slot) {
+  for (uint8_t i = 0; i < _inputCount; i++) {
+    if (_inputs[i] != slot) continue;
+    memmove(&_inputs[i], &_inputs[i + 1], _inputCount - i - 1);
+    _inputCount--;
+    return;
+  }
+}
+
+void VwireGPIO::_schedule(uint8_t slot, unsigned long now) {
+  _unschedule(slot);
+  VwireGPIOPin& p = _pins[slot];
+  if (!p.active || !_isInputMode(p.mode)) return;
+
+  p.dueAt = _nextDue(p, now);
+  uint8_t pos = _inputCount;
+  while (pos > 0 && (long)(_pins[_inputs[pos - 1]].dueAt - p.dueAt) > 0) {
+    _inputs[pos] = _inputs[pos - 1];
+    pos--;
+  }
+  _inputs[pos] = slot;
+  _inputCount++;
+}
+
+void VwireGPIO::_reportInput(VwireGPIOPin& p, int value, unsigned long now) {
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  p.lastValue = value;
+  if (p.gate.offer(true, value, 0, now) == VWIRE_POLICY_SEND) {
+    _publishValue(p.pinName, value);
+  }
+  #else
+  (void)now;
+  if (value != p.lastValue) {
+    p.lastValue = value;
+    _publishValue(p.pinName, value);
+  }
+  #endif
+}
+
+void VwireGPIO::_reportCount(VwireGPIOPin& p, uint32_t total, unsigned long now) {
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  p.lastValue = (int32_t)total;     // getPinValue() view; published unsigned
+  if (p.gate.offerCount(total, now) == VWIRE_POLICY_SEND) {
+    _publishCount(p.pinName, total);
+  }
+  #else
+  (void)now;
+  if ((int32_t)total != p.lastValue) {
+    p.lastValue = (int32_t)total;
+    _publishCount(p.pinName, total);
+  }
+  #endif
+}
+
+// =============================================================================
+// EDGE INTERRUPTS
+// =============================================================================
+
+#ifndef IRAM_ATTR
+  #define IRAM_ATTR
+#endif
+
+#if VWIRE_GPIO_MAX_INTERRUPTS > 8
+  #error "VWIRE_GPIO_MAX_INTERRUPTS supports at most 8 pins"
+#endif
+
+// Single-producer / single-consumer ring: only the ISRs advance head and
+// only onRun() advances tail, so neither side needs a lock.
+struct VwireEdgeEvent {
+  uint8_t slot;
+  uint8_t level;
+};
+
+static volatile VwireEdgeEvent _vwireEdgeRing[VWIRE_GPIO_EDGE_QUEUE];
+static volatile uint8_t _vwireEdgeHead = 0;
+static volatile uint8_t _vwireEdgeTail = 0;
+static volatile bool _vwireEdgeOverflow = false;
+
+// Per interrupt slot, written by setEdgeTrigger() and the ISR
+static volatile uint8_t _vwireEdgeGpio[VWIRE_GPIO_MAX_INTERRUPTS];
+static volatile uint16_t _vwireEdgeDebounceMs[VWIRE_GPIO_MAX_INTERRUPTS];
+static volatile uint32_t _vwireEdgeLastMs[VWIRE_GPIO_MAX_INTERRUPTS];   ///< Last accepted edge
+static volatile uint32_t _vwirePulseCount[VWIRE_GPIO_MAX_INTERRUPTS];  ///< COUNTER / FREQUENCY pins
+
+static void IRAM_ATTR _vwireEdgeIsr(uint8_t slot) {
+  uint32_t now = millis();
+  if (now - _vwireEdgeLastMs[slot] < _vwireEdgeDebounceMs[slot]) return;   // Bounce
+  _vwireEdgeLastMs[slot] = now;
+
+  uint8_t head = _vwireEdgeHead;
+  uint8_t next = (head + 1) & (VWIRE_GPIO_EDGE_QUEUE - 1);
+  if (next == _vwireEdgeTail) {
+    _vwireEdgeOverflow = true;
+    return;
+  }
+  _vwireEdgeRing[head].slot = slot;
+  _vwireEdgeRing[head].level = (uint8_t)digitalRead(_vwireEdgeGpio[slot]);
+  _vwireEdgeHead = next;          // Hand the event over only once it is written
+}
+
+// attachInterrupt() takes no argument on every core, so one trampoline per slot
+#define VWIRE_EDGE_ISR(n) \
+  static void IRAM_ATTR _vwireEdgeIsr##n() { _vwireEdgeIsr(n); } \
+  static void IRAM_ATTR _vwirePulseIsr##n() { _vwirePulseCount[n]++; }
+VWIRE_EDGE_ISR(0) VWIRE_EDGE_ISR(1) VWIRE_EDGE_ISR(2) VWIRE_EDGE_ISR(3)
+VWIRE_EDGE_ISR(4) VWIRE_EDGE_ISR(5) VWIRE_EDGE_ISR(6) VWIRE_EDGE_ISR(7)
+
+static void (* const _vwireEdgeIsrs[8])() = {
+  _vwireEdgeIsr0, _vwireEdgeIsr1, _vwireEdgeIsr2, _vwireEdgeIsr3,
+  _vwireEdgeIsr4, _vwireEdgeIsr5, _vwireEdgeIsr6, _vwireEdgeIsr7
+};
+
+static void (* const _vwirePulseIsrs[8])() = {
+  _vwirePulseIsr0, _vwirePulseIsr1, _vwirePulseIsr2, _vwirePulseIsr3,
+  _vwirePulseIsr4, _vwirePulseIsr5, _vwirePulseIsr6, _vwirePulseIsr7
+};
+
+bool VwireGPIO::setEdgeTrigger(const char* pinName, bool enable, uint16_t debounceMs) {
+  int idx = _findPin(pinName);
+  if (idx < 0) return false;
+  VwireGPIOPin& p = _pins[idx];
+
+  if (p.mode != VWIRE_GPIO_INPUT && p.mode != VWIRE_GPIO_INPUT_PULLUP) return false;
+
+  if (!enable) {
+    _releaseIrq(p);
+    _schedule((uint8_t)idx, millis());
+    return true;
+  }
+
+  if (p.irq == 0xFF) {
+    if (!_claimIrq(p)) return false;
+  } else {
+    _detachIrq(p);
+  }
+
+  _vwireEdgeDebounceMs[p.irq] = debounceMs;
+  _attachEdge(p);
+  _schedule((uint8_t)idx, millis());
+  return true;
+}
+
+bool VwireGPIO::_claimIrq(VwireGPIOPin& p) {
+  for (uint8_t i = 0; i < VWIRE_GPIO_MAX_INTERRUPTS; i++) {
+    if (_irqOwner[i] == 0xFF) {
+      _irqOwner[i] = (uint8_t)(&p - _pins);
+      p.irq = i;
+      return true;
+    }
+  }
+  VWIRE_LOGF("[Vwire] Error: no GPIO interrupt slot for %s (max %d)",
+             p.pinName, VWIRE_GPIO_MAX_INTERRUPTS);
+  return false;
+}
+
+void VwireGPIO::_attachEdge(VwireGPIOPin& p) {
+  _vwireEdgeGpio[p.irq] = p.gpioNumber;
+  _vwireEdgeLastMs[p.irq] = millis() - _vwireEdgeDebounceMs[p.irq];
+  _irqSettle |= (uint8_t)(1 << p.irq);      // Report the current level once
+  attachInterrupt(digitalPinToInterrupt(p.gpioNumber), _vwireEdgeIsrs[p.irq], CHANGE);
+}
+
+void VwireGPIO::_detachIrq(VwireGPIOPin& p) {
+  #if VWIRE_GPIO_HAS_PCNT
+  VwireGPIOCounter& c = _counters[p.irq];
+  if (c.unit) {
+    pcnt_unit_handle_t unit = static_cast<pcnt_unit_handle_t>(c.unit);
+    pcnt_unit_stop(unit);
+    pcnt_unit_disable(unit);
+    if (c.channel) pcnt_del_channel(static_cast<pcnt_channel_handle_t>(c.channel));
+    pcnt_del_unit(unit);
+    c.unit = nullptr;
+    c.channel = nullptr;
+    return;
+  }
+  #endif
+  detachInterrupt(digitalPinToInterrupt(_vwireEdgeGpio[p.irq]));
+}
+
+void VwireGPIO::_releaseIrq(VwireGPIOPin& p) {
+  if (p.irq == 0xFF) return;
+  _detachIrq(p);
+  _irqOwner[p.irq] = 0xFF;
+  _irqSettle &= (uint8_t)~(1 << p.irq);
+  p.irq = 0xFF;
+}
+
+void VwireGPIO::_drainEdges(unsigned long now) {
+  while (_vwireEdgeTail != _vwireEdgeHead) {
+    uint8_t tail = _vwireEdgeTail;
+    uint8_t slot = _vwireEdgeRing[tail].slot;
+    int level = _vwireEdgeRing[tail].level;
+    _vwireEdgeTail = (tail + 1) & (VWIRE_GPIO_EDGE_QUEUE - 1);
+
+    if (_irqOwner[slot] == 0xFF) continue;    // Released since
+    VwireGPIOPin& p = _pins[_irqOwner[slot]];
+    _irqSettle |= (uint8_t)(1 << slot);
+    if (level != p.lastValue) {
+      _reportInput(p, level, now);
+      _schedule(_irqOwner[slot], now);        // The publish policy may now hold a value
+    }
+  }
 
-    bool isInput = (p.mode == VWIRE_GPIO_INPUT ||
-                    p.mode == VWIRE_GPIO_INPUT_PULLUP ||
-                    p.mode == VWIRE_GPIO_ANALOG_INPUT);
-    if (!isInput) continue;
+  if (_vwireEdgeOverflow) {
+    _vwireEdgeOverflow = false;               // Edges were lost: re-read every level
+    for (uint8_t i = 0; i < VWIRE_GPIO_MAX_INTERRUPTS; i++) {
+      if (_irqOwner[i] != 0xFF && !_isPulseMode(_pins[_irqOwner[i]].mode)) {
+        _irqSettle |= (uint8_t)(1 << i);
+      }
+    }
+  }
+
+  // Once a pin is quiet for its debounce time, its level is final
+  for (uint8_t i = 0; _irqSettle && i < VWIRE_GPIO_MAX_INTERRUPTS; i++) {
+    if (!(_irqSettle & (1 << i))) continue;
+    if (now - _vwireEdgeLastMs[i] < _vwireEdgeDebounceMs[i]) continue;
+    _irqSettle &= (uint8_t)~(1 << i);
+
+    VwireGPIOPin& p = _pins[_irqOwner[i]];
+    int level = digitalRead(p.gpioNumber);
+    if (level != p.lastValue) {
+      _reportInput(p, level, now);
+      _schedule(_irqOwner[i], now);
+    }
+  }
+}
+
+// =============================================================================
+// PULSE COUNTING
+// =============================================================================
+
+bool VwireGPIO::_isPulseMode(VwireGPIOMode mode) {
+  return mode == VWIRE_GPIO_COUNTER || mode == VWIRE_GPIO_FREQUENCY;
+}
+
+void VwireGPIO::_attachCounter(VwireGPIOPin& p) {
+  VwireGPIOCounter& c = _counters[p.irq];
+  c.total = 0;
+  c.hz = 0;
+  c.since = millis();
+  p.lastRead = c.since;               // First reading after a full interval
+  _vwireEdgeGpio[p.irq] = p.gpioNumber;
+
+  #if VWIRE_GPIO_HAS_PCNT
+  // Count rising edges in hardware; accum_count extends the 16-bit counter
+  // past its limit through the watch point
+  pcnt_unit_config_t unitConfig = {};
+  unitConfig.low_limit = -1;
+  unitConfig.high_limit = 32767;
+  unitConfig.flags.accum_count = 1;
+  pcnt_chan_config_t chanConfig = {};
+  chanConfig.edge_gpio_num = p.gpioNumber;
+  chanConfig.level_gpio_num = -1;
+  pcnt_glitch_filter_config_t filterConfig = {};
+  filterConfig.max_glitch_ns = VWIRE_GPIO_PCNT_GLITCH_NS;
+
+  pcnt_unit_handle_t unit = nullptr;
+  pcnt_channel_handle_t channel = nullptr;
+  if (pcnt_new_unit(&unitConfig, &unit) == ESP_OK) {
+    c.unit = unit;
+    if (pcnt_new_channel(unit, &chanConfig, &channel) == ESP_OK) {
+      c.channel = channel;
+    }
+    if (channel &&
+        pcnt_channel_set_edge_action(channel, PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                     PCNT_CHANNEL_EDGE_ACTION_HOLD) == ESP_OK &&
+        pcnt_unit_set_glitch_filter(unit, &filterConfig) == ESP_OK &&
+        pcnt_unit_add_watch_point(unit, unitConfig.high_limit) == ESP_OK &&
+        pcnt_unit_enable(unit) == ESP_OK &&
+        pcnt_unit_clear_count(unit) == ESP_OK &&
+        pcnt_unit_start(unit) == ESP_OK) {
+      c.lastRaw = 0;
+      return;
+    }
+    _detachIrq(p);                    // Releases the unit; fall back to the ISR
+  }
+  VWIRE_LOGF("[Vwire] No PCNT unit for %s, counting in an interrupt", p.pinName);
+  #endif
+
+  c.lastRaw = _vwirePulseCount[p.irq];
+  attachInterrupt(digitalPinToInterrupt(p.gpioNumber), _vwirePulseIsrs[p.irq], RISING);
+}
+
+uint32_t VwireGPIO::_counterRaw(const VwireGPIOPin& p) const {
+  #if VWIRE_GPIO_HAS_PCNT
+  const VwireGPIOCounter& c = _counters[p.irq];
+  if (c.unit) {
+    int count = 0;
+    pcnt_unit_get_count(static_cast<pcnt_unit_handle_t>(c.unit), &count);
+    return (uint32_t)count;
+  }
+  #endif
+  return _vwirePulseCount[p.irq];
+}
+
+void VwireGPIO::_readCounter(VwireGPIOPin& p, unsigned long now) {
+  VwireGPIOCounter& c = _counters[p.irq];
+  uint32_t raw = _counterRaw(p);
+  uint32_t pulses = raw - c.lastRaw;
+  unsigned long elapsed = now - c.since;
+  c.lastRaw = raw;
+  c.since = now;
+  c.total += pulses;
+
+  if (p.mode == VWIRE_GPIO_COUNTER) {
+    _reportCount(p, c.total, now);
+    return;
+  }
+
+  #if !VWIRE_ENABLE_PUBLISH_POLICY
+  uint32_t previousCentiHz = (uint32_t)(c.hz * 100 + 0.5f);
+  bool first = p.lastValue == -32768;
+  #endif
+
+  c.hz = elapsed > 0 ? pulses * 1000.0f / elapsed : 0;
+  p.lastValue = (int32_t)(c.hz + 0.5f);
+
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  if (p.gate.offer(true, c.hz, 0, now) == VWIRE_POLICY_SEND) {
+    _publishFrequency(p.pinName, c.hz);
+  }
+  #else
+  if (first || (uint32_t)(c.hz * 100 + 0.5f) != previousCentiHz) {
+    _publishFrequency(p.pinName, c.hz);
+  }
+  #endif
+}
+
+void VwireGPIO::_publishFrequency(const char* pinName, float hz) {
+  if (!_vwire) return;
 
-    if (now - p.lastRead < p.readInterval) continue;
+  char topic[96];
+  _vwire->_topic(topic, sizeof(topic), "pin/", pinName);
+
+  uint32_t centiHz = (uint32_t)(hz * 100 + 0.5f);
+  char valStr[16];
+  snprintf(valStr, sizeof(valStr), "%lu.%02lu",
+           (unsigned long)(centiHz / 100), (unsigned long)(centiHz % 100));
+
+  _vwire->publish(topic, valStr);
+}
+
+uint32_t VwireGPIO::getPulseCount(const char* pinName) const {
+  int idx = _findPin(pinName);
+  if (idx < 0 || !_isPulseMode(_pins[idx].mode) || _pins[idx].irq == 0xFF) return 0;
+  const VwireGPIOCounter& c = _counters[_pins[idx].irq];
+  return c.total + (_counterRaw(_pins[idx]) - c.lastRaw);
+}
+
+float VwireGPIO::getFrequency(const char* pinName) const {
+  int idx = _findPin(pinName);
+  if (idx < 0 || !_isPulseMode(_pins[idx].mode) || _pins[idx].irq == 0xFF) return 0;
+  return _counters[_pins[idx].irq].hz;
+}
+
+bool VwireGPIO::resetPulseCount(const char* pinName) {
+  int idx = _findPin(pinName);
+  if (idx < 0 || !_isPulseMode(_pins[idx].mode) || _pins[idx].irq == 0xFF) return false;
+  VwireGPIOCounter& c = _counters[_pins[idx].irq];
+  c.lastRaw = _counterRaw(_pins[idx]);
+  c.total = 0;
+  return true;
+}
+
+// =============================================================================
+// ANALOG FILTERING
+// =============================================================================
+
+bool VwireGPIO::_sampleFiltered(VwireGPIOPin& p, unsigned long now, int& value) {
+  VwireAnalogSampler& s = _filters[p.filter];
+  uint8_t samples = s.filter.oversample;
+  bool ready = false;
+
+  if (now - p.lastRead >= p.readInterval) {
+    // A slow loop may not have finished the last reading: use what it got
+    if (s.taken > 0) {
+      value = s.finish();
+      ready = true;
+    }
     p.lastRead = now;
+    s.addSample(_readHardware(p));
+  } else if (s.taken > 0) {
+    // Spread the remaining samples evenly over the interval
+    unsigned long period = p.readInterval / samples;
+    for (uint8_t burst = 0; burst < VWIRE_GPIO_SAMPLE_BURST && s.taken < samples &&
+         now - p.lastRead >= s.taken * period; burst++) {
+      s.addSample(_readHardware(p));
+    }
+  }
+
+  if (!ready && s.taken >= samples) {
+    value = s.finish();
+    ready = true;
+  }
+  return ready;
+}
+
+void VwireGPIO::_releaseFilter(VwireGPIOPin& p) {
+  if (p.filter == 0xFF) return;
+  _filters[p.filter].used = false;
+  p.filter = 0xFF;
+}
+
+bool VwireGPIO::setAnalogFilter(const char* pinName, const VwireAnalogFilter& filter) {
+  int idx = _findPin(pinName);
+  if (idx < 0) return false;
+  VwireGPIOPin& p = _pins[idx];
+  if (p.mode != VWIRE_GPIO_ANALOG_INPUT) return false;
+
+  VwireAnalogFilter settings = filter;
+  settings.clamp();
+  if (!settings.enabled()) {
+    _releaseFilter(p);
+    _schedule((uint8_t)idx, millis());
+    return true;
+  }
+
+  if (p.filter == 0xFF) {
+    for (uint8_t i = 0; i < VWIRE_GPIO_MAX_FILTERS; i++) {
+      if (!_filters[i].used) {
+        _filters[i].used = true;
+        p.filter = i;
+        break;
+      }
+    }
+    if (p.filter == 0xFF) {
+      VWIRE_LOGF("[Vwire] Error: no GPIO filter slot for %s (max %d)", p.pinName, VWIRE_GPIO_MAX_FILTERS);
+      return false;
+    }
+  }
 
-    int value = _readHardware(p);
+  VwireAnalogSampler& s = _filters[p.filter];
+  s.filter = settings;
+  s.reset();
+  _schedule((uint8_t)idx, millis());
+  return true;
+}
+
+#if VWIRE_GPIO_HAS_CONTINUOUS_ADC
 
-    if (value != p.lastValue) {
-      p.lastValue = value;
-      _publishValue(p.pinName, value);
+bool VwireGPIO::setContinuousAdc(bool enable, uint32_t sampleRateHz) {
+  _adcRate = enable ? sampleRateHz : 0;
+  _adcDirty = true;
+  if (!enable && _adcRunning) {
+    _startContinuousAdc();            // Stops the driver
+  }
+  return true;
+}
+
+void VwireGPIO::_startContinuousAdc() {
+  _adcDirty = false;
+  if (_adcRunning) {
+    analogContinuousStop();
+    analogContinuousDeinit();
+    _adcRunning = false;
+  }
+
+  uint8_t gpios[VWIRE_MAX_GPIO_PINS];
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
+    _pins[i].adcRaw = -1;
+    if (_pins[i].active && _pins[i].mode == VWIRE_GPIO_ANALOG_INPUT) {
+      gpios[n++] = _pins[i].gpioNumber;
     }
   }
+  _adcCount = n;
+  if (_adcRate == 0 || n == 0) return;
+
+  if (!analogContinuous(gpios, n, VWIRE_GPIO_ADC_CONVERSIONS, _adcRate, nullptr) ||
+      !analogContinuousStart()) {
+    analogContinuousDeinit();
+    VWIRE_LOG("[Vwire] Continuous ADC unavailable, using analogRead()");
+    return;
+  }
+  _adcRunning = true;
 }
 
+void VwireGPIO::_pollContinuousAdc() {
+  if (_adcDirty) _startContinuousAdc();
+  if (!_adcRunning) return;
+
+  adc_continuous_data_t* data = nullptr;
+  if (!analogContinuousRead(&data, 0) || !data) return;
+
+  for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
+    VwireGPIOPin& p = _pins[i];
+    if (!p.active || p.mode != VWIRE_GPIO_ANALOG_INPUT) continue;
+    for (uint8_t j = 0; j < _adcCount; j++) {
+      if (data[j].pin == p.gpioNumber) {
+        p.adcRaw = (int16_t)data[j].avg_read_raw;
+        break;
+      }
+    }
+  }
+}
+
+#else
+
+bool VwireGPIO::setContinuousAdc(bool enable, uint32_t sampleRateHz) {
+  (void)sampleRateHz;
+  return !enable;
+}
+
+#endif // VWIRE_GPIO_HAS_CONTINUOUS_ADC
+
 // =============================================================================
 // PIN CONFIGURATION
 // =============================================================================
@@ -194,7 +813,31 @@ int VwireGPIO::_applyConfig(const char* jsonPayload) {
     uint16_t interval = pinObj["interval"] | 0;
     VwireGPIOMode mode = _parseMode(modeStr);
     if (mode == VWIRE_GPIO_DISABLED) continue;
-    if (addPin(pinName, mode, interval)) configured++;
+    if (!addPin(pinName, mode, interval)) continue;
+    configured++;
+
+    #if VWIRE_ENABLE_PUBLISH_POLICY
+    if (pinObj.containsKey("deadband") || pinObj.containsKey("minInterval") ||
+        pinObj.containsKey("maxInterval")) {
+      setPublishPolicy(pinName, VwirePublishPolicy(pinObj["deadband"] | 0.0f,
+                                                   pinObj["minInterval"] | 0UL,
+                                                   pinObj["maxInterval"] | 0UL,
+                                                   pinObj["percent"] | false));
+    }
+    #endif
+
+    if (pinObj.containsKey("oversample") || pinObj.containsKey("median") ||
+        pinObj.containsKey("average") || pinObj.containsKey("ema")) {
+      setAnalogFilter(pinName, VwireAnalogFilter::clamped(pinObj["oversample"] | 1,
+                                                          pinObj["median"] | 1,
+                                                          pinObj["average"] | 1,
+                                                          pinObj["ema"] | 0.0f));
+    }
+
+    if (pinObj.containsKey("interrupt")) {
+      setEdgeTrigger(pinName, pinObj["interrupt"] | false,
+                     pinObj["debounce"] | VWIRE_GPIO_DEBOUNCE_MS);
+    }
   }
   return configured;
 }
@@ -213,9 +856,20 @@ bool VwireGPIO::addPin(const char* pinName, uint8_t gpioNumber,
     idx = _findFreeSlot();
     if (idx < 0) return false;
     _count++;
+    #if VWIRE_ENABLE_PUBLISH_POLICY
+    _pins[idx].gate.policy = VwirePublishPolicy();   // Reconfiguring keeps the policy
+    #endif
+    _pins[idx].filter = 0xFF;
+    _pins[idx].irq = 0xFF;
+    int key = _nameKey(pinName);
+    if (key >= 0) _nameIndex[key] = (uint8_t)idx;
   }
 
   VwireGPIOPin& p = _pins[idx];
+  bool wasEdge = p.irq != 0xFF && !_isPulseMode(p.mode);
+  if (p.irq != 0xFF) {
+    _detachIrq(p);                                  // Before the GPIO number changes
+  }
   strncpy(p.pinName, pinName, sizeof(p.pinName) - 1);
   p.pinName[sizeof(p.pinName) - 1] = '\0';
   for (char* c = p.pinName; *c; c++) *c = toupper(*c);
@@ -226,6 +880,20 @@ bool VwireGPIO::addPin(const char* pinName, uint8_t gpioNumber,
   p.lastValue = -32768;
   p.lastRead = 0;
   p.flags = 0;
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  p.gate.reset();
+  #endif
+  if (p.filter != 0xFF) {
+    if (mode == VWIRE_GPIO_ANALOG_INPUT) {
+      _filters[p.filter].reset();                   // Reconfiguring keeps the filter
+    } else {
+      _releaseFilter(p);
+    }
+  }
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  p.adcRaw = -1;
+  _adcDirty = _adcRate > 0;
+  #endif
 
   if (readInterval == 0) {
     p.readInterval = VWIRE_GPIO_READ_INTERVAL;
@@ -238,6 +906,24 @@ bool VwireGPIO::addPin(const char* pinName, uint8_t gpioNumber,
   }
 
   _applyHardwareMode(p);
+
+  if (_isPulseMode(mode)) {
+    if (p.irq == 0xFF && !_claimIrq(p)) {
+      removePin(p.pinName);                         // No half-configured pin left behind
+      return false;
+    }
+    _attachCounter(p);
+  } else if (p.irq != 0xFF) {
+    if (wasEdge && (mode == VWIRE_GPIO_INPUT || mode == VWIRE_GPIO_INPUT_PULLUP)) {
+      _attachEdge(p);                               // Reconfiguring keeps edge triggering
+    } else {
+      _irqOwner[p.irq] = 0xFF;                      // Already detached above
+      _irqSettle &= (uint8_t)~(1 << p.irq);
+      p.irq = 0xFF;
+    }
+  }
+
+  _schedule((uint8_t)idx, millis());
   return true;
 }
 
@@ -245,15 +931,30 @@ bool VwireGPIO::removePin(const char* pinName) {
   int idx = _findPin(pinName);
   if (idx < 0) return false;
   _pins[idx].active = false;
+  _releaseFilter(_pins[idx]);
+  _releaseIrq(_pins[idx]);
+  _unschedule((uint8_t)idx);
+  int key = _nameKey(_pins[idx].pinName);
+  if (key >= 0) _nameIndex[key] = 0xFF;
   _count--;
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  _adcDirty = _adcRate > 0;
+  #endif
   return true;
 }
 
 void VwireGPIO::clearAll() {
   for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
     _pins[i].active = false;
+    _releaseFilter(_pins[i]);
+    _releaseIrq(_pins[i]);
   }
   _count = 0;
+  _inputCount = 0;
+  memset(_nameIndex, 0xFF, sizeof(_nameIndex));
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  _adcDirty = _adcRate > 0;
+  #endif
 }
 
 // =============================================================================
@@ -275,6 +976,19 @@ void VwireGPIO::send(const char* pinName, int value) {
   _publishValue(pinName, value);
 }
 
+bool VwireGPIO::setPublishPolicy(const char* pinName, const VwirePublishPolicy& policy) {
+  int idx = _findPin(pinName);
+  if (idx < 0) return false;
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  _pins[idx].gate.policy = policy;
+  _schedule((uint8_t)idx, millis());
+  return true;
+  #else
+  (void)policy;
+  return false;
+  #endif
+}
+
 bool VwireGPIO::handleCommand(const char* pinName, int value) {
   int idx = _findPin(pinName);
   if (idx < 0) return false;
@@ -313,8 +1027,7 @@ void VwireGPIO::_publishValue(const char* pinName, int value) {
   if (!_vwire) return;
 
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/pin/%s",
-           _vwire->getDeviceId(), pinName);
+  _vwire->_topic(topic, sizeof(topic), "pin/", pinName);
 
   char valStr[16];
   snprintf(valStr, sizeof(valStr), "%d", value);
@@ -322,21 +1035,56 @@ void VwireGPIO::_publishValue(const char* pinName, int value) {
   _vwire->publish(topic, valStr);
 }
 
+void VwireGPIO::_publishCount(const char* pinName, uint32_t total) {
+  if (!_vwire) return;
+
+  char topic[96];
+  _vwire->_topic(topic, sizeof(topic), "pin/", pinName);
+
+  char valStr[16];
+  snprintf(valStr, sizeof(valStr), "%lu", (unsigned long)total);
+
+  _vwire->publish(topic, valStr);
+}
+
 // =============================================================================
 // PRIVATE HELPERS
 // =============================================================================
 
+int VwireGPIO::_nameKey(const char* pinName) {
+  if (!pinName) return -1;
+  char prefix = toupper((unsigned char)pinName[0]);
+  const char* digits = pinName + 1;
+  if (!isdigit((unsigned char)digits[0])) return -1;
+  if (digits[0] == '0' && digits[1] != '\0') return -1;     // "D05" is not "D5"
+
+  int num = 0;
+  for (const char* c = digits; *c; c++) {
+    if (!isdigit((unsigned char)*c) || num > 999) return -1;
+    num = num * 10 + (*c - '0');
+  }
+
+  if (prefix == 'D' && num < VWIRE_GPIO_DIGITAL_NAMES) return num;
+  if (prefix == 'A' && num < VWIRE_GPIO_ANALOG_NAMES) return VWIRE_GPIO_DIGITAL_NAMES + num;
+  return -1;
+}
+
 int VwireGPIO::_findPin(const char* pinName) const {
+  if (!pinName) return -1;
+  int key = _nameKey(pinName);
+  if (key >= 0) {
+    return _nameIndex[key] == 0xFF ? -1 : _nameIndex[key];
+  }
+
+  // Names without a lookup entry; stored names are already uppercase
   for (uint8_t i = 0; i < VWIRE_MAX_GPIO_PINS; i++) {
     if (!_pins[i].active) continue;
     const char* a = _pins[i].pinName;
     const char* b = pinName;
-    bool match = true;
-    while (*a && *b) {
-      if (toupper(*a) != toupper(*b)) { match = false; break; }
+    while (*a && *a == toupper((unsigned char)*b)) {
       a++; b++;
     }
-    if (match && *a == '\0' && *b == '\0') return i;
+    if (*a == '\0' && *b == '\0') return i;
   }
   return -1;
 }
@@ -355,6 +1103,8 @@ VwireGPIOMode VwireGPIO::_parseMode(const char* modeStr) {
   if (strcasecmp(modeStr, "INPUT_PULLUP") == 0) return VWIRE_GPIO_INPUT_PULLUP;
   if (strcasecmp(modeStr, "PWM") == 0)          return VWIRE_GPIO_PWM;
   if (strcasecmp(modeStr, "ANALOG_INPUT") == 0) return VWIRE_GPIO_ANALOG_INPUT;
+  if (strcasecmp(modeStr, "COUNTER") == 0)      return VWIRE_GPIO_COUNTER;
+  if (strcasecmp(modeStr, "FREQUENCY") == 0)    return VWIRE_GPIO_FREQUENCY;
   return VWIRE_GPIO_DISABLED;
 }
 
@@ -407,6 +1157,8 @@ void VwireGPIO::_applyHardwareMode(VwireGPIOPin& pin) {
       pinMode(pin.gpioNumber, INPUT);
       break;
     case VWIRE_GPIO_INPUT_PULLUP:
+    case VWIRE_GPIO_COUNTER:            // S0 and flow sensor outputs are open collector
+    case VWIRE_GPIO_FREQUENCY:
       pinMode(pin.gpioNumber, INPUT_PULLUP);
       break;
     case VWIRE_GPIO_ANALOG_INPUT:
@@ -423,6 +1175,9 @@ void VwireGPIO::_applyHardwareMode(VwireGPIOPin& pin) {
 
 int VwireGPIO::_readHardware(const VwireGPIOPin& pin) const {
   if (pin.mode == VWIRE_GPIO_ANALOG_INPUT) {
+    #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+    if (_adcRunning && pin.adcRaw >= 0) return pin.adcRaw;
+    #endif
     return analogRead(pin.gpioNumber);
   }
   return digitalRead(pin.gpioNumber);
@@ -529,6 +1284,40 @@ uint8_t VwireClass::getGPIOPinCount() const {
   return 0;
 }
 
+bool VwireClass::setGPIOPublishPolicy(const char* pinName, const VwirePublishPolicy& policy) {
+  (void)pinName;
+  (void)policy;
+  return false;
+}
+
+bool VwireClass::setGPIOAnalogFilter(const char* pinName, const VwireAnalogFilter& filter) {
+  (void)pinName;
+  (void)filter;
+  return false;
+}
+
+bool VwireClass::setGPIOEdgeTrigger(const char* pinName, bool enable, uint16_t debounceMs) {
+  (void)pinName;
+  (void)enable;
+  (void)debounceMs;
+  return false;
+}
+
+uint32_t VwireClass::getGPIOPulseCount(const char* pinName) const {
+  (void)pinName;
+  return 0;
+}
+
+float VwireClass::getGPIOFrequency(const char* pinName) const {
+  (void)pinName;
+  return 0;
+}
+
+bool VwireClass::resetGPIOPulseCount(const char* pinName) {
+  (void)pinName;
+  return false;
+}
+
 VwireGPIO::VwireGPIO() : _vwire(nullptr), _count(0) {}
 
 void VwireGPIO::begin(VwireClass& vwire) {
@@ -574,6 +1363,46 @@ void VwireGPIO::send(const char* pinName, int value) {
   (void)value;
 }
 
+bool VwireGPIO::setPublishPolicy(const char* pinName, const VwirePublishPolicy& policy) {
+  (void)pinName;
+  (void)policy;
+  return false;
+}
+
+bool VwireGPIO::setAnalogFilter(const char* pinName, const VwireAnalogFilter& filter) {
+  (void)pinName;
+  (void)filter;
+  return false;
+}
+
+bool VwireGPIO::setContinuousAdc(bool enable, uint32_t sampleRateHz) {
+  (void)enable;
+  (void)sampleRateHz;
+  return false;
+}
+
+bool VwireGPIO::setEdgeTrigger(const char* pinName, bool enable, uint16_t debounceMs) {
+  (void)pinName;
+  (void)enable;
+  (void)debounceMs;
+  return false;
+}
+
+uint32_t VwireGPIO::getPulseCount(const char* pinName) const {
+  (void)pinName;
+  return 0;
+}
+
+float VwireGPIO::getFrequency(const char* pinName) const {
+  (void)pinName;
+  return 0;
+}
+
+bool VwireGPIO::resetPulseCount(const char* pinName) {
+  (void)pinName;
+  return false;
+}
+
 uint8_t VwireGPIO::getPinCount() const {
   return 0;
 }
@@ -594,9 +1423,8 @@ void VwireGPIO::onAttach(VwireClass& vwire) {
 
 void VwireGPIO::onConnect() {}
 
-bool VwireGPIO::onMessage(const char* topic, const char* payload) {
-  (void)topic;
-  (void)payload;
+bool VwireGPIO::onMessage(const VwireMessage& message) {
+  (void)message;
   return false;
 }
 
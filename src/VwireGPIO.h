@@ -36,6 +36,8 @@
 
 #include <Arduino.h>
 #include "VwireConfig.h"
+#include "VwirePublishPolicy.h"
+#include "VwireAnalogFilter.h"
 
 // Forward declaration (full definition in Vwire.h)
 class VwireClass;
@@ -66,13 +68,83 @@ class VwireClass;
 /** @brief Maximum allowed read interval (ms) */
 #define VWIRE_GPIO_MAX_READ_INTERVAL 60000
 
+/** @brief Dx names with a direct lookup entry (D0 .. D<n-1>) */
+#ifndef VWIRE_GPIO_DIGITAL_NAMES
+  #define VWIRE_GPIO_DIGITAL_NAMES 100
+#endif
+
+/** @brief Ax names with a direct lookup entry (A0 .. A<n-1>) */
+#ifndef VWIRE_GPIO_ANALOG_NAMES
+  #define VWIRE_GPIO_ANALOG_NAMES 16
+#endif
+
+/** @brief Analog pins that can have a filter at the same time */
+#ifndef VWIRE_GPIO_MAX_FILTERS
+  #if defined(VWIRE_BOARD_ESP32)
+    #define VWIRE_GPIO_MAX_FILTERS 8
+  #elif defined(VWIRE_BOARD_ESP8266)
+    #define VWIRE_GPIO_MAX_FILTERS 1      // A0 is the only analog input
+  #else
+    #define VWIRE_GPIO_MAX_FILTERS 4
+  #endif
+#endif
+
+/** @brief Most oversampling reads one pin takes per onRun() when catching up */
+#ifndef VWIRE_GPIO_SAMPLE_BURST
+  #define VWIRE_GPIO_SAMPLE_BURST 4
+#endif
+
+/** @brief Digital inputs that can be edge-triggered at the same time (max 8) */
+#ifndef VWIRE_GPIO_MAX_INTERRUPTS
+  #define VWIRE_GPIO_MAX_INTERRUPTS 8
+#endif
+
+/** @brief Edge events buffered between onRun() calls (power of two) */
+#ifndef VWIRE_GPIO_EDGE_QUEUE
+  #define VWIRE_GPIO_EDGE_QUEUE 32
+#endif
+
+/** @brief Continuous (DMA) ADC driver available (ESP32, Arduino core 3.x) */
+#if defined(VWIRE_BOARD_ESP32) && defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  #define VWIRE_GPIO_HAS_CONTINUOUS_ADC 1
+#else
+  #define VWIRE_GPIO_HAS_CONTINUOUS_ADC 0
+#endif
+
+/** @brief PCNT pulse counter peripheral available (ESP32, Arduino core 3.x) */
+#if defined(VWIRE_BOARD_ESP32) && defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+  #include <soc/soc_caps.h>
+#endif
+#if defined(VWIRE_BOARD_ESP32) && defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3 && \
+    defined(SOC_PCNT_SUPPORTED) && SOC_PCNT_SUPPORTED && !defined(VWIRE_GPIO_DISABLE_PCNT)
+  #define VWIRE_GPIO_HAS_PCNT 1
+#else
+  #define VWIRE_GPIO_HAS_PCNT 0
+#endif
+
+/** @brief PCNT glitch filter: pulses shorter than this are ignored (ns) */
+#ifndef VWIRE_GPIO_PCNT_GLITCH_NS
+  #define VWIRE_GPIO_PCNT_GLITCH_NS 1000
+#endif
+
+/** @brief Default continuous ADC sample rate (Hz) */
+#ifndef VWIRE_GPIO_ADC_SAMPLE_RATE
+  #define VWIRE_GPIO_ADC_SAMPLE_RATE 20000
+#endif
+
+/** @brief Conversions the continuous ADC driver averages per reported value */
+#ifndef VWIRE_GPIO_ADC_CONVERSIONS
+  #define VWIRE_GPIO_ADC_CONVERSIONS 16
+#endif
+
 // =============================================================================
 // GPIO PIN MODES (match server-side PinMode enum)
 // =============================================================================
 
 /**
  * @brief Pin mode types matching the cloud platform definition.
- * String values used in MQTT JSON: "OUTPUT", "INPUT", "INPUT_PULLUP", "PWM", "ANALOG_INPUT"
+ * String values used in MQTT JSON: "OUTPUT", "INPUT", "INPUT_PULLUP", "PWM", "ANALOG_INPUT",
+ * "COUNTER", "FREQUENCY"
  *
  * Smart write behaviour (applies to OUTPUT and PWM modes):
  *   value 0   → digitalWrite(LOW)   — pin fully OFF
@@ -101,9 +173,36 @@ struct VwireGPIOPin {
   VwireGPIOMode mode;       ///< Configured mode
   uint16_t readInterval;    ///< Read interval for input pins (ms)
   unsigned long lastRead;   ///< Timestamp of last read
-  int16_t lastValue;        ///< Last read/written value (for change detection)
+  unsigned long dueAt;      ///< Input pins: next time onRun() has work for this pin
+  int32_t lastValue;        ///< Last read/written value (for change detection)
   bool active;              ///< Whether this slot is in use
   uint8_t flags;            ///< Runtime flags (VWIRE_GPIO_FLAG_*)
+  uint8_t filter;           ///< Analog filter slot (0xFF = unfiltered)
+  uint8_t irq;              ///< Edge interrupt slot (0xFF = polled)
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  int16_t adcRaw;           ///< Latest continuous ADC value (-1 = none yet)
+  #endif
+  #if VWIRE_ENABLE_PUBLISH_POLICY
+  VwirePublishGate gate;    ///< Publish policy state for input pins
+  #endif
+};
+
+/**
+ * @brief Pulse counting state of a COUNTER or FREQUENCY pin
+ *
+ * Pulses are counted by a PCNT unit where available, otherwise by a
+ * RISING-edge interrupt. Either way the CPU only reads the count once per
+ * read interval.
+ */
+struct VwireGPIOCounter {
+  uint32_t total;           ///< Pulses since the pin was configured or reset
+  uint32_t lastRaw;         ///< Hardware / ISR count at the last read
+  unsigned long since;      ///< millis() of the last read
+  float hz;                 ///< Rate over the last read interval
+  #if VWIRE_GPIO_HAS_PCNT
+  void* unit;               ///< PCNT unit (nullptr = counted by the ISR)
+  void* channel;            ///< PCNT channel
+  #endif
 };
 
 // =============================================================================
@@ -197,6 +296,88 @@ public:
    */
   void send(const char* pinName, int value);
 
+  /**
+   * @brief Apply a deadband / rate-limit policy to an input pin
+   *
+   * Without a policy, an input pin publishes on every change of its reading.
+   * With one, readings inside the deadband are skipped and changes faster
+   * than minInterval are coalesced (see VwirePublishPolicy). The policy is
+   * kept when the cloud reconfigures the pin. A pinconfig entry can also
+   * set it with "deadband", "percent", "minInterval" and "maxInterval".
+   *
+   * @param pinName Pin name (e.g., "A0")
+   * @param policy  Deadband and interval settings
+   * @return true if the pin is managed
+   */
+  bool setPublishPolicy(const char* pinName, const VwirePublishPolicy& policy);
+
+  /**
+   * @brief Oversample and smooth an analog input pin
+   *
+   * Oversampling spreads its reads over the read interval, a few per
+   * onRun() at most, so run() is never blocked. The filtered reading then
+   * goes through change detection and the publish policy as usual. Passing
+   * VwireAnalogFilter() removes the filter. A pinconfig entry can also set
+   * it with "oversample", "median", "average" and "ema".
+   *
+   * @param pinName Pin name (e.g., "A0"); must be an ANALOG_INPUT pin
+   * @param filter  Pipeline settings (clamped to the supported range)
+   * @return false if the pin is not an analog input or no filter slot is free
+   */
+  bool setAnalogFilter(const char* pinName, const VwireAnalogFilter& filter);
+
+  /**
+   * @brief Sample analog inputs with the continuous (DMA) ADC driver
+   *
+   * ESP32 with Arduino core 3.x only. All ANALOG_INPUT pins (ADC1 channels)
+   * are converted in the background at sampleRateHz; each reading uses the
+   * driver's average of VWIRE_GPIO_ADC_CONVERSIONS conversions instead of
+   * a blocking analogRead(). Falls back to analogRead() if the driver
+   * cannot be set up.
+   *
+   * @param enable true to use the continuous driver
+   * @param sampleRateHz Total conversion rate
+   * @return false if the driver is not available on this board
+   */
+  bool setContinuousAdc(bool enable, uint32_t sampleRateHz = VWIRE_GPIO_ADC_SAMPLE_RATE);
+
+  /**
+   * @brief Report a digital input on its edges instead of polling it
+   *
+   * An interrupt records each edge with its timestamp in a lock-free queue
+   * that onRun() drains, so presses shorter than the read interval are not
+   * missed and idle inputs cost nothing. Edges within debounceMs of the
+   * last accepted one are ignored; once the input has been quiet for
+   * debounceMs its level is read again, so the final state is always
+   * reported. A pinconfig entry can also set it with "interrupt" and
+   * "debounce".
+   *
+   * Interrupt state is shared: only one VwireGPIO instance should use this.
+   *
+   * @param pinName Pin name (e.g., "D4"); must be an INPUT or INPUT_PULLUP pin
+   * @param enable true for edge-triggered, false to go back to polling
+   * @param debounceMs Debounce time (0 = report every edge)
+   * @return false if the pin is not a digital input or no interrupt slot is free
+   */
+  bool setEdgeTrigger(const char* pinName, bool enable,
+                      uint16_t debounceMs = VWIRE_GPIO_DEBOUNCE_MS);
+
+  // =========================================================================
+  // PULSE COUNTING
+  // =========================================================================
+  // COUNTER pins publish their running total and FREQUENCY pins their rate
+  // in Hz (two decimals) once per read interval. They share the
+  // VWIRE_GPIO_MAX_INTERRUPTS slots with edge-triggered inputs.
+
+  /** @brief Pulses counted on a COUNTER or FREQUENCY pin (0 if not one) */
+  uint32_t getPulseCount(const char* pinName) const;
+
+  /** @brief Pulse rate over the last read interval in Hz (0 if not a pulse pin) */
+  float getFrequency(const char* pinName) const;
+
+  /** @brief Restart the running total of a COUNTER or FREQUENCY pin */
+  bool resetPulseCount(const char* pinName);
+
   // =========================================================================
   // QUERY
   // =========================================================================
@@ -215,7 +396,8 @@ public:
   // =========================================================================
   void onAttach(VwireClass& vwire) override;
   void onConnect() override;
-  bool onMessage(const char* topic, const char* payload) override;
+  using VwireAddon::onMessage;
+  bool onMessage(const VwireMessage& message) override;
   void onRun() override;
 
 private:
@@ -225,16 +407,63 @@ private:
   VwireGPIOPin _pins[VWIRE_MAX_GPIO_PINS];
   uint8_t _count;
 
+  // Slot by pin name: D0.. first, then A0.. (0xFF = not managed). Names
+  // outside that range fall back to a scan of _pins.
+  uint8_t _nameIndex[VWIRE_GPIO_DIGITAL_NAMES + VWIRE_GPIO_ANALOG_NAMES];
+
+  // Slots of active input pins, ordered by dueAt
+  uint8_t _inputs[VWIRE_MAX_GPIO_PINS];
+  uint8_t _inputCount;
+
+  // Edge interrupt slots: owning pin index, and slots whose level must be
+  // re-read once their debounce time has passed
+  uint8_t _irqOwner[VWIRE_GPIO_MAX_INTERRUPTS];
+  uint8_t _irqSettle;
+  VwireGPIOCounter _counters[VWIRE_GPIO_MAX_INTERRUPTS];   ///< Indexed by irq slot
+
+  // Analog filter slots
+  VwireAnalogSampler _filters[VWIRE_GPIO_MAX_FILTERS];
+
+  #if VWIRE_GPIO_HAS_CONTINUOUS_ADC
+  uint32_t _adcRate;        ///< Continuous ADC rate (0 = analogRead())
+  uint8_t _adcCount;        ///< Pins handed to the driver
+  bool _adcRunning;
+  bool _adcDirty;           ///< Analog pin set changed: restart the driver
+  void _startContinuousAdc();
+  void _pollContinuousAdc();
+  #endif
+
   int _findPin(const char* pinName) const;
   int _findFreeSlot() const;
+  static int _nameKey(const char* pinName);
+  static bool _isInputMode(VwireGPIOMode mode);
+  unsigned long _nextDue(const VwireGPIOPin& pin, unsigned long now) const;
+  void _schedule(uint8_t slot, unsigned long now);
+  void _unschedule(uint8_t slot);
+  void _servicePin(VwireGPIOPin& pin, unsigned long now);
   static VwireGPIOMode _parseMode(const char* modeStr);
   static uint8_t _resolvePinNumber(const char* pinName);
   void _applyHardwareMode(VwireGPIOPin& pin);
   int _readHardware(const VwireGPIOPin& pin) const;
+  bool _sampleFiltered(VwireGPIOPin& pin, unsigned long now, int& value);
+  void _releaseFilter(VwireGPIOPin& pin);
+  bool _claimIrq(VwireGPIOPin& pin);
+  void _attachEdge(VwireGPIOPin& pin);
+  void _detachIrq(VwireGPIOPin& pin);
+  void _releaseIrq(VwireGPIOPin& pin);
+  void _drainEdges(unsigned long now);
+  void _attachCounter(VwireGPIOPin& pin);
+  uint32_t _counterRaw(const VwireGPIOPin& pin) const;
+  void _readCounter(VwireGPIOPin& pin, unsigned long now);
+  void _publishFrequency(const char* pinName, float hz);
+  static bool _isPulseMode(VwireGPIOMode mode);
+  void _reportInput(VwireGPIOPin& pin, int value, unsigned long now);
+  void _reportCount(VwireGPIOPin& pin, uint32_t total, unsigned long now);
   void _writeHardware(VwireGPIOPin& pin, int value);
 
   int _applyConfig(const char* jsonPayload);
   void _publishValue(const char* pinName, int value);
+  void _publishCount(const char* pinName, uint32_t total);
   bool handleCommand(const char* pinName, int value);
 };
 
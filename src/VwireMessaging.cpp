@@ -7,6 +7,10 @@
  * These helpers are optional and can be stripped from the build globally with
  * VWIRE_DISABLE_ALERTS when a sketch does not need them.
  * 
+ * JSON payloads are written by VwireJsonWriter straight into the transport
+ * (see VwireStream.h), so user text is escaped and no payload buffer is used.
+ * Every value a payload contains is fixed before the first (sizing) pass.
+ * 
  * Copyright (c) 2026 Vwire IOT
  * Website: https://vwire.io
  * MIT License
@@ -29,12 +33,11 @@
 void VwireClass::notify(const char* message) {
 #if VWIRE_ENABLE_ALERTS
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/notify", _deviceId);
-  unsigned int len = strlen(message);
-  _mqttClient.beginPublish(topic, len, false);
-  _mqttClient.print(message);
-  _mqttClient.endPublish();
+  _topic(topic, sizeof(topic), "notify");
+  _streamPublish(topic, message, strlen(message), false);
   VWIRE_LOGF("[Vwire] Notify: %s", message);
 #else
   (void)message;
@@ -60,6 +63,8 @@ void VwireClass::alarm(const char* message, const char* sound, uint8_t priority)
 void VwireClass::alarm(const char* message, const char* sound, uint8_t priority, uint8_t volume) {
 #if VWIRE_ENABLE_ALERTS
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
 
   static unsigned long lastAlarmId = 0;
   unsigned long alarmId = millis();
@@ -68,17 +73,23 @@ void VwireClass::alarm(const char* message, const char* sound, uint8_t priority,
   if (volume > 100) volume = 100;
 
   char topic[96];
-  char buffer[VWIRE_JSON_BUFFER_SIZE];
-
-  snprintf(topic, sizeof(topic), "vwire/%s/alarm", _deviceId);
-  snprintf(buffer, sizeof(buffer),
-           "{\"type\":\"alarm\",\"message\":\"%s\",\"alarmId\":\"alarm_%lu\",\"sound\":\"%s\",\"priority\":%d,\"volume\":%d,\"timestamp\":%lu}",
-           message, alarmId, sound, priority, volume, millis());
-
-  unsigned int len = strlen(buffer);
-  _mqttClient.beginPublish(topic, len, false);
-  _mqttClient.print(buffer);
-  _mqttClient.endPublish();
+  char alarmIdText[20];
+  unsigned long timestamp = millis();
+
+  _topic(topic, sizeof(topic), "alarm");
+  snprintf(alarmIdText, sizeof(alarmIdText), "alarm_%lu", alarmId);
+
+  _publishJson(topic, false, [&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("type", "alarm");
+    json.field("message", message);
+    json.field("alarmId", alarmIdText);
+    json.field("sound", sound);
+    json.field("priority", (int)priority);
+    json.field("volume", (int)volume);
+    json.field("timestamp", timestamp);
+    json.endObject();
+  });
   VWIRE_LOGF("[Vwire] Alarm: %s (sound: %s, priority: %d, volume: %d)", message, sound, priority, volume);
 #else
   (void)message;
@@ -95,17 +106,18 @@ void VwireClass::alarm(const char* message, const char* sound, uint8_t priority,
 void VwireClass::email(const char* subject, const char* body) {
 #if VWIRE_ENABLE_ALERTS
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
 
   char topic[96];
-  char buffer[VWIRE_JSON_BUFFER_SIZE];
-
-  snprintf(topic, sizeof(topic), "vwire/%s/email", _deviceId);
-  snprintf(buffer, sizeof(buffer), "{\"subject\":\"%s\",\"body\":\"%s\"}", subject, body);
-
-  unsigned int len = strlen(buffer);
-  _mqttClient.beginPublish(topic, len, false);
-  _mqttClient.print(buffer);
-  _mqttClient.endPublish();
+  _topic(topic, sizeof(topic), "email");
+
+  _publishJson(topic, false, [&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("subject", subject);
+    json.field("body", body);
+    json.endObject();
+  });
   VWIRE_LOGF("[Vwire] Email: %s", subject);
 #else
   (void)subject;
@@ -119,10 +131,9 @@ void VwireClass::email(const char* subject, const char* body) {
 
 void VwireClass::log(const char* message) {
   if (!connected()) return;
+  NetGuard guard(this, false);
+  if (!guard.locked) return;
   char topic[96];
-  snprintf(topic, sizeof(topic), "vwire/%s/log", _deviceId);
-  unsigned int len = strlen(message);
-  _mqttClient.beginPublish(topic, len, false);
-  _mqttClient.print(message);
-  _mqttClient.endPublish();
+  _topic(topic, sizeof(topic), "log");
+  _streamPublish(topic, message, strlen(message), false);
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+ * Vwire IOT Arduino Library - Runtime Metrics Implementation
+ *
+ * Recording happens inline in run(), the MQTT callback and the publish
+ * paths through the VWIRE_METRIC_* macros; this file holds the reporting
+ * side and the heap sampling.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_METRICS
+
+// =============================================================================
+// RECORDING HELPERS
+// =============================================================================
+
+void VwireClass::_recordPublish(uint32_t startUs, size_t bytes, bool ok) {
+  _metrics.publish.record(micros() - startUs);
+  if (ok) {
+    _metrics.messagesOut++;
+    _metrics.bytesOut += bytes;
+  } else {
+    _metrics.messagesDropped++;
+  }
+}
+
+void VwireClass::_sampleHeap() {
+  uint32_t freeHeap = 0;
+  uint32_t maxBlock = 0;
+  #if defined(VWIRE_BOARD_ESP32)
+  freeHeap = ESP.getMinFreeHeap();        // Tracked by the IDF since boot
+  maxBlock = ESP.getMaxAllocHeap();
+  #elif defined(VWIRE_BOARD_ESP8266)
+  freeHeap = ESP.getFreeHeap();
+  maxBlock = ESP.getMaxFreeBlockSize();
+  #endif
+
+  if (freeHeap > 0 && (_metrics.minFreeHeap == 0 || freeHeap < _metrics.minFreeHeap)) {
+    _metrics.minFreeHeap = freeHeap;
+  }
+  if (maxBlock > 0 && (_metrics.minMaxBlock == 0 || maxBlock < _metrics.minMaxBlock)) {
+    _metrics.minMaxBlock = maxBlock;
+  }
+}
+
+uint32_t VwireClass::_totalOverruns() const {
+  uint32_t total = _metrics.timerOverruns;
+  for (uint8_t i = 0; i < VWIRE_MAX_ADDONS; i++) {
+    total += _metrics.addonOverruns[i];
+  }
+  return total;
+}
+
+int VwireClass::_formatMetrics(char* buffer, size_t size) {
+  int len = snprintf(buffer, size,
+    "\"metrics\":{\"loopMaxUs\":%lu,\"loopP99Us\":%lu,\"mqttMaxUs\":%lu,"
+    "\"dispatchMaxUs\":%lu,\"publishMaxUs\":%lu,\"addonMaxUs\":[",
+    (unsigned long)_metrics.loop.maxUs, (unsigned long)_metrics.loop.percentileUs(99),
+    (unsigned long)_metrics.mqttLoop.maxUs, (unsigned long)_metrics.dispatch.maxUs,
+    (unsigned long)_metrics.publish.maxUs);
+
+  for (uint8_t i = 0; i < _addonCount && len > 0 && (size_t)len < size; i++) {
+    len += snprintf(buffer + len, size - len, i > 0 ? ",%lu" : "%lu",
+                    (unsigned long)_metrics.addonRun[i].maxUs);
+  }
+
+  if (len > 0 && (size_t)len < size) {
+    len += snprintf(buffer + len, size - len,
+      "],\"overruns\":%lu,\"deferred\":%lu,\"in\":%lu,\"out\":%lu,\"bytesIn\":%lu,\"bytesOut\":%lu,\"dropped\":%lu,"
+      "\"reconnects\":%lu,\"maxOutageMs\":%lu,\"minHeap\":%lu,\"minBlock\":%lu}",
+      (unsigned long)_totalOverruns(), (unsigned long)_metrics.deferrals,
+      (unsigned long)_metrics.messagesIn, (unsigned long)_metrics.messagesOut,
+      (unsigned long)_metrics.bytesIn, (unsigned long)_metrics.bytesOut,
+      (unsigned long)_metrics.messagesDropped, (unsigned long)_metrics.reconnects,
+      (unsigned long)_metrics.maxOutageMs, (unsigned long)_metrics.minFreeHeap,
+      (unsigned long)_metrics.minMaxBlock);
+  }
+  return len;
+}
+
+#endif // VWIRE_ENABLE_METRICS
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+const VwireMetrics& VwireClass::getMetrics() {
+#if VWIRE_ENABLE_METRICS
+  _sampleHeap();
+  return _metrics;
+#else
+  static const VwireMetrics empty;
+  return empty;
+#endif
+}
+
+void VwireClass::resetMetrics() {
+#if VWIRE_ENABLE_METRICS
+  _metrics.reset();
+#endif
+}
+
+void VwireClass::setMetricsInHeartbeat(bool enable) {
+#if VWIRE_ENABLE_METRICS
+  _metricsInHeartbeat = enable;
+#else
+  (void)enable;
+#endif
+}
+
+#if VWIRE_ENABLE_METRICS
+static void _vwirePrintStats(Print& out, const __FlashStringHelper* label,
+                             const VwireLatencyStats& stats) {
+  out.print(label);
+  out.print(F(" n=")); out.print(stats.count);
+  out.print(F(" avg=")); out.print(stats.averageUs());
+  out.print(F("us p99<=")); out.print(stats.percentileUs(99));
+  out.print(F("us max=")); out.print(stats.maxUs);
+  out.println(F("us"));
+}
+#endif
+
+void VwireClass::printMetrics(Print& out) {
+#if VWIRE_ENABLE_METRICS
+  _sampleHeap();
+  out.println(F("\n=== Vwire IOT Metrics ==="));
+  out.print(F("Window: ")); out.print((millis() - _metrics.since) / 1000); out.println(F(" sec"));
+  _vwirePrintStats(out, F("run()     "), _metrics.loop);
+  _vwirePrintStats(out, F("mqtt loop "), _metrics.mqttLoop);
+  _vwirePrintStats(out, F("dispatch  "), _metrics.dispatch);
+  _vwirePrintStats(out, F("publish   "), _metrics.publish);
+  for (uint8_t i = 0; i < _addonCount; i++) {
+    out.print(F("addon[")); out.print(i); out.print(F("]"));
+    _vwirePrintStats(out, F("  "), _metrics.addonRun[i]);
+  }
+  if (_metrics.timerRun.count > 0) {
+    _vwirePrintStats(out, F("timers    "), _metrics.timerRun);
+  }
+  out.print(F("Budget overruns: ")); out.print(_totalOverruns());
+  out.print(F(" (timers ")); out.print(_metrics.timerOverruns);
+  out.print(F("), deferred tasks: ")); out.println(_metrics.deferrals);
+  out.print(F("Messages in/out: ")); out.print(_metrics.messagesIn);
+  out.print(F(" / ")); out.print(_metrics.messagesOut);
+  out.print(F(" (dropped ")); out.print(_metrics.messagesDropped);
+  out.print(F(", coalesced ")); out.print(_metrics.commandsCoalesced); out.println(F(")"));
+  out.print(F("Bytes in/out: ")); out.print(_metrics.bytesIn);
+  out.print(F(" / ")); out.println(_metrics.bytesOut);
+  out.print(F("Reconnects: ")); out.print(_metrics.reconnects);
+  out.print(F(" (failed attempts ")); out.print(_metrics.connectFailures);
+  out.print(F(", last outage ")); out.print(_metrics.lastOutageMs);
+  out.print(F(" ms, max ")); out.print(_metrics.maxOutageMs); out.println(F(" ms)"));
+  out.print(F("Min free heap: ")); out.print(_metrics.minFreeHeap);
+  out.print(F(" bytes, min max block: ")); out.print(_metrics.minMaxBlock); out.println(F(" bytes"));
+  out.println(F("=========================\n"));
+#else
+  out.println(F("[Vwire] Metrics are not available in this build"));
+#endif
+}
@@ -0,0 +1,171 @@
+/*
+ * Vwire IOT Arduino Library - Runtime Metrics
+ *
+ * Counters and latency histograms for the run() hot path: time spent in
+ * the MQTT client loop, in each addon's onRun(), in message dispatch and
+ * in publishes, plus traffic, reconnect and heap watermark counters.
+ *
+ * Usage:
+ *   const VwireMetrics& m = Vwire.getMetrics();
+ *   Serial.println(m.addonRun[0].maxUs);
+ *   Vwire.printMetrics(Serial);
+ *   Vwire.setMetricsInHeartbeat(true);
+ *
+ * Strip from the build with VWIRE_DISABLE_METRICS.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_METRICS_H
+#define VWIRE_METRICS_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+/** @brief Number of latency histogram buckets */
+#define VWIRE_METRICS_BUCKETS 8
+
+// =============================================================================
+// LATENCY STATISTICS
+// =============================================================================
+
+/**
+ * @brief Call count, total/max duration and a log-scale histogram
+ *
+ * Bucket i counts durations below bucketLimitUs(i): 64 us, 256 us, 1 ms,
+ * 4 ms, 16 ms, 64 ms, 256 ms. The last bucket holds everything slower.
+ */
+struct VwireLatencyStats {
+  uint32_t count;                           ///< Recorded calls
+  uint32_t maxUs;                           ///< Slowest call (us)
+  uint64_t totalUs;                         ///< Sum of all calls (us)
+  uint32_t buckets[VWIRE_METRICS_BUCKETS];  ///< Histogram
+
+  VwireLatencyStats() { reset(); }
+
+  /** @brief Clear all counters */
+  void reset() {
+    count = 0;
+    maxUs = 0;
+    totalUs = 0;
+    memset(buckets, 0, sizeof(buckets));
+  }
+
+  /** @brief Record one call that took us microseconds */
+  void record(uint32_t us) {
+    count++;
+    totalUs += us;
+    if (us > maxUs) maxUs = us;
+    uint8_t bucket = 0;
+    while (bucket < VWIRE_METRICS_BUCKETS - 1 && us >= bucketLimitUs(bucket)) {
+      bucket++;
+    }
+    buckets[bucket]++;
+  }
+
+  /** @brief Mean duration (us) */
+  uint32_t averageUs() const {
+    return count > 0 ? (uint32_t)(totalUs / count) : 0;
+  }
+
+  /**
+   * @brief Upper bound of the bucket holding the given percentile
+   * @param percent 1-100 (e.g. 99 for p99)
+   * @return Bucket limit in us, or maxUs for the open-ended last bucket
+   */
+  uint32_t percentileUs(uint8_t percent) const {
+    if (count == 0) return 0;
+    uint32_t target = (uint32_t)(((uint64_t)count * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < VWIRE_METRICS_BUCKETS - 1; i++) {
+      seen += buckets[i];
+      if (seen >= target) return bucketLimitUs(i);
+    }
+    return maxUs;
+  }
+
+  /** @brief Exclusive upper limit of bucket i (us) */
+  static uint32_t bucketLimitUs(uint8_t i) {
+    return (uint32_t)64 << (2 * i);
+  }
+};
+
+// =============================================================================
+// METRICS SNAPSHOT
+// =============================================================================
+
+/**
+ * @brief All runtime metrics collected by VwireClass
+ *
+ * addonRun[i] and addonOverruns[i] belong to the i-th registered addon
+ * (registration order of addAddon(), including the built-in GPIO, OTA,
+ * reliable delivery and offline queue addons). Overrun and deferral
+ * counters only move when scheduler budgets are set.
+ */
+struct VwireMetrics {
+  VwireLatencyStats loop;                          ///< Whole run() call
+  VwireLatencyStats mqttLoop;                      ///< PubSubClient::loop(), including dispatch
+  VwireLatencyStats dispatch;                      ///< Handler/addon dispatch per inbound message
+  VwireLatencyStats publish;                       ///< Outbound publishes
+  VwireLatencyStats addonRun[VWIRE_MAX_ADDONS];    ///< Each addon's onRun()
+  VwireLatencyStats timerRun;                      ///< Timers registered with addTimer()
+
+  uint32_t addonOverruns[VWIRE_MAX_ADDONS];        ///< onRun() calls over the addon's budget
+  uint32_t timerOverruns;     ///< Registered timer passes over their budget
+  uint32_t deferrals;         ///< Due tasks pushed to the next run() by the run budget
+
+  uint32_t messagesIn;        ///< Inbound messages dispatched
+  uint32_t messagesOut;       ///< Publishes accepted by the client
+  uint32_t bytesIn;           ///< Inbound topic + payload bytes
+  uint32_t bytesOut;          ///< Outbound topic + payload bytes
+  uint32_t messagesDropped;   ///< Writes lost (disconnected, not queued, or publish failed)
+  uint32_t commandsCoalesced; ///< Inbound commands replaced by a newer one (latest-wins pins)
+
+  uint32_t reconnects;        ///< Successful reconnects after a drop
+  uint32_t connectFailures;   ///< Failed connection attempts
+  uint32_t lastOutageMs;      ///< Duration of the last outage (drop to reconnect)
+  uint32_t maxOutageMs;       ///< Longest outage
+  uint32_t totalOutageMs;     ///< Sum of all outages
+
+  uint32_t minFreeHeap;       ///< Lowest free heap seen (bytes, 0 if unknown)
+  uint32_t minMaxBlock;       ///< Smallest largest-free-block seen (bytes, 0 if unknown)
+  unsigned long since;        ///< millis() when collection started or was reset
+
+  VwireMetrics() { reset(); }
+
+  /** @brief Clear all counters and restart collection */
+  void reset() {
+    loop.reset();
+    mqttLoop.reset();
+    dispatch.reset();
+    publish.reset();
+    for (uint8_t i = 0; i < VWIRE_MAX_ADDONS; i++) addonRun[i].reset();
+    timerRun.reset();
+    memset(addonOverruns, 0, sizeof(addonOverruns));
+    timerOverruns = deferrals = 0;
+    messagesIn = messagesOut = bytesIn = bytesOut = messagesDropped = 0;
+    commandsCoalesced = 0;
+    reconnects = connectFailures = 0;
+    lastOutageMs = maxOutageMs = totalOutageMs = 0;
+    minFreeHeap = minMaxBlock = 0;
+    since = millis();
+  }
+};
+
+// =============================================================================
+// INSTRUMENTATION MACROS (internal)
+// =============================================================================
+
+#if VWIRE_ENABLE_METRICS
+  #define VWIRE_METRIC_START(name) const uint32_t name = micros()
+  #define VWIRE_METRIC_RECORD(stats, name) (stats).record(micros() - (name))
+  #define VWIRE_METRIC_COUNT(field, n) (field) += (n)
+#else
+  #define VWIRE_METRIC_START(name) do { } while (0)
+  #define VWIRE_METRIC_RECORD(stats, name) do { } while (0)
+  #define VWIRE_METRIC_COUNT(field, n) do { } while (0)
+#endif
+
+#endif // VWIRE_METRICS_H
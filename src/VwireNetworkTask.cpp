@@ -0,0 +1,227 @@
+/*
+ * Vwire IOT Arduino Library - Network Task (ESP32)
+ *
+ * startNetworkTask() pins a FreeRTOS task to the protocol core that runs
+ * the normal run() body: MQTT client loop, heartbeats, reconnects, addons
+ * and publish policies. The app core and the task only share two queues:
+ *
+ *   app  -> task  pin writes and batch markers, in call order
+ *   task -> app   virtual pin commands for VWIRE_RECEIVE handlers
+ *
+ * Queue sends never wait, so virtualSend() costs a copy into the queue. The
+ * task holds a recursive mutex while it works, reconnect steps included; the
+ * few app-side calls that publish directly (notify(), publish(), ...) take it
+ * for their duration, but wait at most VWIRE_NET_LOCK_TIMEOUT for it.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_NETWORK_TASK
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+// Seven carves, each but the first padded to 8 bytes
+size_t VwireClass::_netArenaDemand(uint32_t stackSize) {
+  return VWIRE_NET_OUT_QUEUE * sizeof(NetItem) + VWIRE_NET_IN_QUEUE * sizeof(NetItem) +
+         stackSize + 2 * sizeof(StaticQueue_t) + sizeof(StaticSemaphore_t) +
+         sizeof(StaticTask_t) + 6 * 7;
+}
+
+bool VwireClass::startNetworkTask(uint8_t core, uint32_t stackSize, uint8_t priority) {
+  if (_netTask) {
+    return false;
+  }
+
+  // With a memory budget, queues, mutex and stack are carved from the arena
+  // (all or nothing) instead of the FreeRTOS heap
+  const size_t outBytes = VWIRE_NET_OUT_QUEUE * sizeof(NetItem);
+  const size_t inBytes = VWIRE_NET_IN_QUEUE * sizeof(NetItem);
+  bool fromArena = false;
+  #if VWIRE_ENABLE_ARENA
+  fromArena = _arena.fits(_netArenaDemand(stackSize), 1);
+  #endif
+
+  StackType_t* stack = nullptr;
+  StaticTask_t* taskBuffer = nullptr;
+  if (fromArena) {
+    uint8_t* outStorage = (uint8_t*)_arenaAllocate(outBytes, "net");
+    StaticQueue_t* outQueue = (StaticQueue_t*)_arenaAllocate(sizeof(StaticQueue_t), "net");
+    uint8_t* inStorage = (uint8_t*)_arenaAllocate(inBytes, "net");
+    StaticQueue_t* inQueue = (StaticQueue_t*)_arenaAllocate(sizeof(StaticQueue_t), "net");
+    StaticSemaphore_t* mutex = (StaticSemaphore_t*)_arenaAllocate(sizeof(StaticSemaphore_t), "net");
+    stack = (StackType_t*)_arenaAllocate(stackSize, "net");
+    taskBuffer = (StaticTask_t*)_arenaAllocate(sizeof(StaticTask_t), "net");
+    _netOutbound = xQueueCreateStatic(VWIRE_NET_OUT_QUEUE, sizeof(NetItem), outStorage, outQueue);
+    _netInbound = xQueueCreateStatic(VWIRE_NET_IN_QUEUE, sizeof(NetItem), inStorage, inQueue);
+    _netMutex = xSemaphoreCreateRecursiveMutexStatic(mutex);
+  } else {
+    _netOutbound = xQueueCreate(VWIRE_NET_OUT_QUEUE, sizeof(NetItem));
+    _netInbound = xQueueCreate(VWIRE_NET_IN_QUEUE, sizeof(NetItem));
+    _netMutex = xSemaphoreCreateRecursiveMutex();
+  }
+
+  TaskHandle_t task = nullptr;
+  if (_netOutbound && _netInbound && _netMutex) {
+    // Hold the lock until _netTask is set, so the task cannot start working
+    // while run() on this core still owns the client
+    xSemaphoreTakeRecursive(_netMutex, portMAX_DELAY);
+    if (fromArena) {
+      // ESP-IDF stack depth is in bytes
+      task = xTaskCreateStaticPinnedToCore(_networkTaskEntry, "vwire_net", stackSize, this,
+                                           priority, stack, taskBuffer, core);
+    } else if (xTaskCreatePinnedToCore(_networkTaskEntry, "vwire_net", stackSize, this,
+                                       priority, &task, core) != pdPASS) {
+      task = nullptr;
+    }
+    if (task) {
+      _netTask = task;
+      xSemaphoreGiveRecursive(_netMutex);
+      VWIRE_LOGF("[Vwire] Network task started on core %d", core);
+      return true;
+    }
+    xSemaphoreGiveRecursive(_netMutex);
+  }
+
+  if (_netOutbound) vQueueDelete(_netOutbound);
+  if (_netInbound) vQueueDelete(_netInbound);
+  if (_netMutex) vSemaphoreDelete(_netMutex);
+  _netOutbound = _netInbound = nullptr;
+  _netMutex = nullptr;
+  VWIRE_LOG("[Vwire] Error: could not start network task");
+  return false;
+}
+
+bool VwireClass::isNetworkTaskRunning() const {
+  return _netTask != nullptr;
+}
+
+// =============================================================================
+// TASK
+// =============================================================================
+
+void VwireClass::_networkTaskEntry(void* arg) {
+  VwireClass* vwire = static_cast<VwireClass*>(arg);
+  for (;;) {
+    vwire->_netLock();
+    vwire->_runNetwork();
+    vwire->_netDrainOutbound();
+    vwire->_netUnlock();
+    vTaskDelay(1);                   // Let the idle task and app-side callers in
+  }
+}
+
+bool VwireClass::_onAppSide() const {
+  return xTaskGetCurrentTaskHandle() != _netTask;
+}
+
+bool VwireClass::_netLock(bool wait) {
+  if (!_netMutex) return true;
+  // A reconnect can hold the lock for seconds; app-side publishers give up
+  TickType_t ticks = wait || !_onAppSide() ? portMAX_DELAY : pdMS_TO_TICKS(VWIRE_NET_LOCK_TIMEOUT);
+  if (xSemaphoreTakeRecursive(_netMutex, ticks) == pdTRUE) return true;
+  _setError(VWIRE_ERR_TIMEOUT);
+  VWIRE_METRIC_COUNT(_metrics.messagesDropped, 1);
+  return false;
+}
+
+void VwireClass::_netUnlock() {
+  if (_netMutex) xSemaphoreGiveRecursive(_netMutex);
+}
+
+// =============================================================================
+// QUEUES
+// =============================================================================
+
+bool VwireClass::_netSend(uint8_t op, uint8_t pin, const char* value) {
+  NetItem item;
+  size_t len = strlen(value);
+  if (len >= sizeof(item.value)) {
+    _setError(VWIRE_ERR_BUFFER_FULL);
+    VWIRE_LOGF("[Vwire] Error: V%d value too long for the network queue (%u)", pin, (unsigned)len);
+    return false;
+  }
+
+  item.op = op;
+  item.pin = pin;
+  memcpy(item.value, value, len + 1);
+  if (xQueueSend(_netOutbound, &item, 0) != pdTRUE) {
+    _setError(VWIRE_ERR_BUFFER_FULL);
+    VWIRE_METRIC_COUNT(_metrics.messagesDropped, 1);
+    return false;
+  }
+  return true;
+}
+
+void VwireClass::_netForward(int pin, const char* payload, unsigned int length) {
+  if (pin < 0 || pin >= VWIRE_MAX_VIRTUAL_PINS) {
+    return;
+  }
+
+  NetItem item;
+  if (length >= sizeof(item.value)) {
+    VWIRE_LOGF("[Vwire] Error: V%d command too long for the network queue (%u)", pin, length);
+    return;
+  }
+
+  item.op = VWIRE_NET_OP_PIN;
+  item.pin = (uint8_t)pin;
+  memcpy(item.value, payload, length);
+  item.value[length] = '\0';
+  if (xQueueSend(_netInbound, &item, 0) != pdTRUE) {
+    VWIRE_LOGF("[Vwire] Error: command queue full, V%d dropped", pin);
+  }
+}
+
+void VwireClass::_netDrainOutbound() {
+  NetItem item;
+  while (xQueueReceive(_netOutbound, &item, 0) == pdTRUE) {
+    switch (item.op) {
+      case VWIRE_NET_OP_BATCH_BEGIN:
+        beginBatch();
+        break;
+      case VWIRE_NET_OP_BATCH_COMMIT:
+        commitBatch();
+        break;
+      default:
+        _virtualSendInternal(item.pin, item.value);
+        break;
+    }
+  }
+}
+
+void VwireClass::_netDrainInbound() {
+  NetItem item;
+  while (xQueueReceive(_netInbound, &item, 0) == pdTRUE) {
+    _runPinHandler(item.pin, item.value, strlen(item.value));
+  }
+}
+
+#else
+
+bool VwireClass::startNetworkTask(uint8_t core, uint32_t stackSize, uint8_t priority) {
+  (void)core;
+  (void)stackSize;
+  (void)priority;
+  _debugPrint("[Vwire] Network task is not available in this build");
+  return false;
+}
+
+bool VwireClass::isNetworkTaskRunning() const {
+  return false;
+}
+
+#endif // VWIRE_ENABLE_NETWORK_TASK
@@ -3,6 +3,15 @@
  * 
  * Implements local OTA and Cloud OTA as an optional addon attached to the
  * Vwire core.
+ *
+ * Cloud OTA is a state machine stepped from onRun(): CONNECT opens the
+ * download (with a Range header once bytes are on flash), DOWNLOAD reads
+ * for up to VWIRE_OTA_SLICE_MS per call and writes to the Update partition,
+ * REBOOT restarts after the final status has been published. Only
+ * connecting and reading the response headers block, bounded by
+ * VWIRE_OTA_HTTP_TIMEOUT. The update partition stays open across retries,
+ * so a resume continues where the last connection stopped; a reboot starts
+ * the update over.
  * 
  * Copyright (c) 2026 Vwire IOT
  * Website: https://vwire.io
@@ -24,9 +33,216 @@
 #endif
 
 #if defined(VWIRE_BOARD_ESP32) && VWIRE_ENABLE_CLOUD_OTA
-  #include <HTTPUpdate.h>
+  #include <HTTPClient.h>
+  #include <Update.h>
+  #if __has_include(<rom/miniz.h>)
+    #include <rom/miniz.h>             // ROM inflater for gzip images
+    #define VWIRE_OTA_HAS_INFLATE 1
+  #elif __has_include(<esp32/rom/miniz.h>)
+    #include <esp32/rom/miniz.h>
+    #define VWIRE_OTA_HAS_INFLATE 1
+  #endif
 #elif defined(VWIRE_BOARD_ESP8266) && VWIRE_ENABLE_CLOUD_OTA
-  #include <ESP8266httpUpdate.h>
+  #include <ESP8266HTTPClient.h>
+  #include <Updater.h>
+  #include <bearssl/bearssl_hash.h>
+#endif
+
+#if defined(VWIRE_BOARD_ESP32) && VWIRE_ENABLE_CLOUD_OTA
+  #include <mbedtls/version.h>
+  #include <mbedtls/sha256.h>
+  #include <mbedtls/md5.h>
+#endif
+
+#ifndef VWIRE_OTA_HAS_INFLATE
+  #define VWIRE_OTA_HAS_INFLATE 0
+#endif
+
+#if VWIRE_ENABLE_CLOUD_OTA
+// =============================================================================
+// SHA-256 / MD5 OF THE DOWNLOAD
+// =============================================================================
+
+// Both digests cover the served file, so a gzip image is checked as it was
+// downloaded, not as it was inflated into flash
+struct VwireOTAHash {
+  #if defined(VWIRE_BOARD_ESP32)
+  mbedtls_sha256_context context;
+  mbedtls_md5_context md5;
+  #else
+  br_sha256_context context;
+  br_md5_context md5;
+  #endif
+  uint8_t expected[32];
+  uint8_t expectedMd5[16];
+};
+
+static uint8_t _hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return 0;
+}
+
+static void _hexBytes(uint8_t* out, const char* hex, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    out[i] = (uint8_t)((_hexNibble(hex[2 * i]) << 4) | _hexNibble(hex[2 * i + 1]));
+  }
+}
+
+static void _hashBegin(VwireOTAHash& hash, const char* expectedHex) {
+  _hexBytes(hash.expected, expectedHex, 32);
+  #if defined(VWIRE_BOARD_ESP32)
+  mbedtls_sha256_init(&hash.context);
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_sha256_starts(&hash.context, 0);
+  #else
+  mbedtls_sha256_starts_ret(&hash.context, 0);
+  #endif
+  #else
+  br_sha256_init(&hash.context);
+  #endif
+}
+
+static void _hashUpdate(VwireOTAHash& hash, const uint8_t* data, size_t length) {
+  #if defined(VWIRE_BOARD_ESP32)
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_sha256_update(&hash.context, data, length);
+  #else
+  mbedtls_sha256_update_ret(&hash.context, data, length);
+  #endif
+  #else
+  br_sha256_update(&hash.context, data, length);
+  #endif
+}
+
+static bool _hashMatches(VwireOTAHash& hash) {
+  uint8_t digest[32];
+  #if defined(VWIRE_BOARD_ESP32)
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_sha256_finish(&hash.context, digest);
+  #else
+  mbedtls_sha256_finish_ret(&hash.context, digest);
+  #endif
+  mbedtls_sha256_free(&hash.context);
+  #else
+  br_sha256_out(&hash.context, digest);
+  #endif
+  return memcmp(digest, hash.expected, sizeof(digest)) == 0;
+}
+
+static void _md5Begin(VwireOTAHash& hash, const char* expectedHex) {
+  _hexBytes(hash.expectedMd5, expectedHex, 16);
+  #if defined(VWIRE_BOARD_ESP32)
+  mbedtls_md5_init(&hash.md5);
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_md5_starts(&hash.md5);
+  #else
+  mbedtls_md5_starts_ret(&hash.md5);
+  #endif
+  #else
+  br_md5_init(&hash.md5);
+  #endif
+}
+
+static void _md5Update(VwireOTAHash& hash, const uint8_t* data, size_t length) {
+  #if defined(VWIRE_BOARD_ESP32)
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_md5_update(&hash.md5, data, length);
+  #else
+  mbedtls_md5_update_ret(&hash.md5, data, length);
+  #endif
+  #else
+  br_md5_update(&hash.md5, data, length);
+  #endif
+}
+
+static bool _md5Matches(VwireOTAHash& hash) {
+  uint8_t digest[16];
+  #if defined(VWIRE_BOARD_ESP32)
+  #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_md5_finish(&hash.md5, digest);
+  #else
+  mbedtls_md5_finish_ret(&hash.md5, digest);
+  #endif
+  mbedtls_md5_free(&hash.md5);
+  #else
+  br_md5_out(&hash.md5, digest);
+  #endif
+  return memcmp(digest, hash.expectedMd5, sizeof(digest)) == 0;
+}
+#endif
+
+#if VWIRE_OTA_HAS_INFLATE
+// =============================================================================
+// GZIP INFLATE (ESP32)
+// =============================================================================
+
+// Parse position inside a gzip member (RFC 1952)
+enum {
+  GZ_FIXED,                            // ID1 ID2 CM FLG MTIME XFL OS
+  GZ_EXTRA_LEN,
+  GZ_EXTRA,
+  GZ_NAME,
+  GZ_COMMENT,
+  GZ_HCRC,
+  GZ_BODY,                             // Deflate data
+  GZ_TRAILER
+};
+
+struct VwireOTAInflate {
+  tinfl_decompressor decomp;
+  uint8_t window[TINFL_LZ_DICT_SIZE];  // Inflate output, also the LZ77 dictionary
+  size_t windowPos;
+  uint8_t state;
+  uint8_t flags;
+  uint16_t count;
+  uint16_t extra;
+};
+
+// Next header field present according to FLG
+static uint8_t _gzipNextField(uint8_t state, uint8_t flags) {
+  static const uint8_t fieldFlag[] = { 0, 0x04, 0x04, 0x08, 0x10, 0x02 };
+  while (++state < GZ_BODY && !(flags & fieldFlag[state])) {}
+  return state;
+}
+
+// Consume header bytes; returns how many were used
+static size_t _gzipHeader(VwireOTAInflate& z, const uint8_t* data, size_t length) {
+  size_t used = 0;
+  while (used < length && z.state < GZ_BODY) {
+    uint8_t c = data[used++];
+    bool fieldDone = false;
+    switch (z.state) {
+      case GZ_FIXED:
+        if (z.count == 3) z.flags = c;
+        fieldDone = ++z.count == 10;
+        break;
+      case GZ_EXTRA_LEN:
+        z.extra |= (uint16_t)(c << (8 * z.count));
+        fieldDone = ++z.count == 2;
+        break;
+      case GZ_EXTRA:
+        fieldDone = ++z.count == z.extra;
+        break;
+      case GZ_NAME:
+      case GZ_COMMENT:
+        fieldDone = c == 0;
+        break;
+      case GZ_HCRC:
+        fieldDone = ++z.count == 2;
+        break;
+    }
+    if (fieldDone) {
+      z.count = 0;
+      z.state = _gzipNextField(z.state, z.flags);
+      if (z.state == GZ_EXTRA && z.extra == 0) {
+        z.state = _gzipNextField(z.state, z.flags);
+      }
+    }
+  }
+  return used;
+}
 #endif
 
 // =============================================================================
@@ -46,8 +262,30 @@ VwireOTAAddon::VwireOTAAddon()
   #endif
   #if VWIRE_ENABLE_CLOUD_OTA
   , _cloudEnabled(false)
+  , _cloudState(CLOUD_IDLE)
+  , _httpClient(nullptr)
+  , _http(nullptr)
+  , _chunk(nullptr)
+  , _total(0)
+  , _received(0)
+  , _skip(0)
+  , _retries(0)
+  , _reported(0)
+  , _cloudDeadline(0)
+  , _lastData(0)
+  , _imageOpen(false)
+  , _gzip(false)
+  , _stageOnly(false)
+  , _inflate(nullptr)
+  , _sha(nullptr)
+  , _checkSha(false)
+  , _checkMd5(false)
+  #endif
+{
+  #if VWIRE_ENABLE_CLOUD_OTA
+  _updateId[0] = '\0';
   #endif
-{}
+}
 
 void VwireOTAAddon::begin(VwireClass& vwire) {
   _vwire = &vwire;
@@ -65,25 +303,22 @@ void VwireOTAAddon::onAttach(VwireClass& vwire) {
 void VwireOTAAddon::onConnect() {
   #if VWIRE_ENABLE_CLOUD_OTA
   if (_cloudEnabled && _vwire) {
-    String otaTopic = _vwire->_buildTopic("ota");
-    _vwire->_mqttClient.subscribe(otaTopic.c_str(), 1);
-    VWIRE_LOGF("[Vwire] Subscribed to: %s (Cloud OTA)", otaTopic.c_str());
+    char otaTopic[96];
+    _vwire->_topic(otaTopic, sizeof(otaTopic), "ota");
+    _vwire->_streamSubscribe(otaTopic, 1);
+    VWIRE_LOGF("[Vwire] Subscribed to: %s (Cloud OTA)", otaTopic);
   }
   #endif
 }
 
-bool VwireOTAAddon::onMessage(const char* topic, const char* payload) {
+bool VwireOTAAddon::onMessage(const VwireMessage& message) {
   #if VWIRE_ENABLE_CLOUD_OTA
-  if (_cloudEnabled) {
-    const char* otaPos = strstr(topic, "/ota");
-    if (otaPos && *(otaPos + 4) == '\0') {
-      _handleCloudOTA(payload);
-      return true;
-    }
+  if (_cloudEnabled && message.type == VWIRE_MSG_OTA) {
+    _handleCloudOTA(message.payload);
+    return true;
   }
   #else
-  (void)topic;
-  (void)payload;
+  (void)message;
   #endif
 
   return false;
@@ -95,6 +330,11 @@ void VwireOTAAddon::onRun() {
     ArduinoOTA.handle();
   }
   #endif
+  #if VWIRE_ENABLE_CLOUD_OTA
+  if (_cloudState != CLOUD_IDLE) {
+    _runCloud();
+  }
+  #endif
 }
 
 #if VWIRE_ENABLE_LOCAL_OTA
@@ -168,13 +408,17 @@ void VwireOTAAddon::enableCloud() {
   VWIRE_LOG("[Vwire] Cloud OTA enabled");
 
   if (_vwire->connected()) {
-    String otaTopic = _vwire->_buildTopic("ota");
-    _vwire->_mqttClient.subscribe(otaTopic.c_str(), 1);
-    VWIRE_LOGF("[Vwire] Subscribed to: %s (Cloud OTA)", otaTopic.c_str());
+    char otaTopic[96];
+    _vwire->_topic(otaTopic, sizeof(otaTopic), "ota");
+    _vwire->_streamSubscribe(otaTopic, 1);
+    VWIRE_LOGF("[Vwire] Subscribed to: %s (Cloud OTA)", otaTopic);
   }
 }
 
 void VwireOTAAddon::disableCloud() {
+  if (_cloudState != CLOUD_IDLE && _cloudState != CLOUD_REBOOT) {
+    _failCloud("Cloud OTA disabled");
+  }
   _cloudEnabled = false;
   VWIRE_LOG("[Vwire] Cloud OTA disabled");
 }
@@ -183,20 +427,11 @@ bool VwireOTAAddon::isCloudEnabled() const {
   return _cloudEnabled;
 }
 
-void VwireOTAAddon::_ensureMqttForOTA() {
-  if (_vwire->_mqttClient.connected()) return;
-
-  VWIRE_LOG("[Vwire] MQTT disconnected during OTA download, reconnecting...");
-  for (int i = 0; i < 3; i++) {
-    _vwire->_setupClient();
-    if (_vwire->_connectMQTT()) {
-      VWIRE_LOG("[Vwire] MQTT reconnected for OTA status report");
-      return;
-    }
-    delay(1000);
-  }
-
-  VWIRE_LOG("[Vwire] MQTT reconnect failed - OTA status may not be reported");
+int VwireOTAAddon::cloudProgress() const {
+  if (_cloudState == CLOUD_IDLE) return -1;
+  if (_cloudState == CLOUD_STAGED || _cloudState == CLOUD_REBOOT) return 100;
+  if (_total == 0) return 0;
+  return (int)((uint64_t)_received * 100 / _total);
 }
 
 void VwireOTAAddon::_publishOTAStatus(const char* updateId, const char* status, int progress,
@@ -204,20 +439,17 @@ void VwireOTAAddon::_publishOTAStatus(const char* updateId, const char* status,
   if (!_vwire->connected()) return;
 
   char topic[96];
-  char buffer[256];
-  snprintf(topic, sizeof(topic), "vwire/%s/ota_status", _vwire->_deviceId);
-
-  if (error) {
-    snprintf(buffer, sizeof(buffer),
-             "{\"updateId\":\"%s\",\"status\":\"%s\",\"progress\":%d,\"error\":\"%s\",\"version\":\"%s\"}",
-             updateId, status, progress, error, VWIRE_VERSION);
-  } else {
-    snprintf(buffer, sizeof(buffer),
-             "{\"updateId\":\"%s\",\"status\":\"%s\",\"progress\":%d,\"version\":\"%s\"}",
-             updateId, status, progress, VWIRE_VERSION);
-  }
-
-  _vwire->_mqttClient.publish(topic, buffer, true);
+  _vwire->_topic(topic, sizeof(topic), "ota_status");
+
+  _vwire->_publishJson(topic, true, [&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("updateId", updateId);
+    json.field("status", status);
+    json.field("progress", progress);
+    if (error) json.field("error", error);
+    json.field("version", VWIRE_VERSION);
+    json.endObject();
+  });
   VWIRE_LOGF("[Vwire] OTA Status: %s %d%%", status, progress);
 }
 
@@ -231,90 +463,493 @@ void VwireOTAAddon::_handleCloudOTA(const char* payload) {
     return;
   }
 
+  const char* action = doc["action"];
   const char* url = doc["url"];
   const char* version = doc["version"];
   int size = doc["size"] | 0;
   const char* updateId = doc["updateId"];
+  const char* md5 = doc["md5"];
+  const char* sha256 = doc["sha256"];
+  unsigned long window = doc["window"] | 0UL;
+  bool stage = doc["stage"] | false;
+
+  if (action && updateId) {
+    _handleCloudAction(action, updateId);
+    return;
+  }
   if (!url || !updateId) {
     VWIRE_LOG("[Vwire] OTA command missing required fields");
     return;
   }
+  if (sha256 && strlen(sha256) != 64) {
+    _publishOTAStatus(updateId, "failed", 0, "Invalid sha256");
+    return;
+  }
+  if (md5 && strlen(md5) != 32) {
+    _publishOTAStatus(updateId, "failed", 0, "Invalid md5");
+    return;
+  }
+
+  if (_cloudState != CLOUD_IDLE) {
+    if (_cloudState == CLOUD_REBOOT || strcmp(updateId, _updateId) == 0) {
+      VWIRE_LOG("[Vwire] OTA: update already in progress");
+      return;
+    }
+    _failCloud("Superseded by a new update");
+  }
+
+  if (!_chunk) {
+    _chunk = (uint8_t*)_allocateBuffer(VWIRE_OTA_CHUNK_SIZE);
+  }
+  bool hashed = sha256 || md5;
+  if (hashed && !_sha) {
+    _sha = (VwireOTAHash*)_allocateBuffer(sizeof(VwireOTAHash));
+  }
+  if (!_chunk || (hashed && !_sha)) {
+    _releaseCloud();
+    _publishOTAStatus(updateId, "failed", 0, "Out of memory");
+    return;
+  }
+  _checkSha = sha256 != nullptr;
+  if (_checkSha) {
+    _hashBegin(*_sha, sha256);
+  }
+  _checkMd5 = md5 != nullptr;
+  if (_checkMd5) {
+    _md5Begin(*_sha, md5);
+  }
+
+  strncpy(_updateId, updateId, sizeof(_updateId) - 1);
+  _updateId[sizeof(_updateId) - 1] = '\0';
+  _cloudUrl = url;
+  _total = 0;
+  _received = 0;
+  _skip = 0;
+  _retries = 0;
+  _reported = 0;
+  _imageOpen = false;
+  _gzip = false;
+  _stageOnly = stage;
+  _cloudState = CLOUD_CONNECT;
+  // Spread a fleet rollout over the window instead of starting together
+  _cloudDeadline = millis() + (window > 0 ? (unsigned long)random((long)(window * 1000UL)) : 0);
 
   VWIRE_LOGF("[Vwire] OTA: url=%s", url);
-  VWIRE_LOGF("[Vwire] OTA: version=%s size=%d", version ? version : "?", size);
+  VWIRE_LOGF("[Vwire] OTA: version=%s size=%d%s", version ? version : "?", size,
+             stage ? " (download only)" : "");
+  if (window > 0) {
+    VWIRE_LOGF("[Vwire] OTA: starting in %lu s", (_cloudDeadline - millis()) / 1000);
+  }
   _publishOTAStatus(updateId, "downloading", 0);
-  _vwire->_mqttClient.loop();
-  delay(100);
+}
+
+void VwireOTAAddon::_handleCloudAction(const char* action, const char* updateId) {
+  bool current = _cloudState != CLOUD_IDLE && strcmp(updateId, _updateId) == 0;
+
+  if (strcmp(action, "activate") == 0) {
+    if (!current) {
+      _publishOTAStatus(updateId, "failed", 0, "No staged update");
+    } else if (_cloudState == CLOUD_STAGED) {
+      VWIRE_LOG("[Vwire] OTA: activating staged update");
+      _activateImage();
+    } else if (_cloudState != CLOUD_REBOOT) {
+      _stageOnly = false;              // Still downloading: install when done
+      VWIRE_LOG("[Vwire] OTA: will install when the download completes");
+    }
+  } else if (strcmp(action, "cancel") == 0) {
+    if (current && _cloudState != CLOUD_REBOOT) {
+      _failCloud("Cancelled");
+    }
+  } else {
+    VWIRE_LOGF("[Vwire] OTA: unknown action '%s'", action);
+  }
+}
 
-  bool useHttps = strncmp(url, "https", 5) == 0;
-  WiFiClient plainClient;
-  WiFiClientSecure secureClient;
+// -----------------------------------------------------------------------------
+// Download engine, one step per onRun()
+// -----------------------------------------------------------------------------
+
+void VwireOTAAddon::_runCloud() {
+  switch (_cloudState) {
+    case CLOUD_CONNECT:
+      if ((long)(millis() - _cloudDeadline) >= 0) {
+        _openDownload();
+      }
+      break;
+    case CLOUD_DOWNLOAD:
+      _readDownload();
+      break;
+    case CLOUD_STAGED:
+      break;                           // Waiting for "activate"
+    case CLOUD_REBOOT:
+      if ((long)(millis() - _cloudDeadline) >= 0) {
+        ESP.restart();
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Blocks for at most VWIRE_OTA_HTTP_TIMEOUT while connecting and reading
+// the response headers
+bool VwireOTAAddon::_openDownload() {
+  bool useHttps = strncmp(_cloudUrl.c_str(), "https", 5) == 0;
   if (useHttps) {
-    secureClient.setInsecure();
+    WiFiClientSecure* secureClient = new WiFiClientSecure();
+    secureClient->setInsecure();
+    _httpClient = secureClient;
     VWIRE_LOG("[Vwire] OTA: Using HTTPS for firmware download");
+  } else {
+    _httpClient = new WiFiClient();
   }
-  WiFiClient& updateClient = useHttps ? (WiFiClient&)secureClient : plainClient;
 
+  _http = new HTTPClient();
+  _http->setTimeout(VWIRE_OTA_HTTP_TIMEOUT);
   #if defined(VWIRE_BOARD_ESP32)
-  #ifdef LED_BUILTIN
-  httpUpdate.setLedPin(LED_BUILTIN, LOW);
+  _http->setConnectTimeout(VWIRE_OTA_HTTP_TIMEOUT);
   #endif
-  httpUpdate.rebootOnUpdate(false);
-  t_httpUpdate_return ret = httpUpdate.update(updateClient, url);
-  _ensureMqttForOTA();
-
-  switch (ret) {
-    case HTTP_UPDATE_FAILED:
-      VWIRE_LOGF("[Vwire] OTA FAILED: (%d) %s",
-                           httpUpdate.getLastError(), httpUpdate.getLastErrorString().c_str());
-      _publishOTAStatus(updateId, "failed", 0, httpUpdate.getLastErrorString().c_str());
-      _vwire->_mqttClient.loop();
-      delay(200);
-      break;
-    case HTTP_UPDATE_NO_UPDATES:
-      VWIRE_LOG("[Vwire] OTA: No update available");
-      _publishOTAStatus(updateId, "failed", 0, "No update available");
-      _vwire->_mqttClient.loop();
-      delay(200);
-      break;
-    case HTTP_UPDATE_OK:
-      VWIRE_LOG("[Vwire] OTA SUCCESS - Rebooting...");
-      _publishOTAStatus(updateId, "completed", 100);
-      _vwire->_mqttClient.loop();
-      delay(1000);
-      ESP.restart();
-      break;
+  _http->setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  if (!_http->begin(*_httpClient, _cloudUrl)) {
+    _failCloud("Invalid firmware URL");
+    return false;
+  }
+
+  const char* headers[] = { "Content-Range", "Retry-After" };
+  _http->collectHeaders(headers, 2);
+  if (_received > 0) {
+    char range[32];
+    snprintf(range, sizeof(range), "bytes=%lu-", (unsigned long)_received);
+    _http->addHeader("Range", range);
+  }
+
+  int code = _http->GET();
+  unsigned long total = 0;
+  if (code == 200) {
+    // Full body: a server without Range support resends from byte 0
+    _skip = _received;
+    int size = _http->getSize();
+    total = size > 0 ? (unsigned long)size : 0;
+  } else if (code == 206) {
+    // "bytes <first>-<last>/<total>"
+    unsigned long first = 0;
+    String contentRange = _http->header("Content-Range");
+    if (sscanf(contentRange.c_str(), "bytes %lu-%*u/%lu", &first, &total) != 2 || first > _received) {
+      _retryDownload("Bad Content-Range");
+      return false;
+    }
+    _skip = _received - first;
+  } else if ((code == 429 || code == 503) && _http->header("Retry-After").toInt() > 0) {
+    // Server is limiting concurrent downloads: wait as long as it asks
+    unsigned long after = (unsigned long)_http->header("Retry-After").toInt();
+    char reason[32];
+    snprintf(reason, sizeof(reason), "HTTP %d", code);
+    _retryDownload(reason, (after < 3600UL ? after : 3600UL) * 1000UL);
+    return false;
+  } else if (code >= 400 && code < 500 && code != 408 && code != 429) {
+    char error[32];
+    snprintf(error, sizeof(error), "HTTP error %d", code);
+    _failCloud(error);
+    return false;
+  } else {
+    String reason = code < 0 ? HTTPClient::errorToString(code) : String("HTTP error ") + String(code);
+    _retryDownload(reason.c_str());
+    return false;
+  }
+
+  if (total == 0) {
+    _failCloud("Server did not send the firmware size");
+    return false;
+  }
+  if (_total != 0 && total != _total) {
+    _failCloud("Firmware changed on the server");
+    return false;
+  }
+
+  if (_received > 0) {
+    VWIRE_LOGF("[Vwire] OTA: resuming at %lu of %lu bytes", (unsigned long)_received, total);
+  }
+  _total = total;
+  _lastData = millis();
+  _cloudState = CLOUD_DOWNLOAD;
+  return true;
+}
+
+void VwireOTAAddon::_readDownload() {
+  WiFiClient* stream = _http->getStreamPtr();
+  unsigned long sliceStart = millis();
+
+  while (millis() - sliceStart < VWIRE_OTA_SLICE_MS) {
+    int available = stream ? stream->available() : 0;
+    if (available <= 0) {
+      if (!stream || !stream->connected()) {
+        _retryDownload("Connection lost");
+      } else if (millis() - _lastData >= VWIRE_OTA_STALL_TIMEOUT) {
+        _retryDownload("Download stalled");
+      }
+      return;
+    }
+
+    int count = stream->read(_chunk, available < VWIRE_OTA_CHUNK_SIZE ? available : VWIRE_OTA_CHUNK_SIZE);
+    if (count <= 0) {
+      return;
+    }
+    _lastData = millis();
+    _retries = 0;
+
+    uint8_t* data = _chunk;
+    size_t length = (size_t)count;
+    if (_skip > 0) {
+      size_t drop = _skip < length ? _skip : length;
+      _skip -= drop;
+      data += drop;
+      length -= drop;
+    }
+    if (length > _total - _received) {
+      length = _total - _received;
+    }
+    if (length == 0) {
+      continue;
+    }
+
+    if (!_imageOpen && !_beginImage(data, length)) return;
+    if (!_writeImage(data, length)) return;
+    if (_checkSha) {
+      _hashUpdate(*_sha, data, length);
+    }
+    if (_checkMd5) {
+      _md5Update(*_sha, data, length);
+    }
+    _received += length;
+
+    int progress = cloudProgress();
+    if (progress < 100 && progress >= _reported + VWIRE_OTA_PROGRESS_STEP) {
+      _reported = (int8_t)progress;
+      _publishOTAStatus(_updateId, "downloading", progress);
+    }
+
+    if (_received >= _total) {
+      _finishDownload();
+      return;
+    }
+    if (_stageOnly) {
+      return;                          // Background download: one chunk per run()
+    }
+  }
+}
+
+void VwireOTAAddon::_finishDownload() {
+  _closeDownload();
+
+  #if VWIRE_OTA_HAS_INFLATE
+  if (_gzip && _inflate->state != GZ_TRAILER) {
+    _failCloud("Truncated gzip image");
+    return;
   }
-  #elif defined(VWIRE_BOARD_ESP8266)
+  #endif
+  if (_checkSha && !_hashMatches(*_sha)) {
+    _failCloud("SHA-256 mismatch");
+    return;
+  }
+  if (_checkMd5 && !_md5Matches(*_sha)) {
+    _failCloud("MD5 mismatch");
+    return;
+  }
+
+  if (!_stageOnly) {
+    _activateImage();
+    return;
+  }
+
+  // Keep the updater open: finishing it would select the new image for the
+  // next boot, which has to wait for "activate"
+  _releaseCloud();
+  _cloudState = CLOUD_STAGED;
+  VWIRE_LOG("[Vwire] OTA: image staged, waiting for activate");
+  _publishOTAStatus(_updateId, "staged", 100);
+}
+
+void VwireOTAAddon::_activateImage() {
+  if (!Update.end(true)) {
+    _failCloud(_updateError().c_str());
+    return;
+  }
+  _imageOpen = false;
+
+  VWIRE_LOG("[Vwire] OTA SUCCESS - Rebooting...");
+  _publishOTAStatus(_updateId, "completed", 100);
+  _releaseCloud();
+  _cloudState = CLOUD_REBOOT;
+  _cloudDeadline = millis() + 1000;    // Let the status publish leave first
+}
+
+void VwireOTAAddon::_retryDownload(const char* reason, unsigned long retryAfterMs) {
+  _closeDownload();
+  if (retryAfterMs == 0 && ++_retries > VWIRE_OTA_MAX_RETRIES) {
+    _failCloud(reason);
+    return;
+  }
+
+  unsigned long backoff = retryAfterMs;
+  if (backoff == 0) {
+    backoff = 2000UL << (_retries < 6 ? _retries - 1 : 5);
+    if (backoff > 60000UL) backoff = 60000UL;
+  }
+  VWIRE_LOGF("[Vwire] OTA: %s at %lu bytes, retry %d in %lu s",
+             reason, (unsigned long)_received, _retries, backoff / 1000);
+  _cloudDeadline = millis() + backoff;
+  _cloudState = CLOUD_CONNECT;
+}
+
+void VwireOTAAddon::_failCloud(const char* error) {
+  VWIRE_LOGF("[Vwire] OTA FAILED: %s", error);
+  _publishOTAStatus(_updateId, "failed", 0, error);
+
+  _closeDownload();
+  if (_imageOpen) {
+    #if defined(VWIRE_BOARD_ESP32)
+    Update.abort();
+    #else
+    Update.end(false);                 // Incomplete image: resets the updater
+    #endif
+    _imageOpen = false;
+  }
+  _releaseCloud();
+  _cloudState = CLOUD_IDLE;
+}
+
+void VwireOTAAddon::_closeDownload() {
+  if (_http) {
+    _http->end();
+    delete _http;
+    _http = nullptr;
+  }
+  if (_httpClient) {
+    _httpClient->stop();
+    delete _httpClient;
+    _httpClient = nullptr;
+  }
+}
+
+void VwireOTAAddon::_releaseCloud() {
+  _closeDownload();
+  // Arena buffers stay with the addon for the next update
+  if (!_vwire->_arenaOwns(_chunk)) {
+    free(_chunk);
+    _chunk = nullptr;
+  }
+  if (!_vwire->_arenaOwns(_sha)) {
+    free(_sha);
+    _sha = nullptr;
+  }
+  free(_inflate);
+  _inflate = nullptr;
+  _checkSha = false;
+  _checkMd5 = false;
+  _cloudUrl = String();
+}
+
+void* VwireOTAAddon::_allocateBuffer(size_t size) {
+  void* block = _vwire->_arenaAllocate(size, "ota");
+  return block ? block : malloc(size);
+}
+
+size_t VwireOTAAddon::arenaDemand() {
+  return VWIRE_OTA_CHUNK_SIZE + 7 + sizeof(VwireOTAHash);   // 7: alignment of the second carve
+}
+
+// -----------------------------------------------------------------------------
+// Update partition
+// -----------------------------------------------------------------------------
+
+bool VwireOTAAddon::_beginImage(const uint8_t* data, size_t length) {
+  _gzip = length >= 2 && data[0] == 0x1F && data[1] == 0x8B;
+  size_t imageSize = _total;
+
+  #if defined(VWIRE_BOARD_ESP32)
+  if (_gzip) {
+    #if VWIRE_OTA_HAS_INFLATE
+    _inflate = (VwireOTAInflate*)malloc(sizeof(VwireOTAInflate));
+    if (!_inflate) {
+      _failCloud("Out of memory for gzip image");
+      return false;
+    }
+    tinfl_init(&_inflate->decomp);
+    _inflate->windowPos = 0;
+    _inflate->state = GZ_FIXED;
+    _inflate->flags = 0;
+    _inflate->count = 0;
+    _inflate->extra = 0;
+    imageSize = UPDATE_SIZE_UNKNOWN;   // Inflated size is not known up front
+    VWIRE_LOG("[Vwire] OTA: gzip image, inflating on the fly");
+    #else
+    _failCloud("gzip images are not supported on this board");
+    return false;
+    #endif
+  }
+  #endif
+  // ESP8266 writes gzip images as they are; eboot inflates them at boot
+
   #ifdef LED_BUILTIN
-  ESPhttpUpdate.setLedPin(LED_BUILTIN, LOW);
+  bool started = Update.begin(imageSize, U_FLASH, LED_BUILTIN, LOW);
+  #else
+  bool started = Update.begin(imageSize);
   #endif
-  ESPhttpUpdate.rebootOnUpdate(false);
-  t_httpUpdate_return ret = ESPhttpUpdate.update(updateClient, url);
-  _ensureMqttForOTA();
-
-  switch (ret) {
-    case HTTP_UPDATE_FAILED:
-      VWIRE_LOGF("[Vwire] OTA FAILED: (%d) %s",
-                           ESPhttpUpdate.getLastError(), ESPhttpUpdate.getLastErrorString().c_str());
-      _publishOTAStatus(updateId, "failed", 0, ESPhttpUpdate.getLastErrorString().c_str());
-      _vwire->_mqttClient.loop();
-      delay(200);
-      break;
-    case HTTP_UPDATE_NO_UPDATES:
-      VWIRE_LOG("[Vwire] OTA: No update available");
-      _publishOTAStatus(updateId, "failed", 0, "No update available");
-      _vwire->_mqttClient.loop();
-      delay(200);
-      break;
-    case HTTP_UPDATE_OK:
-      VWIRE_LOG("[Vwire] OTA SUCCESS - Rebooting...");
-      _publishOTAStatus(updateId, "completed", 100);
-      _vwire->_mqttClient.loop();
-      delay(1000);
-      ESP.restart();
-      break;
+  if (!started) {
+    _failCloud(_updateError().c_str());
+    return false;
   }
+  _imageOpen = true;
+  return true;
+}
+
+bool VwireOTAAddon::_writeImage(uint8_t* data, size_t length) {
+  #if VWIRE_OTA_HAS_INFLATE
+  if (_gzip) {
+    VwireOTAInflate& z = *_inflate;
+    size_t used = _gzipHeader(z, data, length);
+    data += used;
+    length -= used;
+
+    while (z.state == GZ_BODY) {
+      size_t inSize = length;
+      size_t outSize = TINFL_LZ_DICT_SIZE - z.windowPos;
+      tinfl_status status = tinfl_decompress(&z.decomp, data, &inSize, z.window,
+                                             z.window + z.windowPos, &outSize,
+                                             TINFL_FLAG_HAS_MORE_INPUT);
+      data += inSize;
+      length -= inSize;
+      if (outSize > 0 && Update.write(z.window + z.windowPos, outSize) != outSize) {
+        _failCloud(_updateError().c_str());
+        return false;
+      }
+      z.windowPos = (z.windowPos + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+
+      if (status == TINFL_STATUS_DONE) {
+        z.state = GZ_TRAILER;          // CRC32 and size follow; flash is verified by Update
+      } else if (status < TINFL_STATUS_DONE) {
+        _failCloud("Corrupt gzip image");
+        return false;
+      } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+        break;
+      }
+    }
+    return true;
+  }
+  #endif
+
+  if (Update.write(data, length) != length) {
+    _failCloud(_updateError().c_str());
+    return false;
+  }
+  return true;
+}
+
+String VwireOTAAddon::_updateError() {
+  #if defined(VWIRE_BOARD_ESP32)
+  return String(Update.errorString());
+  #else
+  return Update.getErrorString();
   #endif
 }
 #endif
@@ -375,4 +1010,8 @@ void VwireClass::disableCloudOTA() {
 bool VwireClass::isCloudOTAEnabled() {
   return _otaFeature ? _otaFeature->isCloudEnabled() : false;
 }
+
+int VwireClass::getCloudOTAProgress() {
+  return _otaFeature ? _otaFeature->cloudProgress() : -1;
+}
 #endif
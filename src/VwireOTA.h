@@ -27,6 +27,12 @@
 #include <Arduino.h>
 #include "Vwire.h"
 
+#if VWIRE_ENABLE_CLOUD_OTA
+class HTTPClient;
+struct VwireOTAInflate;
+struct VwireOTAHash;
+#endif
+
 // =============================================================================
 // VWIRE OTA ADDON
 // =============================================================================
@@ -38,6 +44,17 @@
  * - Local OTA via ArduinoOTA on supported boards
  * - Cloud OTA commands received over MQTT
  * - OTA status publishing back to the Vwire platform
+ *
+ * Cloud OTA downloads run from onRun() a slice at a time, so MQTT and the
+ * sketch keep running. Dropped or stalled connections resume with an HTTP
+ * Range request. gzip images are accepted on both boards: ESP8266 passes
+ * them to the updater (eboot inflates at boot), ESP32 inflates them while
+ * writing the update partition.
+ *
+ * Staged rollouts: a command with "stage":true downloads and verifies the
+ * image in the background and keeps it open until an "activate" action,
+ * so the only downtime is the reboot. "window" delays the start by a
+ * random 0..window seconds to spread a fleet over the CDN.
  */
 
 class VwireOTAAddon : public VwireOTAFeature {
@@ -54,7 +71,8 @@ public:
 
   void onAttach(VwireClass& vwire) override;
   void onConnect() override;
-  bool onMessage(const char* topic, const char* payload) override;
+  using VwireAddon::onMessage;
+  bool onMessage(const VwireMessage& message) override;
   void onRun() override;
 
   #if VWIRE_HAS_OTA
@@ -82,6 +100,12 @@ public:
 
   /** @brief Check whether Cloud OTA is currently enabled */
   bool isCloudEnabled() const override;
+
+  /** @brief Download progress 0-100, or -1 when no update is running */
+  int cloudProgress() const override;
+
+  /** @brief Arena bytes a download carves: read chunk and SHA-256/MD5 state */
+  static size_t arenaDemand();
   #endif
 
 private:
@@ -92,9 +116,51 @@ private:
   #endif
 
   #if VWIRE_ENABLE_CLOUD_OTA
+  enum CloudState : uint8_t {
+    CLOUD_IDLE,
+    CLOUD_CONNECT,                     // (Re)open the download at _received
+    CLOUD_DOWNLOAD,                    // Stream body slices into the updater
+    CLOUD_STAGED,                      // Downloaded and verified, waiting for "activate"
+    CLOUD_REBOOT                       // Completed, restart at _cloudDeadline
+  };
+
   bool _cloudEnabled;
+  uint8_t _cloudState;
+  String _cloudUrl;
+  char _updateId[48];
+  WiFiClient* _httpClient;
+  HTTPClient* _http;
+  uint8_t* _chunk;
+  uint32_t _total;                     // Download size in bytes
+  uint32_t _received;                  // Bytes downloaded (resume offset)
+  uint32_t _skip;                      // Bytes to drop when Range was ignored
+  uint8_t _retries;
+  int8_t _reported;                    // Last progress published
+  unsigned long _cloudDeadline;        // Next connect attempt / reboot
+  unsigned long _lastData;
+  bool _imageOpen;
+  bool _gzip;
+  bool _stageOnly;                     // Download now, install on "activate"
+  VwireOTAInflate* _inflate;
+  VwireOTAHash* _sha;                  // SHA-256 and MD5 state of the download
+  bool _checkSha;                      // Command carried a sha256
+  bool _checkMd5;                      // Command carried an md5
+
   void _handleCloudOTA(const char* payload);
-  void _ensureMqttForOTA();
+  void _handleCloudAction(const char* action, const char* updateId);
+  void _runCloud();
+  bool _openDownload();
+  void _readDownload();
+  bool _writeImage(uint8_t* data, size_t length);
+  bool _beginImage(const uint8_t* data, size_t length);
+  void _finishDownload();
+  void _activateImage();
+  void _retryDownload(const char* reason, unsigned long retryAfterMs = 0);
+  void _failCloud(const char* error);
+  void _closeDownload();
+  void _releaseCloud();
+  void* _allocateBuffer(size_t size);
+  static String _updateError();
   void _publishOTAStatus(const char* updateId, const char* status, int progress,
                          const char* error = nullptr);
   #endif
@@ -0,0 +1,355 @@
+/*
+ * Vwire IOT Arduino Library - Offline Queue Addon Implementation
+ *
+ * Flash ring-buffer journal for pin writes made while disconnected, replayed
+ * through the batch publisher after reconnecting.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "VwireOfflineQueue.h"
+#include "VwireConfigStore.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _vwire->_debugPrint(message)
+  #define VWIRE_LOGF(...) _vwire->_debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_OFFLINE_QUEUE
+
+#define VWIRE_OFFLINE_JOURNAL_PATH "/vwire_q.dat"
+
+// =============================================================================
+// DEFAULT ADDON INSTANCE
+// =============================================================================
+
+static VwireOfflineQueueAddon _vwireDefaultOfflineQueue;
+
+// =============================================================================
+// CONSTRUCTOR / REGISTRATION
+// =============================================================================
+
+VwireOfflineQueueAddon::VwireOfflineQueueAddon()
+  : _vwire(nullptr)
+  , _enabled(false)
+  , _mounted(false)
+  , _headSeq(1)
+  , _tailSeq(1)
+  , _boot(0)
+  , _drainBatch(VWIRE_DEFAULT_OFFLINE_DRAIN_BATCH)
+  , _drainInterval(VWIRE_DEFAULT_OFFLINE_DRAIN_INTERVAL)
+  , _lastDrain(0) {
+}
+
+void VwireOfflineQueueAddon::begin(VwireClass& vwire) {
+  _vwire = &vwire;
+  vwire.addAddon(*this);
+}
+
+void VwireOfflineQueueAddon::onAttach(VwireClass& vwire) {
+  _vwire = &vwire;
+}
+
+// =============================================================================
+// CONFIGURATION / STATUS
+// =============================================================================
+
+bool VwireOfflineQueueAddon::begin() {
+  if (!_mounted) {
+    _mounted = _mount();
+  }
+  return _mounted;
+}
+
+void VwireOfflineQueueAddon::setEnabled(bool enable) {
+  _enabled = enable;
+}
+
+bool VwireOfflineQueueAddon::isEnabled() const {
+  return _enabled;
+}
+
+void VwireOfflineQueueAddon::setDrainRate(uint8_t perBatch, unsigned long interval) {
+  _drainBatch = perBatch > 0 ? perBatch : 1;
+  _drainInterval = interval;
+}
+
+uint32_t VwireOfflineQueueAddon::getQueuedCount() const {
+  return _headSeq - _tailSeq;
+}
+
+void VwireOfflineQueueAddon::clear() {
+  _tailSeq = _headSeq;
+  if (_mounted) {
+    _writeIndex();
+  }
+}
+
+bool VwireOfflineQueueAddon::store(uint8_t pin, const char* value) {
+  if (!_enabled || !_mounted) return false;
+
+  Record record;
+  memset(&record, 0, sizeof(record));
+  record.seq = _headSeq;
+  record.stamp = millis();
+  record.boot = _boot;
+  record.pin = pin;
+
+  size_t len = strlen(value);
+  if (len > sizeof(record.value)) {
+    VWIRE_LOGF("[Vwire] Warning: offline value truncated (%d > %d bytes)",
+               (int)len, (int)sizeof(record.value));
+    len = sizeof(record.value);
+  }
+  record.length = (uint8_t)len;
+  memcpy(record.value, value, len);
+
+  uint32_t slot = record.seq % VWIRE_OFFLINE_QUEUE_RECORDS;
+  if (!_journal.seek(slot * sizeof(Record)) ||
+      _journal.write((const uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+    VWIRE_LOG("[Vwire] Error: offline journal write failed");
+    return false;
+  }
+  _journal.flush();
+
+  _headSeq++;
+  if (_headSeq - _tailSeq > VWIRE_OFFLINE_QUEUE_RECORDS) {
+    _tailSeq = _headSeq - VWIRE_OFFLINE_QUEUE_RECORDS;  // Oldest write overwritten
+  }
+  return true;
+}
+
+// =============================================================================
+// ADDON LIFECYCLE
+// =============================================================================
+
+void VwireOfflineQueueAddon::onConnect() {
+  if (!_enabled || !_mounted || !_vwire) return;
+
+  if (getQueuedCount() > 0) {
+    VWIRE_LOGF("[Vwire] Offline queue: replaying %lu writes",
+               (unsigned long)getQueuedCount());
+  }
+  // Start replay on the next run() instead of waiting a full interval
+  _lastDrain = millis() - _drainInterval;
+}
+
+void VwireOfflineQueueAddon::onRun() {
+  if (!_enabled || !_mounted || !_vwire) return;
+  if (_tailSeq == _headSeq) return;
+
+  unsigned long now = millis();
+  if (now - _lastDrain < _drainInterval) return;
+  _lastDrain = now;
+  _drain();
+}
+
+// =============================================================================
+// INTERNAL HELPERS
+// =============================================================================
+
+uint32_t VwireOfflineQueueAddon::_layoutMagic() {
+  // Changing the record layout or capacity invalidates an existing journal
+  return ((uint32_t)0x5651 << 16) ^ ((uint32_t)sizeof(Record) << 10) ^
+         (uint32_t)VWIRE_OFFLINE_QUEUE_RECORDS;
+}
+
+bool VwireOfflineQueueAddon::_mount() {
+  #if defined(VWIRE_BOARD_ESP32)
+  if (!LittleFS.begin(true)) {     // Format on first use
+  #else
+  if (!LittleFS.begin()) {
+  #endif
+    VWIRE_LOG("[Vwire] Error: LittleFS mount failed, offline queue unavailable");
+    return false;
+  }
+
+  const uint32_t magic = _layoutMagic();
+  const size_t journalSize = (size_t)VWIRE_OFFLINE_QUEUE_RECORDS * sizeof(Record);
+
+  Index index;
+  memset(&index, 0, sizeof(index));
+  bool valid = VwireStore.get(VWIRE_CONFIG_OFFLINE_INDEX, &index, sizeof(index)) == sizeof(index) &&
+               index.magic == magic;
+
+  if (valid) {
+    _journal = LittleFS.open(VWIRE_OFFLINE_JOURNAL_PATH, "r+");
+    valid = _journal && _journal.size() == journalSize;
+    if (!valid && _journal) _journal.close();
+  }
+
+  if (!valid) {
+    // First use or layout changed: start an empty journal
+    _journal = LittleFS.open(VWIRE_OFFLINE_JOURNAL_PATH, "w");
+    if (!_journal) {
+      VWIRE_LOG("[Vwire] Error: cannot create offline journal");
+      return false;
+    }
+    Record empty;
+    memset(&empty, 0, sizeof(empty));
+    for (uint32_t i = 0; i < VWIRE_OFFLINE_QUEUE_RECORDS; i++) {
+      _journal.write((const uint8_t*)&empty, sizeof(empty));
+    }
+    _journal.close();
+    _journal = LittleFS.open(VWIRE_OFFLINE_JOURNAL_PATH, "r+");
+    if (!_journal) return false;
+    index.tailSeq = 1;
+    index.boot = 0;
+  }
+
+  // The write position is not persisted: recover it as the highest
+  // sequence number in the journal.
+  uint32_t maxSeq = 0;
+  Record record;
+  _journal.seek(0);
+  for (uint32_t i = 0; i < VWIRE_OFFLINE_QUEUE_RECORDS; i++) {
+    if (_journal.read((uint8_t*)&record, sizeof(record)) != sizeof(record)) break;
+    if (record.seq > maxSeq) maxSeq = record.seq;
+  }
+
+  _tailSeq = index.tailSeq > 0 ? index.tailSeq : 1;
+  _headSeq = maxSeq + 1;
+  if (_headSeq < _tailSeq) _headSeq = _tailSeq;
+  if (_headSeq - _tailSeq > VWIRE_OFFLINE_QUEUE_RECORDS) {
+    _tailSeq = _headSeq - VWIRE_OFFLINE_QUEUE_RECORDS;
+  }
+  _boot = index.boot + 1;     // Ages from earlier boots are unknown
+  _writeIndex();
+
+  VWIRE_LOGF("[Vwire] Offline queue mounted: %lu writes pending",
+             (unsigned long)getQueuedCount());
+  return true;
+}
+
+bool VwireOfflineQueueAddon::_readRecord(uint32_t seq, Record& record) {
+  uint32_t slot = seq % VWIRE_OFFLINE_QUEUE_RECORDS;
+  if (!_journal.seek(slot * sizeof(Record))) return false;
+  if (_journal.read((uint8_t*)&record, sizeof(record)) != sizeof(record)) return false;
+  return record.seq == seq && record.length <= sizeof(record.value);
+}
+
+bool VwireOfflineQueueAddon::_writeIndex() {
+  Index index;
+  memset(&index, 0, sizeof(index));
+  index.magic = _layoutMagic();
+  index.tailSeq = _tailSeq;
+  index.boot = _boot;
+
+  // One appended record in the config store, no filesystem metadata update
+  return VwireStore.put(VWIRE_CONFIG_OFFLINE_INDEX, &index, sizeof(index));
+}
+
+void VwireOfflineQueueAddon::_drain() {
+  uint32_t startSeq = _tailSeq;
+  unsigned long now = millis();
+  char value[VWIRE_OFFLINE_VALUE_SIZE + 1];
+  bool ok = true;
+
+  #if VWIRE_ENABLE_BATCH
+  // Keep live writes out of the replay frame
+  _vwire->_batchFlush();
+  _vwire->_batchLost = false;
+  #endif
+
+  for (uint8_t sent = 0; sent < _drainBatch && _tailSeq != _headSeq; sent++, _tailSeq++) {
+    Record record;
+    if (!_readRecord(_tailSeq, record)) continue;   // Overwritten or corrupt slot
+    memcpy(value, record.value, record.length);
+    value[record.length] = '\0';
+
+    #if VWIRE_ENABLE_BATCH
+    long age = (record.boot == _boot) ? (long)(now - record.stamp) : -1;
+    if (_vwire->_batchAppend(record.pin, value, age)) continue;
+    #else
+    (void)now;
+    #endif
+    if (!_vwire->_publishPin(record.pin, value)) {
+      ok = false;
+      break;                           // The tail stays on this record
+    }
+  }
+
+  #if VWIRE_ENABLE_BATCH
+  // _batchAppend() flushes by itself when the frame fills; a failure there
+  // loses the records already in that frame just the same
+  if (!_vwire->_batchFlush() || _vwire->_batchLost) {
+    // Batched records were not sent: replay this range on the next interval
+    _tailSeq = startSeq;
+    return;
+  }
+  #endif
+  _writeIndex();
+
+  if (!ok) {
+    VWIRE_LOGF("[Vwire] Offline queue: publish failed, %lu writes left",
+               (unsigned long)getQueuedCount());
+    return;
+  }
+  if (_tailSeq == _headSeq) {
+    VWIRE_LOG("[Vwire] Offline queue drained");
+  }
+}
+
+#endif // VWIRE_ENABLE_OFFLINE_QUEUE
+
+// =============================================================================
+// VwireClass BRIDGE METHODS
+// =============================================================================
+
+bool VwireClass::_ensureOfflineQueue() {
+#if VWIRE_ENABLE_OFFLINE_QUEUE
+  if (_offlineQueue) {
+    return true;
+  }
+
+  _offlineQueue = &_vwireDefaultOfflineQueue;
+  _vwireDefaultOfflineQueue.begin(*this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool VwireClass::setOfflineQueue(bool enable) {
+#if VWIRE_ENABLE_OFFLINE_QUEUE
+  if (!enable) {
+    if (_offlineQueue) {
+      _offlineQueue->setEnabled(false);
+    }
+    _debugPrint("[Vwire] Offline queue: DISABLED");
+    return true;
+  }
+
+  if (_ensureOfflineQueue() && _offlineQueue->begin()) {
+    _offlineQueue->setEnabled(true);
+    _debugPrint("[Vwire] Offline queue: ENABLED");
+    return true;
+  }
+  return false;
+#else
+  (void)enable;
+  _debugPrint("[Vwire] Offline queue is not available in this build");
+  return false;
+#endif
+}
+
+void VwireClass::setOfflineDrainRate(uint8_t perBatch, unsigned long interval) {
+  if (_ensureOfflineQueue()) {
+    _offlineQueue->setDrainRate(perBatch, interval);
+  }
+}
+
+uint32_t VwireClass::getOfflineQueued() {
+  return _offlineQueue ? _offlineQueue->getQueuedCount() : 0;
+}
+
+void VwireClass::clearOfflineQueue() {
+  if (_offlineQueue) {
+    _offlineQueue->clear();
+  }
+}
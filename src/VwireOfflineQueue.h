@@ -0,0 +1,106 @@
+/*
+ * Vwire IOT Arduino Library - Offline Queue Addon
+ *
+ * Journals virtual pin writes to a ring buffer on LittleFS while the MQTT
+ * connection is down and replays them, rate limited and batched, once the
+ * device reconnects.
+ *
+ * Usage:
+ *   Vwire.setOfflineQueue(true);
+ *   Vwire.setOfflineDrainRate(16, 250);   // 16 writes every 250 ms
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_OFFLINE_QUEUE_H
+#define VWIRE_OFFLINE_QUEUE_H
+
+#include <Arduino.h>
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_OFFLINE_QUEUE
+
+#include <LittleFS.h>
+
+// =============================================================================
+// OFFLINE QUEUE ADDON
+// =============================================================================
+
+/**
+ * @brief Addon that stores pin writes in flash while disconnected
+ *
+ * The journal is a fixed-size file of VWIRE_OFFLINE_QUEUE_RECORDS records,
+ * each tagged with a sequence number. A record lives in slot seq % capacity,
+ * so appending while offline is a single record write. The replay position
+ * and a boot counter live in VwireStore, updated once per replayed batch
+ * and once per boot.
+ */
+class VwireOfflineQueueAddon : public VwireOfflineQueue {
+public:
+  /** @brief Constructor */
+  VwireOfflineQueueAddon();
+
+  /** @brief Register this addon with the Vwire core */
+  void begin(VwireClass& vwire);
+
+  // =========================================================================
+  // CONFIGURATION / STATUS
+  // =========================================================================
+
+  bool begin() override;
+  void setEnabled(bool enable) override;
+  bool isEnabled() const override;
+  void setDrainRate(uint8_t perBatch, unsigned long interval) override;
+  uint32_t getQueuedCount() const override;
+  void clear() override;
+  bool store(uint8_t pin, const char* value) override;
+
+  // =========================================================================
+  // ADDON LIFECYCLE
+  // =========================================================================
+
+  void onAttach(VwireClass& vwire) override;
+  void onConnect() override;
+  void onRun() override;
+
+private:
+  /** @brief On-flash journal record */
+  struct Record {
+    uint32_t seq;                           ///< Sequence number (0 = empty slot)
+    uint32_t stamp;                         ///< millis() when written
+    uint16_t boot;                          ///< Boot counter when written
+    uint8_t pin;                            ///< Virtual pin
+    uint8_t length;                         ///< Value length
+    char value[VWIRE_OFFLINE_VALUE_SIZE];   ///< Value (not null-terminated)
+  };
+
+  /** @brief Replay position (VwireStore key VWIRE_CONFIG_OFFLINE_INDEX) */
+  struct Index {
+    uint32_t magic;                         ///< Layout check (record size + capacity)
+    uint32_t tailSeq;                       ///< Next sequence number to replay
+    uint16_t boot;                          ///< Boot counter
+  };
+
+  VwireClass* _vwire;
+  bool _enabled;
+  bool _mounted;
+  File _journal;
+  uint32_t _headSeq;                        ///< Next sequence number to write
+  uint32_t _tailSeq;                        ///< Next sequence number to replay
+  uint16_t _boot;
+  uint8_t _drainBatch;
+  unsigned long _drainInterval;
+  unsigned long _lastDrain;
+
+  static uint32_t _layoutMagic();
+  bool _mount();
+  bool _readRecord(uint32_t seq, Record& record);
+  bool _writeIndex();
+  void _drain();
+};
+
+#endif // VWIRE_ENABLE_OFFLINE_QUEUE
+
+#endif // VWIRE_OFFLINE_QUEUE_H
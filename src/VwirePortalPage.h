@@ -0,0 +1,159 @@
+/*
+ * Vwire IOT Arduino Library - Provisioning Portal Page
+ *
+ * GENERATED by extras/portal/build_portal.py from extras/portal/index.html.
+ * Do not edit by hand.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_PORTAL_PAGE_H
+#define VWIRE_PORTAL_PAGE_H
+
+#include <Arduino.h>
+
+/** @brief ETag of the page below */
+#define VWIRE_PORTAL_PAGE_ETAG "\"6bbc38030fdb46f1\""
+
+/** @brief index.html, gzip-compressed (5229 bytes uncompressed) */
+static const uint8_t VWIRE_PORTAL_PAGE[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x58, 0xdd, 0x72, 0xe3, 0xb6,
+  0x15, 0xbe, 0xd7, 0x53, 0xc0, 0x4c, 0xb2, 0x94, 0xba, 0x22, 0x45, 0xc9, 0x5e, 0x8d, 0xab, 0x1f,
+  0xb7, 0x5d, 0xef, 0x3a, 0x71, 0xa7, 0xd9, 0xec, 0xc4, 0xde, 0x66, 0x72, 0x09, 0x91, 0xa0, 0x84,
+  0x98, 0x02, 0x58, 0x00, 0xb4, 0xac, 0x6c, 0xfc, 0x12, 0x6d, 0x67, 0x7a, 0xd3, 0x99, 0xbe, 0x5b,
+  0x9f, 0xa0, 0x8f, 0xd0, 0x73, 0x00, 0x90, 0xa2, 0x64, 0x39, 0xce, 0xec, 0xec, 0x88, 0x04, 0x0e,
+  0x0e, 0xbe, 0x73, 0xbe, 0xf3, 0x47, 0xcf, 0x4e, 0xde, 0x7d, 0x77, 0x79, 0xfb, 0xe3, 0xc7, 0xf7,
+  0x64, 0x65, 0xd6, 0xc5, 0x45, 0x67, 0x56, 0xff, 0x30, 0x9a, 0xc1, 0xcf, 0x9a, 0x19, 0x4a, 0xd2,
+  0x15, 0x55, 0x9a, 0x99, 0x79, 0xf0, 0xe9, 0xf6, 0x2a, 0x3a, 0x0f, 0xea, 0x65, 0x41, 0xd7, 0x6c,
+  0x1e, 0xdc, 0x73, 0xb6, 0x29, 0xa5, 0x32, 0x01, 0x49, 0xa5, 0x30, 0x4c, 0x80, 0xd8, 0x86, 0x67,
+  0x66, 0x35, 0xcf, 0xd8, 0x3d, 0x4f, 0x59, 0x64, 0x5f, 0xfa, 0x84, 0x0b, 0x6e, 0x38, 0x2d, 0x22,
+  0x9d, 0xd2, 0x82, 0xcd, 0x87, 0x71, 0x82, 0x6a, 0x0c, 0x37, 0x05, 0xbb, 0xf8, 0xeb, 0x0f, 0x5c,
+  0x31, 0xf2, 0xce, 0x8a, 0x93, 0x1b, 0x66, 0xaa, 0x72, 0x36, 0x70, 0x3b, 0x9d, 0x99, 0x36, 0x5b,
+  0xfc, 0xfd, 0x1d, 0xf9, 0x4c, 0x16, 0xf2, 0x21, 0xd2, 0xfc, 0x67, 0x2e, 0x96, 0x13, 0x78, 0x56,
+  0x19, 0x53, 0x11, 0x2c, 0x4d, 0xc9, 0x9a, 0xaa, 0x25, 0x17, 0x13, 0x92, 0x4c, 0x49, 0x49, 0xb3,
+  0xcc, 0xee, 0xc3, 0xf3, 0x63, 0x67, 0x21, 0xb3, 0x2d, 0xf9, 0xdc, 0xc9, 0x01, 0x56, 0x94, 0xd3,
+  0x35, 0x2f, 0xb6, 0x13, 0x12, 0xd1, 0xb2, 0x2c, 0x58, 0xa4, 0xb7, 0xda, 0xb0, 0x75, 0x9f, 0xbc,
+  0x2d, 0xb8, 0xb8, 0xfb, 0x96, 0xa6, 0x37, 0xf6, 0xfd, 0x0a, 0x24, 0xfb, 0x24, 0xbc, 0x61, 0x4b,
+  0xc9, 0xc8, 0xa7, 0xeb, 0xb0, 0x4f, 0xbe, 0x97, 0x0b, 0x69, 0x64, 0x9f, 0x68, 0x2a, 0x74, 0xa4,
+  0x99, 0xe2, 0xf9, 0xb4, 0xb3, 0xa0, 0xe9, 0xdd, 0x52, 0xc9, 0x4a, 0x64, 0x13, 0x02, 0xc7, 0x19,
+  0x55, 0xd1, 0x52, 0xd1, 0x8c, 0x83, 0xe9, 0xdd, 0xe1, 0xe9, 0x9b, 0x8c, 0x2d, 0xfb, 0xe4, 0x8b,
+  0x21, 0x1d, 0xd2, 0x11, 0x23, 0xc9, 0x57, 0xf8, 0x3c, 0x1e, 0x0d, 0x4f, 0x19, 0x19, 0x26, 0xc9,
+  0x57, 0xbd, 0x69, 0x67, 0xcd, 0x45, 0xb4, 0x62, 0x7c, 0xb9, 0x32, 0x13, 0x5c, 0xba, 0x5f, 0x4d,
+  0x3b, 0xa9, 0x2c, 0xa4, 0x9a, 0x90, 0x2f, 0xf2, 0x1c, 0xd4, 0x37, 0x36, 0x8c, 0x92, 0xf2, 0x61,
+  0xda, 0x79, 0xec, 0xc4, 0xe8, 0x57, 0x0a, 0x17, 0x29, 0x30, 0x66, 0x4d, 0x1f, 0x9c, 0x47, 0x27,
+  0xe4, 0x2c, 0xb1, 0x02, 0x8d, 0xf9, 0x84, 0x56, 0x46, 0xee, 0xc3, 0x53, 0xcb, 0x05, 0xed, 0x8e,
+  0xde, 0xbc, 0xe9, 0xd7, 0xff, 0x93, 0x38, 0x79, 0x03, 0x18, 0xbc, 0xfb, 0x10, 0x75, 0xa5, 0x01,
+  0xc6, 0x18, 0x15, 0xed, 0x2e, 0x3e, 0xc3, 0x57, 0xd4, 0x93, 0x29, 0x59, 0x46, 0x39, 0x2f, 0x0c,
+  0x03, 0x78, 0x8b, 0xa2, 0x52, 0xdd, 0x21, 0xdc, 0xd9, 0xb3, 0xa8, 0x0a, 0xb9, 0x94, 0x00, 0xc8,
+  0xb0, 0x07, 0x13, 0xd1, 0x82, 0x2f, 0x01, 0x42, 0x0a, 0x2e, 0x60, 0xaa, 0x86, 0x04, 0xec, 0x18,
+  0x23, 0xd7, 0xb5, 0xbe, 0xfa, 0xc8, 0x6a, 0x58, 0x73, 0x02, 0x64, 0xb2, 0x7a, 0xd7, 0x2e, 0x6c,
+  0xbc, 0x5b, 0xc6, 0x49, 0xb2, 0x73, 0x4a, 0x92, 0x64, 0x67, 0xe8, 0x97, 0xfa, 0x7c, 0x09, 0xc7,
+  0xeb, 0xbd, 0xf3, 0xf3, 0xf3, 0x69, 0x5b, 0xd7, 0xf0, 0x6c, 0xe7, 0x91, 0xc8, 0xc8, 0x12, 0x9c,
+  0xe4, 0xaf, 0xce, 0xa5, 0x5a, 0x47, 0xe8, 0x96, 0xd2, 0x3a, 0x71, 0x0f, 0x9f, 0x33, 0xff, 0xb1,
+  0x53, 0xd0, 0x05, 0x2b, 0x60, 0x3b, 0xe3, 0xba, 0x2c, 0xe8, 0x16, 0x2d, 0x96, 0xe9, 0xdd, 0x13,
+  0x73, 0xc6, 0x0d, 0xde, 0xf6, 0xa5, 0x35, 0x24, 0x4a, 0x29, 0xea, 0xe2, 0xa2, 0xac, 0x0c, 0xe8,
+  0xf2, 0x5c, 0x21, 0xf7, 0x2d, 0x0f, 0x0f, 0x47, 0xe5, 0x83, 0xbf, 0xd6, 0x51, 0x01, 0x4b, 0xb0,
+  0xa2, 0x65, 0xc1, 0xb3, 0x63, 0xa4, 0x0d, 0x9f, 0x72, 0x76, 0x5e, 0x73, 0xb4, 0xc7, 0x75, 0xd2,
+  0xb7, 0xff, 0xe2, 0xd3, 0xde, 0x41, 0x54, 0xb5, 0xf1, 0xda, 0x7b, 0x65, 0x65, 0x30, 0x78, 0x27,
+  0x44, 0x48, 0xc1, 0xa6, 0x1d, 0xa3, 0x20, 0xc2, 0x21, 0x43, 0xa5, 0x68, 0x92, 0xcb, 0x9e, 0x27,
+  0x49, 0x3c, 0xd2, 0x8d, 0x41, 0x93, 0x5c, 0xa6, 0x95, 0x06, 0xb3, 0xda, 0x22, 0x7b, 0x1c, 0x39,
+  0xb1, 0x09, 0xf8, 0x2f, 0x65, 0x2b, 0x59, 0x64, 0x36, 0x68, 0x6b, 0xb1, 0xf1, 0x78, 0x8c, 0x32,
+  0x8b, 0x0a, 0x1c, 0x29, 0x9e, 0x77, 0xce, 0x59, 0xdb, 0x2f, 0x0e, 0xde, 0x4b, 0xc6, 0x37, 0x08,
+  0x76, 0x88, 0x92, 0x23, 0x46, 0x1f, 0x89, 0xb2, 0x4a, 0x69, 0x3c, 0x50, 0x4a, 0xbe, 0x17, 0xbb,
+  0x36, 0x78, 0xec, 0x35, 0x6d, 0xcf, 0xc8, 0x92, 0xa6, 0xdc, 0x6c, 0x1b, 0xa7, 0x38, 0x4b, 0x26,
+  0x2b, 0x79, 0x6f, 0xed, 0xf4, 0xdb, 0x90, 0x8b, 0xf1, 0xef, 0x5b, 0xdb, 0x10, 0x4f, 0x74, 0x51,
+  0xb0, 0x0c, 0xfd, 0xd6, 0xc6, 0x7c, 0x76, 0x76, 0x36, 0xdd, 0x0f, 0xe5, 0x1a, 0x8d, 0x90, 0x98,
+  0x53, 0x85, 0xdc, 0xb0, 0xcc, 0x46, 0xaf, 0x36, 0xd4, 0x58, 0xbf, 0xb7, 0xd1, 0x1d, 0x64, 0x2d,
+  0xc6, 0xd4, 0x71, 0x47, 0x1d, 0x4b, 0xd1, 0x27, 0xf1, 0xdb, 0xdc, 0x12, 0xeb, 0x2a, 0x4d, 0x99,
+  0xd6, 0x58, 0x71, 0x9f, 0x86, 0xd7, 0x28, 0x49, 0xfa, 0xc0, 0x17, 0x84, 0xd8, 0xa8, 0x37, 0x25,
+  0x8d, 0xb7, 0xd3, 0x31, 0x16, 0xdc, 0x5a, 0x03, 0x53, 0x0a, 0x22, 0xe7, 0xc8, 0x79, 0x8c, 0xe6,
+  0xe1, 0x51, 0x0d, 0xf9, 0x78, 0x4f, 0x03, 0x17, 0xb9, 0x7c, 0x1e, 0x80, 0x4b, 0x8a, 0x7d, 0x00,
+  0xb9, 0x3d, 0xbe, 0x02, 0x16, 0x0f, 0xdc, 0xf4, 0x24, 0x5d, 0x47, 0xed, 0x74, 0xf5, 0x21, 0x19,
+  0x83, 0xc7, 0xd9, 0x6f, 0xf2, 0xef, 0xd1, 0xea, 0x9a, 0xb8, 0xac, 0x7b, 0x2e, 0x4d, 0x9f, 0xbd,
+  0x9d, 0xd2, 0x73, 0xe7, 0xf9, 0x92, 0x0b, 0x57, 0xdf, 0x9b, 0xda, 0xc3, 0x05, 0xa6, 0x67, 0xe4,
+  0x4b, 0x50, 0x9d, 0x29, 0x16, 0x52, 0xd3, 0x3d, 0xf6, 0x0a, 0xc8, 0xa8, 0x29, 0x20, 0x2e, 0xe3,
+  0x3d, 0x10, 0x30, 0xa5, 0x4e, 0x53, 0x1b, 0xc9, 0x25, 0x55, 0x10, 0x02, 0x4f, 0x70, 0xbe, 0xc1,
+  0x14, 0xa4, 0x82, 0xaf, 0xa9, 0x8b, 0x74, 0x44, 0x44, 0x86, 0xda, 0x37, 0x38, 0x40, 0x93, 0x63,
+  0x03, 0x67, 0x4d, 0x7e, 0x28, 0x07, 0xc1, 0x9a, 0x07, 0xc1, 0x6f, 0x38, 0xb4, 0xf5, 0x3a, 0xc6,
+  0xd6, 0x3c, 0xcb, 0x0a, 0x86, 0x86, 0xfd, 0xf1, 0x8e, 0x6d, 0x73, 0x05, 0x63, 0x82, 0x76, 0x0a,
+  0xa1, 0x5d, 0x20, 0xad, 0x16, 0x08, 0x56, 0x64, 0xf0, 0xa1, 0x04, 0xc2, 0x59, 0xf7, 0x74, 0x9c,
+  0x40, 0xdf, 0xec, 0x21, 0x87, 0x8f, 0x9d, 0xd9, 0xc0, 0x77, 0xfd, 0xd9, 0xc0, 0x4f, 0x21, 0xd8,
+  0xc9, 0xe1, 0x27, 0xe3, 0xf7, 0x24, 0x2d, 0xa8, 0xd6, 0xf3, 0xa0, 0xe9, 0x89, 0xc1, 0xfe, 0x3a,
+  0xb6, 0x08, 0x5c, 0x5a, 0x0d, 0xfd, 0x58, 0xe1, 0xe7, 0x09, 0x78, 0xef, 0xcc, 0xca, 0x8b, 0x4b,
+  0x09, 0x86, 0x2c, 0x2b, 0x58, 0xdf, 0xca, 0x4a, 0x91, 0x6b, 0x79, 0x4b, 0xdc, 0x98, 0x32, 0x1b,
+  0x94, 0x78, 0x1f, 0x68, 0x82, 0x1f, 0x84, 0x46, 0x78, 0x66, 0x6f, 0x01, 0xf1, 0x2b, 0x78, 0x0d,
+  0x88, 0x14, 0xba, 0x5a, 0xac, 0x39, 0x8c, 0x37, 0x0a, 0x54, 0x2a, 0x41, 0xdc, 0xab, 0xd3, 0xd8,
+  0xed, 0x1d, 0xe0, 0xd8, 0xf5, 0x1b, 0xdc, 0x70, 0x9d, 0x05, 0xd6, 0xe6, 0x81, 0xd6, 0x3c, 0x0b,
+  0x2e, 0x7e, 0xe0, 0x57, 0x9c, 0x7c, 0x60, 0x66, 0x23, 0xd5, 0x1d, 0xe9, 0xde, 0xdc, 0x5c, 0xbf,
+  0xeb, 0xcd, 0x06, 0x56, 0x0a, 0xa4, 0x5d, 0xef, 0x30, 0xdb, 0x12, 0xa6, 0x2b, 0xcc, 0xdd, 0xc0,
+  0x62, 0xb1, 0x07, 0xfd, 0xcc, 0xe5, 0x9e, 0x0b, 0xae, 0x01, 0x8d, 0x70, 0x5a, 0x74, 0x40, 0x5a,
+  0x45, 0x77, 0x1e, 0xfc, 0x88, 0xf6, 0xd9, 0x6b, 0xf0, 0x48, 0x40, 0x14, 0xfb, 0x5b, 0x05, 0xfe,
+  0xc8, 0x60, 0x5c, 0x7a, 0x28, 0x98, 0x58, 0xc2, 0x80, 0x16, 0x9c, 0x8e, 0x02, 0x3b, 0x34, 0xa4,
+  0x72, 0x0d, 0x43, 0x91, 0x01, 0xc5, 0x32, 0xcf, 0xad, 0x21, 0xd4, 0x50, 0xd4, 0x6e, 0x2f, 0x6e,
+  0x2e, 0xb8, 0x00, 0xff, 0xf8, 0x8d, 0x7d, 0x63, 0x31, 0xeb, 0x3c, 0xc8, 0x94, 0x8a, 0x6f, 0xf0,
+  0xed, 0xe2, 0x06, 0x9e, 0x04, 0x24, 0x0e, 0x5a, 0x4d, 0x6a, 0x15, 0x71, 0x1c, 0xd7, 0x3e, 0xf6,
+  0x3f, 0xbf, 0xc5, 0x65, 0x25, 0x6c, 0xc3, 0xf1, 0xda, 0x6d, 0x1f, 0xfd, 0xeb, 0x71, 0x87, 0x35,
+  0xc2, 0x16, 0xcf, 0xee, 0xcd, 0x39, 0x6e, 0xf7, 0xbe, 0xe7, 0x2c, 0xab, 0x77, 0xb7, 0xd7, 0x72,
+  0xd1, 0xf8, 0x2c, 0x78, 0x09, 0xac, 0xbd, 0xc8, 0xc8, 0x3b, 0x26, 0xbe, 0x3e, 0x02, 0xde, 0x6e,
+  0x04, 0x17, 0x7e, 0xba, 0xbd, 0xc5, 0xb7, 0x97, 0x98, 0x76, 0x47, 0x3c, 0x62, 0xff, 0xb2, 0x07,
+  0xf7, 0x4a, 0xc9, 0x35, 0x71, 0xe1, 0x9d, 0x51, 0xbd, 0x5a, 0x48, 0x8a, 0xa8, 0x8f, 0x31, 0x3c,
+  0x3e, 0x6d, 0xc1, 0xf7, 0x7d, 0xd7, 0x5d, 0xe7, 0xa2, 0xd7, 0xb3, 0x66, 0x9f, 0xdf, 0x1a, 0xc0,
+  0xb9, 0x4b, 0x90, 0x77, 0x3e, 0x2f, 0xdc, 0x29, 0x6f, 0xbd, 0x95, 0xb6, 0x25, 0x3a, 0xa8, 0x3d,
+  0x51, 0xbf, 0xda, 0x9c, 0x9d, 0x07, 0x75, 0x01, 0xb3, 0x7d, 0xdb, 0x86, 0xcc, 0xa1, 0xeb, 0xb0,
+  0xd4, 0x06, 0x76, 0xb4, 0x57, 0x52, 0x2c, 0x2f, 0x3e, 0xc0, 0xeb, 0x04, 0x53, 0xde, 0xbe, 0x91,
+  0x3f, 0xe5, 0xd0, 0x9f, 0x48, 0xea, 0x61, 0xd8, 0x6a, 0xd4, 0x27, 0x66, 0xc5, 0x7c, 0x9e, 0x92,
+  0x0d, 0x2f, 0x0a, 0x30, 0x15, 0x6e, 0x55, 0x86, 0x50, 0x91, 0xa1, 0xa8, 0x60, 0x29, 0x78, 0x51,
+  0xba, 0x9c, 0x76, 0x31, 0xef, 0x02, 0x2e, 0xee, 0x40, 0x1a, 0x10, 0x88, 0x44, 0xd4, 0x20, 0x00,
+  0x80, 0xd4, 0x0c, 0x1e, 0xb9, 0x06, 0xb2, 0x97, 0x2c, 0x6e, 0x3c, 0x33, 0x40, 0x3a, 0x77, 0x8e,
+  0xd2, 0xa9, 0xe2, 0x25, 0xc4, 0xf8, 0x3d, 0x54, 0x3e, 0xc9, 0xd6, 0x64, 0x4e, 0x72, 0x5a, 0x68,
+  0xa8, 0x68, 0x79, 0x25, 0x52, 0x44, 0x44, 0xbe, 0xec, 0xf2, 0xac, 0x07, 0x95, 0xcc, 0x97, 0x82,
+  0x0c, 0xc6, 0xa2, 0x35, 0x94, 0xd5, 0x78, 0xc9, 0xcc, 0xfb, 0x82, 0xe1, 0xe3, 0xdb, 0xed, 0x75,
+  0x86, 0x42, 0x58, 0xd2, 0x9a, 0x63, 0xb0, 0xfd, 0x67, 0x2d, 0x45, 0xb7, 0x52, 0x45, 0x1f, 0x0e,
+  0x09, 0xd6, 0xc3, 0x59, 0x98, 0x99, 0x74, 0x85, 0x4b, 0xbd, 0x18, 0x51, 0x76, 0x6b, 0xe9, 0xae,
+  0x6a, 0xdd, 0xa0, 0xe2, 0x9f, 0xf0, 0x20, 0xaa, 0xf3, 0x62, 0xf6, 0x78, 0x9c, 0x52, 0x3c, 0xdc,
+  0x1c, 0x81, 0x13, 0x8f, 0x76, 0x3c, 0xaf, 0x6f, 0x0a, 0x07, 0x8e, 0x1f, 0xf8, 0x96, 0x69, 0x84,
+  0x34, 0xde, 0xea, 0xec, 0x3a, 0x39, 0xd1, 0x31, 0x3c, 0x4d, 0x3b, 0x3c, 0x27, 0x5d, 0x78, 0xc0,
+  0x9d, 0x2f, 0xbb, 0xe1, 0x2e, 0x9a, 0xc3, 0x5e, 0x6c, 0x89, 0x8d, 0x3d, 0xaf, 0x70, 0x26, 0x44,
+  0x6a, 0xc3, 0x69, 0x23, 0x07, 0x22, 0x4d, 0xe8, 0x35, 0x9e, 0x82, 0x3a, 0x0e, 0x38, 0x06, 0x03,
+  0x72, 0xbb, 0xa3, 0x0e, 0x8b, 0x83, 0x86, 0x56, 0x62, 0xe9, 0xdc, 0x35, 0xd2, 0x29, 0xda, 0xa8,
+  0xb6, 0xa4, 0x12, 0x86, 0x5b, 0x6a, 0xab, 0xc2, 0x68, 0x02, 0x6d, 0x0a, 0x44, 0x77, 0xae, 0x2b,
+  0x24, 0xcd, 0x7c, 0xc1, 0xd4, 0x68, 0x66, 0xdb, 0x42, 0xd0, 0xfb, 0xc4, 0x3e, 0xe4, 0xce, 0x96,
+  0xb0, 0x39, 0x90, 0x15, 0xd6, 0x05, 0x28, 0x04, 0x50, 0xb8, 0x1a, 0xdb, 0x7e, 0xfb, 0xcd, 0xed,
+  0xb7, 0x7f, 0x41, 0x83, 0xc0, 0x18, 0x1d, 0x37, 0x35, 0x0a, 0x62, 0xe1, 0x3d, 0x6d, 0x3b, 0x55,
+  0xd4, 0xfa, 0x24, 0x08, 0x37, 0x54, 0xa7, 0x8a, 0x41, 0xe7, 0xf2, 0x6c, 0x77, 0x43, 0x59, 0xa2,
+  0x2c, 0xea, 0x97, 0xf1, 0x3d, 0x2d, 0x2a, 0x06, 0xb2, 0x22, 0xc6, 0x42, 0x8d, 0x2b, 0xae, 0x20,
+  0xe0, 0x8a, 0x82, 0x25, 0xf2, 0x9a, 0x84, 0x24, 0x7b, 0xbb, 0x0e, 0xe1, 0xa1, 0x2b, 0x62, 0x59,
+  0x42, 0x6c, 0xfe, 0x01, 0x60, 0x90, 0x09, 0xac, 0xff, 0xef, 0x3f, 0xff, 0xfc, 0x7b, 0x03, 0x13,
+  0xbe, 0x56, 0x99, 0xc8, 0x2e, 0x57, 0xbc, 0xc8, 0xba, 0x12, 0x89, 0xed, 0x39, 0xaa, 0x60, 0x4a,
+  0xab, 0xeb, 0xeb, 0xab, 0x57, 0xe4, 0xa4, 0x85, 0xde, 0x65, 0x3e, 0x22, 0x86, 0x2f, 0xf6, 0x5b,
+  0xbe, 0x66, 0x30, 0xe8, 0x77, 0xdb, 0xce, 0xeb, 0xc3, 0x87, 0x65, 0x92, 0xa0, 0x2e, 0xc2, 0x80,
+  0x2a, 0x47, 0x78, 0x5d, 0xb7, 0x81, 0x4b, 0xac, 0x43, 0x97, 0xee, 0x4b, 0x1e, 0x00, 0x3f, 0xd1,
+  0x6c, 0xb1, 0xd7, 0x6b, 0x50, 0xe2, 0x80, 0xc0, 0xb0, 0xa6, 0x1b, 0x3e, 0xa1, 0xf6, 0x58, 0x6a,
+  0x25, 0xcc, 0x7e, 0xb3, 0xf4, 0xfe, 0x5c, 0x18, 0xe1, 0xe8, 0x69, 0x0a, 0x10, 0x1a, 0x8e, 0x3b,
+  0x7e, 0xe0, 0x75, 0x9b, 0x2e, 0x80, 0x71, 0xb6, 0x32, 0x22, 0x6e, 0x86, 0xe9, 0x39, 0x8c, 0x11,
+  0x15, 0x73, 0x8b, 0x7b, 0x6c, 0xce, 0x60, 0xc6, 0x11, 0x4d, 0x75, 0x72, 0x93, 0x15, 0x16, 0x22,
+  0x5c, 0x6e, 0xea, 0x1b, 0x78, 0x0e, 0x9a, 0x11, 0x12, 0xef, 0x87, 0xde, 0x67, 0x82, 0xdc, 0xc2,
+  0xc4, 0xbf, 0x23, 0xc0, 0x12, 0x92, 0x39, 0x47, 0xce, 0x98, 0x48, 0x65, 0xc6, 0x3e, 0x7d, 0x7f,
+  0x7d, 0x09, 0x8d, 0x13, 0xe4, 0x80, 0x7f, 0xc4, 0x09, 0xdb, 0xe0, 0x3f, 0x4b, 0x7e, 0x8f, 0xbc,
+  0xee, 0x84, 0xaf, 0xea, 0x8e, 0xf2, 0x2b, 0x87, 0x6a, 0x91, 0xe6, 0xa0, 0xe3, 0xf7, 0xc4, 0xe7,
+  0xa2, 0xbd, 0xfa, 0x35, 0xdc, 0xfd, 0xca, 0xa6, 0xda, 0xaf, 0x28, 0xaa, 0x53, 0xb1, 0xd6, 0xf2,
+  0xe8, 0xeb, 0x4a, 0x38, 0x70, 0xb5, 0x14, 0x12, 0x04, 0xc6, 0x5b, 0x66, 0x56, 0x12, 0x26, 0xd7,
+  0xf0, 0xe3, 0x77, 0x37, 0xb7, 0x61, 0xbf, 0x83, 0xe3, 0x15, 0x53, 0x30, 0xfe, 0x7d, 0x26, 0xa1,
+  0xe7, 0x3c, 0xba, 0x85, 0xf6, 0x10, 0x82, 0x08, 0xfe, 0xa1, 0x04, 0xa6, 0x3a, 0x64, 0x6f, 0xf0,
+  0x10, 0x6d, 0x36, 0x9b, 0xc8, 0xf6, 0x3c, 0xa8, 0x53, 0x0e, 0x40, 0x16, 0x92, 0xc7, 0xbe, 0x05,
+  0x38, 0xb1, 0x1e, 0x82, 0x08, 0xe8, 0x1c, 0x16, 0x30, 0xa6, 0x01, 0xa0, 0x66, 0xed, 0x3a, 0xe6,
+  0x97, 0x5a, 0xe5, 0xec, 0xf0, 0x14, 0xce, 0x18, 0x68, 0x3b, 0xfa, 0x01, 0x9f, 0xeb, 0x0f, 0x12,
+  0x1b, 0xd3, 0x8e, 0x2d, 0x4b, 0xee, 0x07, 0xe8, 0x8f, 0x96, 0x16, 0x17, 0x2b, 0x5e, 0x6a, 0x47,
+  0xe9, 0x5e, 0x50, 0xfc, 0xf7, 0xdf, 0xff, 0x20, 0x97, 0xed, 0xa6, 0x42, 0x34, 0xbd, 0x67, 0xd9,
+  0x49, 0xfd, 0x67, 0x27, 0x68, 0x09, 0xbe, 0xa9, 0xbc, 0x18, 0x19, 0x76, 0x24, 0x0f, 0x5b, 0xf9,
+  0x63, 0x56, 0x4a, 0x6e, 0x20, 0x27, 0x36, 0xe4, 0x3d, 0x7e, 0xf8, 0x38, 0xd0, 0xee, 0x1b, 0xe8,
+  0x97, 0x5f, 0xac, 0x63, 0x5b, 0xd7, 0xe6, 0x94, 0x43, 0xf4, 0x86, 0x3d, 0x97, 0x33, 0x9d, 0xc3,
+  0x02, 0x6e, 0x8f, 0xbd, 0x60, 0xa9, 0x95, 0x79, 0xd6, 0xce, 0x7f, 0x11, 0x1b, 0x24, 0x28, 0x13,
+  0xc3, 0xe0, 0xad, 0xa1, 0xd1, 0xbd, 0x6c, 0xcb, 0x41, 0x66, 0xf9, 0x22, 0xfe, 0x24, 0xb5, 0x0e,
+  0xa7, 0x83, 0xd0, 0x55, 0x24, 0xcf, 0x6d, 0x53, 0xfa, 0x21, 0xd7, 0x7c, 0x07, 0x85, 0xf1, 0xc1,
+  0x8d, 0xee, 0x03, 0xfb, 0x67, 0xc5, 0xff, 0x03, 0x1c, 0xa1, 0x39, 0x4a, 0x6d, 0x14, 0x00, 0x00,
+};
+
+#endif // VWIRE_PORTAL_PAGE_H
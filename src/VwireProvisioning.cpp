@@ -20,6 +20,11 @@
 #endif
 #include <ArduinoJson.h>
 
+#if VWIRE_HAS_AP_PROVISIONING
+  #include "VwireStream.h"
+  #include "VwirePortalPage.h"
+#endif
+
 // =============================================================================
 // GLOBAL INSTANCE
 // =============================================================================
@@ -30,140 +35,44 @@ VwireProvisioningClass* VwireProvisioningClass::_instance = nullptr;
 #endif
 
 // =============================================================================
-// HTML TEMPLATES FOR AP MODE
+// PORTAL HELPERS
 // =============================================================================
 #if VWIRE_HAS_AP_PROVISIONING
 
-static const char PROGMEM HTML_HEADER[] = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1.0">
-  <title>VWire Device Setup</title>
-  <style>
-    * { box-sizing: border-box; margin: 0; padding: 0; }
-    body { 
-      font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, sans-serif;
-      background: linear-gradient(135deg, #1a1a2e 0%, #16213e 100%);
-      min-height: 100vh;
-      color: #fff;
-      padding: 20px;
-    }
-    .container {
-      max-width: 400px;
-      margin: 0 auto;
-      background: rgba(255,255,255,0.05);
-      border-radius: 16px;
-      padding: 24px;
-      backdrop-filter: blur(10px);
-    }
-    .logo {
-      text-align: center;
-      margin-bottom: 24px;
-    }
-    .logo h1 {
-      font-size: 24px;
-      font-weight: 600;
-      color: #00d4ff;
-    }
-    .logo p {
-      color: #888;
-      font-size: 14px;
-      margin-top: 4px;
-    }
-    .form-group {
-      margin-bottom: 16px;
-    }
-    label {
-      display: block;
-      margin-bottom: 6px;
-      font-size: 14px;
-      color: #aaa;
-    }
-    input {
-      width: 100%;
-      padding: 12px 16px;
-      border: 1px solid rgba(255,255,255,0.1);
-      border-radius: 8px;
-      background: rgba(0,0,0,0.3);
-      color: #fff;
-      font-size: 16px;
-      outline: none;
-      transition: border-color 0.2s;
-    }
-    input:focus {
-      border-color: #00d4ff;
-    }
-    input::placeholder {
-      color: #666;
-    }
-    button {
-      width: 100%;
-      padding: 14px;
-      border: none;
-      border-radius: 8px;
-      background: #00d4ff;
-      color: #000;
-      font-size: 16px;
-      font-weight: 600;
-      cursor: pointer;
-      margin-top: 8px;
-      transition: opacity 0.2s;
-    }
-    button:hover {
-      opacity: 0.9;
-    }
-    button:disabled {
-      background: #444;
-      color: #888;
-      cursor: not-allowed;
-    }
-    .status {
-      margin-top: 16px;
-      padding: 12px;
-      border-radius: 8px;
-      text-align: center;
-      font-size: 14px;
-    }
-    .status.success { background: rgba(0,200,100,0.2); color: #0c6; }
-    .status.error { background: rgba(255,100,100,0.2); color: #f66; }
-    .status.info { background: rgba(0,200,255,0.2); color: #0cf; }
-    .note {
-      margin-top: 16px;
-      padding: 12px;
-      background: rgba(255,200,0,0.1);
-      border-radius: 8px;
-      font-size: 12px;
-      color: #aa8;
-    }
-    .spinner {
-      display: inline-block;
-      width: 16px;
-      height: 16px;
-      border: 2px solid #fff;
-      border-top-color: transparent;
-      border-radius: 50%;
-      animation: spin 1s linear infinite;
-      margin-right: 8px;
-      vertical-align: middle;
-    }
-    @keyframes spin {
-      to { transform: rotate(360deg); }
+/**
+ * @brief Buffered Print over the web server's client
+ *
+ * VwireJsonWriter emits many small pieces; they leave in a few larger
+ * writes instead of one TCP write each.
+ */
+class VwirePortalWriter : public Print {
+public:
+  explicit VwirePortalWriter(Client& client) : _client(client), _length(0) {}
+
+  using Print::write;
+
+  size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t* data, size_t size) override {
+    for (size_t i = 0; i < size; i++) {
+      if (_length == sizeof(_buffer)) send();
+      _buffer[_length++] = data[i];
     }
-  </style>
-</head>
-<body>
-  <div class="container">
-)rawliteral";
+    return size;
+  }
 
-static const char PROGMEM HTML_FOOTER[] = R"rawliteral(
-  </div>
-</body>
-</html>
-)rawliteral";
+  void send() {
+    if (_length > 0) _client.write(_buffer, _length);
+    _length = 0;
+  }
 
-// Form generation is now done dynamically in _setupAPWebServer() based on _oemMode
+private:
+  Client& _client;
+  uint8_t _buffer[128];
+  size_t _length;
+};
 
 #endif // VWIRE_HAS_AP_PROVISIONING
 
@@ -185,6 +94,11 @@ VwireProvisioningClass::VwireProvisioningClass()
   , _logCallback(nullptr)
   #if VWIRE_HAS_AP_PROVISIONING
   , _webServer(nullptr)
+  , _scanResults(nullptr)
+  , _scanCount(0)
+  , _scanRunning(false)
+  , _scanCached(false)
+  , _scanAt(0)
   , _pendingStopAP(false)
   , _pendingConnect(false)
   #endif
@@ -289,38 +203,47 @@ const char* VwireProvisioningClass::getAuthToken() {
 // STORAGE IMPLEMENTATION
 // =============================================================================
 
-#if defined(VWIRE_BOARD_ESP32)
-// ESP32 uses Preferences library (NVS) - robust implementation
+#if VWIRE_HAS_CONFIG_STORE
+// Credentials are one record in the config store (CRC32-checked there)
 bool VwireProvisioningClass::_loadFromStorage() {
-  if (!_preferences.begin(VWIRE_PROV_NAMESPACE, true)) {  // Read-only
-    VWIRE_LOG("[Provision] Failed to open NVS namespace");
-    return false;
-  }
+  memset(&_credentials, 0, sizeof(_credentials));
   
-  size_t len = _preferences.getBytes("cred", &_credentials, sizeof(_credentials));
-  _preferences.end();
+  size_t len = VwireStore.get(VWIRE_CONFIG_CREDENTIALS, &_credentials, sizeof(_credentials));
+  if (len == 0 && _loadLegacyStorage()) {
+    // Stored by an earlier version: move it into the config store once
+    VWIRE_LOG("[Provision] Migrating credentials to the config store");
+    if (_saveToStorage()) {
+      _clearLegacyStorage();
+    }
+    len = sizeof(_credentials);
+  }
   
   if (len != sizeof(_credentials)) {
-    VWIRE_LOGF("[Provision] NVS size mismatch: %d vs %d", len, sizeof(_credentials));
+    if (len > 0) {
+      VWIRE_LOGF("[Provision] Stored size mismatch: %d vs %d", len, sizeof(_credentials));
+    }
     _credentials.init();
     return false;
   }
   
   if (_credentials.magic != VWIRE_PROV_MAGIC) {
-    VWIRE_LOGF("[Provision] NVS magic mismatch: 0x%04X", _credentials.magic);
+    VWIRE_LOGF("[Provision] Stored magic mismatch: 0x%04X", _credentials.magic);
     _credentials.init();
     return false;
   }
   
-  uint8_t storedChecksum = _credentials.checksum;
-  uint8_t calcedChecksum = _credentials.calcChecksum();
-  if (storedChecksum != calcedChecksum) {
-    VWIRE_LOGF("[Provision] NVS checksum mismatch: 0x%02X vs 0x%02X", storedChecksum, calcedChecksum);
+  // Ensure null termination (safety)
+  _credentials.ssid[VWIRE_PROV_MAX_SSID_LEN - 1] = '\0';
+  _credentials.password[VWIRE_PROV_MAX_PASS_LEN - 1] = '\0';
+  _credentials.authToken[VWIRE_PROV_MAX_TOKEN_LEN - 1] = '\0';
+  
+  if (_credentials.checksum != _credentials.calcChecksum() || strlen(_credentials.ssid) == 0) {
+    VWIRE_LOG("[Provision] Stored credentials are invalid");
     _credentials.init();
     return false;
   }
   
-  VWIRE_LOGF("[Provision] Loaded from NVS - SSID:%s Token:%d chars", 
+  VWIRE_LOGF("[Provision] Loaded - SSID:%s Token:%d chars", 
                _credentials.ssid, strlen(_credentials.authToken));
   return true;
 }
@@ -329,140 +252,59 @@ bool VwireProvisioningClass::_saveToStorage() {
   // Ensure checksum is current
   _credentials.checksum = _credentials.calcChecksum();
   
-  if (!_preferences.begin(VWIRE_PROV_NAMESPACE, false)) {  // Read-write
-    VWIRE_LOG("[Provision] Failed to open NVS for write");
-    return false;
-  }
-  
-  size_t written = _preferences.putBytes("cred", &_credentials, sizeof(_credentials));
-  _preferences.end();
-  
-  if (written != sizeof(_credentials)) {
-    VWIRE_LOGF("[Provision] NVS write failed: %d vs %d", written, sizeof(_credentials));
+  // The store reads the record back and checks its CRC before reporting success
+  if (!VwireStore.put(VWIRE_CONFIG_CREDENTIALS, &_credentials, sizeof(_credentials))) {
+    VWIRE_LOG("[Provision] Config store write failed!");
     return false;
   }
   
-  VWIRE_LOGF("[Provision] Saved to NVS - SSID:%s Token:%d chars", 
+  VWIRE_LOGF("[Provision] Saved - SSID:%s Token:%d chars", 
                _credentials.ssid, strlen(_credentials.authToken));
   return true;
 }
 
 bool VwireProvisioningClass::_clearStorage() {
-  if (!_preferences.begin(VWIRE_PROV_NAMESPACE, false)) {
+  bool result = VwireStore.remove(VWIRE_CONFIG_CREDENTIALS);
+  VWIRE_LOG("[Provision] Stored credentials cleared");
+  return result;
+}
+
+#if defined(VWIRE_BOARD_ESP32)
+// Earlier versions kept the structure in its own NVS namespace
+bool VwireProvisioningClass::_loadLegacyStorage() {
+  if (!_preferences.begin(VWIRE_PROV_NAMESPACE, true)) {  // Read-only
     return false;
   }
-  _preferences.clear();
+  size_t len = _preferences.getBytesLength("cred") == sizeof(_credentials)
+                 ? _preferences.getBytes("cred", &_credentials, sizeof(_credentials)) : 0;
   _preferences.end();
-  VWIRE_LOG("[Provision] NVS credentials cleared");
-  return true;
+  return len == sizeof(_credentials) && _credentials.isValid();
 }
 
-#elif defined(VWIRE_BOARD_ESP8266)
-// ESP8266 uses EEPROM - robust implementation
-bool VwireProvisioningClass::_loadFromStorage() {
-  // Clear structure first
-  memset(&_credentials, 0, sizeof(_credentials));
-  
-  EEPROM.begin(VWIRE_PROV_EEPROM_SIZE);
-  
-  // Read structure from EEPROM byte by byte
-  uint8_t* ptr = (uint8_t*)&_credentials;
-  for (size_t i = 0; i < sizeof(_credentials); i++) {
-    ptr[i] = EEPROM.read(VWIRE_PROV_EEPROM_START + i);
+void VwireProvisioningClass::_clearLegacyStorage() {
+  if (_preferences.begin(VWIRE_PROV_NAMESPACE, false)) {
+    _preferences.clear();
+    _preferences.end();
   }
-  
-  EEPROM.end();
-  
-  // Validate magic number
-  if (_credentials.magic != VWIRE_PROV_MAGIC) {
-    VWIRE_LOGF("[Provision] EEPROM magic mismatch: 0x%04X (expected 0x%04X)", _credentials.magic, VWIRE_PROV_MAGIC);
-    _credentials.init();
-    return false;
-  }
-  
-  // Ensure null termination (safety)
-  _credentials.ssid[VWIRE_PROV_MAX_SSID_LEN - 1] = '\0';
-  _credentials.password[VWIRE_PROV_MAX_PASS_LEN - 1] = '\0';
-  _credentials.authToken[VWIRE_PROV_MAX_TOKEN_LEN - 1] = '\0';
-  
-  // Validate checksum
-  uint8_t storedChecksum = _credentials.checksum;
-  uint8_t calcedChecksum = _credentials.calcChecksum();
-  if (storedChecksum != calcedChecksum) {
-    VWIRE_LOGF("[Provision] EEPROM checksum mismatch: 0x%02X vs 0x%02X", storedChecksum, calcedChecksum);
-    VWIRE_LOGF("[Provision] Raw SSID len:%d Pass len:%d Token len:%d",
-                 strlen(_credentials.ssid), strlen(_credentials.password), strlen(_credentials.authToken));
-    _credentials.init();
-    return false;
-  }
-  
-  // Validate SSID is not empty
-  if (strlen(_credentials.ssid) == 0) {
-    VWIRE_LOG("[Provision] EEPROM SSID is empty");
-    _credentials.init();
-    return false;
-  }
-  
-  VWIRE_LOGF("[Provision] Loaded from EEPROM OK - SSID:%s (%d) Pass:%d Token:%d", 
-               _credentials.ssid, strlen(_credentials.ssid),
-               strlen(_credentials.password), strlen(_credentials.authToken));
-  return true;
 }
 
-bool VwireProvisioningClass::_saveToStorage() {
-  // Verify checksum before saving
-  _credentials.checksum = _credentials.calcChecksum();
-  
-  EEPROM.begin(VWIRE_PROV_EEPROM_SIZE);
-  
-  // Write structure to EEPROM
-  uint8_t* ptr = (uint8_t*)&_credentials;
-  for (size_t i = 0; i < sizeof(_credentials); i++) {
-    EEPROM.write(VWIRE_PROV_EEPROM_START + i, ptr[i]);
-  }
-  
-  bool result = EEPROM.commit();
-  
-  if (!result) {
-    EEPROM.end();
-    VWIRE_LOG("[Provision] EEPROM commit failed!");
-    return false;
-  }
-  
-  // Verify write by reading back
-  VwireCredentials verify;
-  uint8_t* vptr = (uint8_t*)&verify;
-  for (size_t i = 0; i < sizeof(verify); i++) {
-    vptr[i] = EEPROM.read(VWIRE_PROV_EEPROM_START + i);
-  }
-  
-  EEPROM.end();
-  
-  // Compare what we wrote vs what we read
-  if (memcmp(&_credentials, &verify, sizeof(_credentials)) != 0) {
-    VWIRE_LOG("[Provision] EEPROM verify failed - data mismatch!");
+#else
+// Earlier versions wrote the structure into EEPROM; the store kept that
+// image when it took over the sector
+bool VwireProvisioningClass::_loadLegacyStorage() {
+  uint8_t image[VWIRE_CONFIG_STORE_LEGACY_SIZE];
+  if (VwireStore.get(VWIRE_CONFIG_LEGACY_EEPROM, image, sizeof(image)) != sizeof(image) ||
+      VWIRE_PROV_EEPROM_START + sizeof(_credentials) > sizeof(image)) {
     return false;
   }
-  
-  VWIRE_LOGF("[Provision] Saved to EEPROM - SSID:%s Token:%d chars (verified)", 
-               _credentials.ssid, strlen(_credentials.authToken));
-  return true;
+  memcpy(&_credentials, image + VWIRE_PROV_EEPROM_START, sizeof(_credentials));
+  return _credentials.isValid();
 }
 
-bool VwireProvisioningClass::_clearStorage() {
-  EEPROM.begin(VWIRE_PROV_EEPROM_SIZE);
-  
-  // Write zeros to entire credential area
-  for (size_t i = 0; i < sizeof(_credentials); i++) {
-    EEPROM.write(VWIRE_PROV_EEPROM_START + i, 0);
-  }
-  
-  bool result = EEPROM.commit();
-  EEPROM.end();
-  
-  VWIRE_LOG("[Provision] EEPROM credentials cleared");
-  return result;
+void VwireProvisioningClass::_clearLegacyStorage() {
+  VwireStore.remove(VWIRE_CONFIG_LEGACY_EEPROM);
 }
+#endif
 
 #else
 // Unsupported platform - no persistent storage
@@ -509,10 +351,10 @@ bool VwireProvisioningClass::startAPMode(const char* apSSID, const char* apPassw
   strncpy(_apSSID, apSSID, VWIRE_PROV_MAX_SSID_LEN - 1);
   _apSSID[VWIRE_PROV_MAX_SSID_LEN - 1] = '\0';
   
-  // Disconnect and set to AP mode
+  // Disconnect and set to AP mode (with the station idle, for scans)
   WiFi.disconnect(true);
   delay(100);
-  WiFi.mode(WIFI_AP);
+  WiFi.mode(WIFI_AP_STA);
   delay(100);
   
   // Start AP
@@ -537,6 +379,14 @@ bool VwireProvisioningClass::startAPMode(const char* apSSID, const char* apPassw
   // Setup web server
   _setupAPWebServer();
   
+  // First scan runs while the user joins the AP
+  if (!_scanResults) {
+    _scanResults = new ScanEntry[VWIRE_PROV_SCAN_MAX];
+  }
+  _scanCount = 0;
+  _scanCached = false;
+  _startScan();
+  
   _state = VWIRE_PROV_AP_ACTIVE;
   _method = VWIRE_PROV_METHOD_AP;
   _startTime = millis();
@@ -554,6 +404,14 @@ void VwireProvisioningClass::stopAPMode() {
       delete _webServer;
       _webServer = nullptr;
     }
+    if (_scanRunning) {
+      WiFi.scanDelete();
+      _scanRunning = false;
+    }
+    delete[] _scanResults;
+    _scanResults = nullptr;
+    _scanCount = 0;
+    _scanCached = false;
     WiFi.softAPdisconnect(true);
     _state = VWIRE_PROV_IDLE;
     _method = VWIRE_PROV_METHOD_NONE;
@@ -584,6 +442,7 @@ void VwireProvisioningClass::_setupAPWebServer() {
   _webServer->on("/", HTTP_GET, [this]() { this->_handleRoot(); });
   _webServer->on("/config", HTTP_POST, [this]() { this->_handleConfig(); });
   _webServer->on("/status", HTTP_GET, [this]() { this->_handleStatus(); });
+  _webServer->on("/scan", HTTP_GET, [this]() { this->_handleScan(); });
     // Handshake endpoint: app checks if device is ready
     _webServer->on("/handshake", HTTP_GET, [this]() {
       _webServer->send(200, "application/json", "{\"status\":\"ready\"}");
@@ -592,106 +451,28 @@ void VwireProvisioningClass::_setupAPWebServer() {
     // Confirmation endpoint: app polls until credentials are received
     _webServer->on("/confirm", HTTP_GET, [this]() {
       bool received = _credentialsLoaded; // or use a more robust flag if needed
-      _webServer->send(200, "application/json", String("{\"received\":") + (received ? "true" : "false") + "}");
+      _webServer->send(200, "application/json", received ? "{\"received\":true}" : "{\"received\":false}");
     });
   _webServer->onNotFound([this]() { this->_handleNotFound(); });
   
+  // Needed for ETag revalidation of the page
+  static const char* headers[] = { "If-None-Match" };
+  _webServer->collectHeaders(headers, 1);
   _webServer->begin();
   VWIRE_LOG("[Provision] Web server started on port 80");
 }
 
 void VwireProvisioningClass::_handleRoot() {
-  String html = FPSTR(HTML_HEADER);
-  
-  // Generate form based on OEM mode
-  html += F("<div class=\"logo\">\n");
-  html += F("  <h1>VWire Setup</h1>\n");
-  html += F("  <p>Configure your IoT device</p>\n");
-  html += F("</div>\n\n");
-  html += F("<form id=\"configForm\" onsubmit=\"return submitConfig()\">\n");
-  
-  // WiFi SSID field (always shown)
-  html += F("  <div class=\"form-group\">\n");
-  html += F("    <label for=\"ssid\">WiFi Network (SSID)</label>\n");
-  html += F("    <input type=\"text\" id=\"ssid\" name=\"ssid\" placeholder=\"Your WiFi name\" required maxlength=\"32\">\n");
-  html += F("  </div>\n\n");
-  
-  // WiFi Password field (always shown)
-  html += F("  <div class=\"form-group\">\n");
-  html += F("    <label for=\"password\">WiFi Password</label>\n");
-  html += F("    <input type=\"password\" id=\"password\" name=\"password\" placeholder=\"WiFi password\" maxlength=\"64\">\n");
-  html += F("  </div>\n\n");
-  
-  // Device Token field (only for end-user mode)
-  if (!_oemMode) {
-    html += F("  <div class=\"form-group\">\n");
-    html += F("    <label for=\"token\">Device Token</label>\n");
-    html += F("    <input type=\"text\" id=\"token\" name=\"token\" placeholder=\"From VWire dashboard\" required maxlength=\"63\">\n");
-    html += F("  </div>\n\n");
-  }
-  
-  html += F("  <button type=\"submit\" id=\"submitBtn\">Configure Device</button>\n\n");
-  html += F("  <div id=\"status\" class=\"status\" style=\"display:none;\"></div>\n\n");
-  html += F("  <div class=\"note\">\n");
-  html += F("    <strong>Note:</strong> After configuration, the device will restart and connect to your WiFi network.\n");
-  html += F("    You can then close this page.\n");
-  html += F("  </div>\n");
-  html += F("</form>\n\n");
-  
-  // JavaScript for form submission
-  html += F("<script>\n");
-  html += F("function submitConfig() {\n");
-  html += F("  var btn = document.getElementById('submitBtn');\n");
-  html += F("  var status = document.getElementById('status');\n");
-  html += F("  var ssid = document.getElementById('ssid').value;\n");
-  html += F("  var password = document.getElementById('password').value;\n");
-  
-  if (!_oemMode) {
-    html += F("  var token = document.getElementById('token').value;\n");
-  }
-  
-  html += F("  btn.disabled = true;\n");
-  html += F("  btn.innerHTML = '<span class=\"spinner\"></span>Configuring...';\n");
-  html += F("  status.style.display = 'none';\n\n");
-  
-  html += F("  var body = 'ssid=' + encodeURIComponent(ssid) + \n");
-  html += F("             '&password=' + encodeURIComponent(password)");
-  
-  if (!_oemMode) {
-    html += F(" + \n             '&token=' + encodeURIComponent(token)");
-  }
-  
-  html += F(";\n\n");
-  
-  html += F("  fetch('/config', {\n");
-  html += F("    method: 'POST',\n");
-  html += F("    headers: { 'Content-Type': 'application/x-www-form-urlencoded' },\n");
-  html += F("    body: body\n");
-  html += F("  })\n");
-  html += F("  .then(function(response) { return response.json(); })\n");
-  html += F("  .then(function(data) {\n");
-  html += F("    if (data.success) {\n");
-  html += F("      status.className = 'status success';\n");
-  html += F("      status.innerHTML = '✓ Configuration saved! Device is restarting...';\n");
-  html += F("      status.style.display = 'block';\n");
-  html += F("    } else {\n");
-  html += F("      throw new Error(data.error || 'Configuration failed');\n");
-  html += F("    }\n");
-  html += F("  })\n");
-  html += F("  .catch(function(error) {\n");
-  html += F("    status.className = 'status error';\n");
-  html += F("    status.innerHTML = '✗ ' + error.message;\n");
-  html += F("    status.style.display = 'block';\n");
-  html += F("    btn.disabled = false;\n");
-  html += F("    btn.innerHTML = 'Configure Device';\n");
-  html += F("  });\n\n");
-  
-  html += F("  return false;\n");
-  html += F("}\n");
-  html += F("</script>\n");
-  
-  html += FPSTR(HTML_FOOTER);
-  _webServer->send(200, "text/html", html);
+  // One pre-gzipped page for both modes; it asks /status whether to show
+  // the token field. Streamed from flash, so no copy on the heap.
+  _webServer->sendHeader("ETag", VWIRE_PORTAL_PAGE_ETAG);
+  _webServer->sendHeader("Cache-Control", "no-cache");
+  if (_webServer->header("If-None-Match") == VWIRE_PORTAL_PAGE_ETAG) {
+    _webServer->send(304);
+    return;
+  }
+  _webServer->sendHeader("Content-Encoding", "gzip");
+  _webServer->send_P(200, "text/html", (const char*)VWIRE_PORTAL_PAGE, sizeof(VWIRE_PORTAL_PAGE));
 }
 
 void VwireProvisioningClass::_handleConfig() {
@@ -770,13 +551,119 @@ void VwireProvisioningClass::_handleConfig() {
 }
 
 void VwireProvisioningClass::_handleStatus() {
-  String json = "{";
-  json += "\"state\":\"" + String((int)_state) + "\",";
-  json += "\"method\":\"ap\",";
-  json += "\"apSSID\":\"" + String(_apSSID) + "\",";
-  json += "\"apIP\":\"" + getAPIP() + "\"";
-  json += "}";
-  _webServer->send(200, "application/json", json);
+  char state[4];
+  snprintf(state, sizeof(state), "%d", (int)_state);
+  IPAddress ip = WiFi.softAPIP();
+  char apIP[16];
+  snprintf(apIP, sizeof(apIP), "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  
+  _sendJson([&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("state", state);
+    json.field("method", "ap");
+    json.field("apSSID", _apSSID);
+    json.field("apIP", apIP);
+    json.field("oem", _oemMode);
+    json.endObject();
+  });
+}
+
+void VwireProvisioningClass::_handleScan() {
+  // Answer from the cache at once; refresh it in the background when stale
+  if (!_scanRunning && (!_scanCached || millis() - _scanAt >= VWIRE_PROV_SCAN_MAX_AGE)) {
+    _startScan();
+  }
+  
+  _sendJson([&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("scanning", _scanRunning);
+    json.key("networks");
+    json.beginArray();
+    for (uint8_t i = 0; i < _scanCount; i++) {
+      json.beginObject();
+      json.field("ssid", _scanResults[i].ssid);
+      json.field("rssi", (int)_scanResults[i].rssi);
+      json.field("open", _scanResults[i].open);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+  });
+}
+
+template <typename Body>
+void VwireProvisioningClass::_sendJson(Body body) {
+  // Counting pass for Content-Length, then straight into the client
+  VwireJsonWriter counter;
+  body(counter);
+  _webServer->setContentLength(counter.length());
+  _webServer->send(200, "application/json", String());
+  
+  VwirePortalWriter out(_webServer->client());
+  VwireJsonWriter json(&out);
+  body(json);
+  out.send();
+}
+
+void VwireProvisioningClass::_startScan() {
+  if (_scanRunning) return;
+  if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+    VWIRE_LOG("[Provision] WiFi scan could not start");
+    return;
+  }
+  _scanRunning = true;
+}
+
+void VwireProvisioningClass::_collectScan() {
+  if (!_scanRunning) return;
+  int16_t found = WiFi.scanComplete();
+  if (found == WIFI_SCAN_RUNNING) return;
+  _scanRunning = false;
+  if (found < 0 || !_scanResults) {
+    VWIRE_LOG("[Provision] WiFi scan failed");
+    return;                            // Keep the previous results
+  }
+  
+  // Strongest first, one entry per SSID, hidden networks left out
+  _scanCount = 0;
+  for (int16_t i = 0; i < found; i++) {
+    String ssid = WiFi.SSID(i);
+    if (ssid.length() == 0) continue;
+    int8_t rssi = (int8_t)WiFi.RSSI(i);
+    
+    bool weaker = false;
+    for (uint8_t j = 0; j < _scanCount; j++) {
+      if (strcmp(_scanResults[j].ssid, ssid.c_str()) != 0) continue;
+      if (_scanResults[j].rssi >= rssi) {
+        weaker = true;
+      } else {
+        memmove(&_scanResults[j], &_scanResults[j + 1], (_scanCount - j - 1) * sizeof(ScanEntry));
+        _scanCount--;
+      }
+      break;
+    }
+    if (weaker) continue;
+    
+    uint8_t at = 0;
+    while (at < _scanCount && _scanResults[at].rssi >= rssi) at++;
+    if (at >= VWIRE_PROV_SCAN_MAX) continue;
+    if (_scanCount < VWIRE_PROV_SCAN_MAX) _scanCount++;
+    memmove(&_scanResults[at + 1], &_scanResults[at], (_scanCount - at - 1) * sizeof(ScanEntry));
+    
+    ScanEntry& entry = _scanResults[at];
+    strncpy(entry.ssid, ssid.c_str(), sizeof(entry.ssid) - 1);
+    entry.ssid[sizeof(entry.ssid) - 1] = '\0';
+    entry.rssi = rssi;
+    #if defined(VWIRE_BOARD_ESP32)
+    entry.open = WiFi.encryptionType(i) == WIFI_AUTH_OPEN;
+    #else
+    entry.open = WiFi.encryptionType(i) == ENC_TYPE_NONE;
+    #endif
+  }
+  WiFi.scanDelete();
+  _scanCached = true;
+  _scanAt = millis();
+  VWIRE_LOGF("[Provision] WiFi scan: %d networks", _scanCount);
 }
 
 void VwireProvisioningClass::_handleNotFound() {
@@ -793,6 +680,7 @@ void VwireProvisioningClass::run() {
   #if VWIRE_HAS_AP_PROVISIONING
   if (_method == VWIRE_PROV_METHOD_AP && _webServer) {
     _webServer->handleClient();
+    _collectScan();
     
     // Only proceed to stop AP and connect after handshake confirmation
     if (_handshakeConfirmed) {
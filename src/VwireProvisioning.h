@@ -26,6 +26,7 @@
 
 #include <Arduino.h>
 #include "VwireConfig.h"
+#include "VwireConfigStore.h"
 
 // AP Mode provisioning available on all WiFi boards
 #if VWIRE_HAS_WIFI
@@ -41,7 +42,6 @@
 #elif defined(VWIRE_BOARD_ESP8266)
   #include <ESP8266WiFi.h>
   #include <ESP8266WebServer.h>
-  #include <EEPROM.h>
 #endif
 
 // =============================================================================
@@ -68,13 +68,23 @@
 /** @brief AP Mode Web server port */
 #define VWIRE_PROV_WEB_PORT 80
 
-/** @brief EEPROM/Preferences namespace for credentials */
+/** @brief Networks kept from a portal WiFi scan (strongest first) */
+#ifndef VWIRE_PROV_SCAN_MAX
+#define VWIRE_PROV_SCAN_MAX 16
+#endif
+
+/** @brief Age (ms) after which a portal request triggers a fresh background scan */
+#ifndef VWIRE_PROV_SCAN_MAX_AGE
+#define VWIRE_PROV_SCAN_MAX_AGE 30000
+#endif
+
+/** @brief Preferences namespace of credentials saved by earlier versions (ESP32) */
 #define VWIRE_PROV_NAMESPACE "vwire_cred"
 
-/** @brief EEPROM start address for ESP8266 */
+/** @brief EEPROM address of credentials saved by earlier versions (ESP8266) */
 #define VWIRE_PROV_EEPROM_START 0
 
-/** @brief EEPROM size for ESP8266 */
+/** @brief EEPROM size used by earlier versions (ESP8266) */
 #define VWIRE_PROV_EEPROM_SIZE 256
 
 /** @brief Magic value to validate stored credentials */
@@ -124,7 +134,8 @@ typedef void (*ProvisioningProgressCallback)(int progress);
 /**
  * @brief Structure for stored WiFi credentials and device token
  * 
- * Simple structure with XOR checksum for reliable storage.
+ * Kept as one CRC32-protected record in VwireStore; the XOR checksum
+ * still guards the copy held in RAM.
  * Packed to prevent alignment issues on ESP8266.
  * Total size: 173 bytes (2+33+65+72+1)
  */
@@ -431,7 +442,23 @@ private:
   void _handleRoot();
   void _handleConfig();
   void _handleStatus();
+  void _handleScan();
   void _handleNotFound();
+  template <typename Body> void _sendJson(Body body);
+  
+  // Cached WiFi scan for the portal (allocated while the AP is up)
+  struct ScanEntry {
+    char ssid[VWIRE_PROV_MAX_SSID_LEN];
+    int8_t rssi;
+    bool open;
+  };
+  ScanEntry* _scanResults;
+  uint8_t _scanCount;
+  bool _scanRunning;
+  bool _scanCached;
+  unsigned long _scanAt;
+  void _startScan();
+  void _collectScan();
   static VwireProvisioningClass* _instance;
   bool _pendingStopAP;
   bool _pendingConnect;
@@ -445,13 +472,17 @@ private:
   void _debugPrint(const char* message);
   void _debugPrintf(const char* format, ...);
   
-  // Storage helpers
+  // Storage helpers (VwireStore, plus the pre-store location for migration)
   #if defined(VWIRE_BOARD_ESP32)
   Preferences _preferences;
   #endif
   bool _loadFromStorage();
   bool _saveToStorage();
   bool _clearStorage();
+  #if VWIRE_HAS_CONFIG_STORE
+  bool _loadLegacyStorage();
+  void _clearLegacyStorage();
+  #endif
 };
 
 // =============================================================================
@@ -0,0 +1,120 @@
+/*
+ * Vwire IOT Arduino Library - Publish Policy (virtual pins)
+ *
+ * Virtual pins with a policy get one slot holding their VwirePublishGate
+ * and the latest written value. _virtualSendInternal() consults the slot
+ * through a direct pin -> slot index; run() sends held values once the
+ * rate limit allows and refreshes pins whose maxInterval has passed.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_PUBLISH_POLICY
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+bool VwireClass::setPublishPolicy(uint8_t pin, const VwirePublishPolicy& policy) {
+  if (pin >= VWIRE_MAX_VIRTUAL_PINS) {
+    _setError(VWIRE_ERR_INVALID_PIN);
+    return false;
+  }
+
+  uint8_t slot = _policyIndex[pin];
+  if (slot == 0xFF) {
+    if (_policyCount >= VWIRE_MAX_PUBLISH_POLICIES) {
+      VWIRE_LOGF("[Vwire] Error: no publish policy slot for V%d (max %d)",
+                 pin, VWIRE_MAX_PUBLISH_POLICIES);
+      return false;
+    }
+    slot = _policyCount++;
+    _policies[slot].gate.reset();
+    _policies[slot].pin = pin;
+    _policies[slot].numeric = false;
+    _policies[slot].value[0] = '\0';
+    _policyIndex[pin] = slot;
+  }
+
+  _policies[slot].gate.policy = policy;
+  return true;
+}
+
+void VwireClass::clearPublishPolicy(uint8_t pin) {
+  if (pin >= VWIRE_MAX_VIRTUAL_PINS || _policyIndex[pin] == 0xFF) return;
+
+  uint8_t slot = _policyIndex[pin];
+  _policyIndex[pin] = 0xFF;
+
+  // Keep slots packed: move the last one into the gap
+  uint8_t last = --_policyCount;
+  if (slot != last) {
+    _policies[slot] = _policies[last];
+    _policyIndex[_policies[slot].pin] = slot;
+  }
+}
+
+// =============================================================================
+// INTERNAL
+// =============================================================================
+
+bool VwireClass::_policyAdmit(uint8_t pin, const char* value) {
+  PolicySlot& slot = _policies[_policyIndex[pin]];
+
+  size_t len = strlen(value);
+  if (len >= sizeof(slot.value)) {
+    return true;                    // Too long to hold back: always send
+  }
+
+  float number = 0;
+  bool numeric = VwirePublishGate::parseNumber(value, number);
+  uint32_t hash = numeric ? 0 : VwirePublishGate::hashText(value);
+
+  // Remember the latest value for coalescing and maxInterval refreshes
+  memcpy(slot.value, value, len + 1);
+  slot.numeric = numeric;
+
+  return slot.gate.offer(numeric, number, hash, millis()) == VWIRE_POLICY_SEND;
+}
+
+void VwireClass::_policyRun(unsigned long now) {
+  for (uint8_t i = 0; i < _policyCount; i++) {
+    PolicySlot& slot = _policies[i];
+    if (!slot.gate.due(now)) continue;
+
+    float number = 0;
+    if (slot.numeric) {
+      VwirePublishGate::parseNumber(slot.value, number);
+    }
+    slot.gate.markSent(slot.numeric, number,
+                       slot.numeric ? 0 : VwirePublishGate::hashText(slot.value), now);
+    _deliverPin(slot.pin, slot.value);
+  }
+}
+
+#else
+
+bool VwireClass::setPublishPolicy(uint8_t pin, const VwirePublishPolicy& policy) {
+  (void)pin;
+  (void)policy;
+  _debugPrint("[Vwire] Publish policies are not available in this build");
+  return false;
+}
+
+void VwireClass::clearPublishPolicy(uint8_t pin) {
+  (void)pin;
+}
+
+#endif // VWIRE_ENABLE_PUBLISH_POLICY
@@ -0,0 +1,192 @@
+/*
+ * Vwire IOT Arduino Library - Publish Policy
+ *
+ * Change detection, deadband and rate limiting for outgoing pin values.
+ * A policy decides whether a new value is worth a message; a gate holds
+ * the per-pin state and applies it. Used by virtual pins
+ * (Vwire.setPublishPolicy()) and by GPIO input pins
+ * (VwireGPIO::setPublishPolicy()).
+ *
+ * Usage:
+ *   // Publish V0 when it moves by 0.5, at most once a second,
+ *   // and at least every 5 minutes
+ *   Vwire.setPublishPolicy(V0, VwirePublishPolicy(0.5, 1000, 300000));
+ *
+ *   // A0 only when it changes by 2 %
+ *   gpio.setPublishPolicy("A0", VwirePublishPolicy(2, 0, 0, true));
+ *
+ * Strip from the build with VWIRE_DISABLE_PUBLISH_POLICY.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_PUBLISH_POLICY_H
+#define VWIRE_PUBLISH_POLICY_H
+
+#include <Arduino.h>
+#include "VwireConfig.h"
+
+// =============================================================================
+// POLICY
+// =============================================================================
+
+/**
+ * @brief When a pin value is published
+ *
+ * - deadband: a numeric value is only published when it differs from the
+ *   last published value by at least this much (absolute, or percent of
+ *   the last published value). 0 publishes every change.
+ * - minInterval: at most one message per minInterval ms. Writes arriving
+ *   faster are coalesced; the latest value is sent when the interval ends.
+ * - maxInterval: republish the current value after maxInterval ms without
+ *   a message, even if unchanged (0 = never).
+ *
+ * Non-numeric values are compared as text, so the deadband does not apply.
+ */
+struct VwirePublishPolicy {
+  float deadband;             ///< Minimum change to publish (0 = any change)
+  bool percent;               ///< deadband is a percentage of the last published value
+  uint32_t minInterval;       ///< Minimum ms between messages (0 = no limit)
+  uint32_t maxInterval;       ///< Republish after this many ms without a message (0 = off)
+
+  VwirePublishPolicy(float deadband = 0, uint32_t minInterval = 0,
+                     uint32_t maxInterval = 0, bool percent = false)
+    : deadband(deadband), percent(percent),
+      minInterval(minInterval), maxInterval(maxInterval) {}
+};
+
+// =============================================================================
+// GATE
+// =============================================================================
+
+/** @brief Outcome of VwirePublishGate::offer() */
+typedef enum {
+  VWIRE_POLICY_SEND = 0,      ///< Publish now
+  VWIRE_POLICY_HOLD,          ///< Changed but rate limited: publish once due()
+  VWIRE_POLICY_SKIP           ///< Inside the deadband: nothing to publish
+} VwirePolicyDecision;
+
+/**
+ * @brief Per-pin policy state
+ *
+ * Tracks the last published value and time, and whether a newer value is
+ * waiting for the rate limit. The value itself is kept by the caller (a
+ * virtual pin slot or the GPIO pin), so the gate stays small enough to
+ * embed in every GPIO pin.
+ */
+struct VwirePublishGate {
+  VwirePublishPolicy policy;
+  float sent;                 ///< Last published numeric value
+  uint32_t sentHash;          ///< Last published text (FNV-1a) or pulse total
+  unsigned long sentAt;       ///< millis() of the last publish
+  bool hasSent;               ///< Something was published since reset()
+  bool pending;               ///< A held value is waiting for minInterval
+
+  VwirePublishGate() { reset(); }
+
+  /** @brief Forget the published state (next value is always sent) */
+  void reset() {
+    sent = 0;
+    sentHash = 0;
+    sentAt = 0;
+    hasSent = false;
+    pending = false;
+  }
+
+  /**
+   * @brief Offer a new value
+   * @param numeric true if value is a number (text is compared otherwise)
+   * @param value Numeric value (ignored if !numeric)
+   * @param hash FNV-1a of the text value (ignored if numeric)
+   * @param now Current millis()
+   */
+  VwirePolicyDecision offer(bool numeric, float value, uint32_t hash, unsigned long now) {
+    bool changed = !hasSent;
+    if (!changed) {
+      if (numeric) {
+        float delta = value > sent ? value - sent : sent - value;
+        float band = policy.percent ? (sent < 0 ? -sent : sent) * policy.deadband / 100.0f
+                                    : policy.deadband;
+        changed = band > 0 ? delta >= band : delta != 0;
+      } else {
+        changed = hash != sentHash;
+      }
+    }
+
+    return _decide(changed, numeric, value, hash, now);
+  }
+
+  /**
+   * @brief Offer a pulse total
+   *
+   * Compared as an integer, since a float stops telling totals apart past
+   * 2^24. Kept in sentHash; publish it with markCount().
+   */
+  VwirePolicyDecision offerCount(uint32_t total, unsigned long now) {
+    bool changed = !hasSent;
+    if (!changed) {
+      uint32_t delta = total > sentHash ? total - sentHash : sentHash - total;
+      float band = policy.percent ? sentHash * policy.deadband / 100.0f : policy.deadband;
+      changed = band > 0 ? delta >= band : delta != 0;
+    }
+    return _decide(changed, false, 0, total, now);
+  }
+
+  /** @brief true when a held value or a maxInterval refresh should go out now */
+  bool due(unsigned long now) const {
+    if (!hasSent) return false;
+    if (pending) return now - sentAt >= policy.minInterval;
+    return policy.maxInterval > 0 && now - sentAt >= policy.maxInterval;
+  }
+
+  /** @brief Record that value was published */
+  void markSent(bool numeric, float value, uint32_t hash, unsigned long now) {
+    sent = numeric ? value : 0;
+    sentHash = numeric ? 0 : hash;
+    sentAt = now;
+    hasSent = true;
+    pending = false;
+  }
+
+  /** @brief Record that a pulse total was published */
+  void markCount(uint32_t total, unsigned long now) { markSent(false, 0, total, now); }
+
+  /** @brief FNV-1a of a text value */
+  static uint32_t hashText(const char* text) {
+    uint32_t hash = 2166136261UL;
+    for (const char* c = text; *c; c++) {
+      hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Parse a value as a number
+   * @return true if the whole text is a number
+   */
+  static bool parseNumber(const char* text, float& value) {
+    if (!text || !*text) return false;
+    char* end = nullptr;
+    value = (float)strtod(text, &end);
+    return end && end != text && *end == '\0';
+  }
+
+private:
+  VwirePolicyDecision _decide(bool changed, bool numeric, float value, uint32_t hash,
+                              unsigned long now) {
+    if (!changed) {
+      pending = false;        // Back inside the band: nothing owed
+      return VWIRE_POLICY_SKIP;
+    }
+    if (hasSent && policy.minInterval > 0 && now - sentAt < policy.minInterval) {
+      pending = true;         // Latest value wins when the interval ends
+      return VWIRE_POLICY_HOLD;
+    }
+    markSent(numeric, value, hash, now);
+    return VWIRE_POLICY_SEND;
+  }
+};
+
+#endif // VWIRE_PUBLISH_POLICY_H
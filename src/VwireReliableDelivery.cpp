@@ -25,6 +25,34 @@
 
 static VwireReliableDeliveryAddon _vwireDefaultReliableDeliveryAddon;
 
+// =============================================================================
+// ACK PARSING HELPERS
+// =============================================================================
+//
+// Accepted ACK payloads on vwire/{deviceId}/ack:
+//   {"msgId":"1234","ok":true}          one message (msgId is the sequence number)
+//   {"from":1234,"to":1240,"ok":true}   every message in the range, inclusive
+//   {"ack":1240}                        cumulative: every message up to 1240
+//
+
+static bool _vwireJsonUint(const char* json, const char* key, uint32_t& out) {
+  const char* pos = strstr(json, key);
+  if (!pos) return false;
+  pos += strlen(key);
+  while (*pos == ' ' || *pos == '"') pos++;
+  if (*pos < '0' || *pos > '9') return false;
+  out = strtoul(pos, nullptr, 10);
+  return true;
+}
+
+static bool _vwireJsonOk(const char* json) {
+  const char* pos = strstr(json, "\"ok\":");
+  if (!pos) return true;   // Absent means success
+  pos += 5;
+  while (*pos == ' ') pos++;
+  return strncmp(pos, "true", 4) == 0;
+}
+
 // =============================================================================
 // CONSTRUCTOR / REGISTRATION
 // =============================================================================
@@ -35,7 +63,10 @@ VwireReliableDeliveryAddon::VwireReliableDeliveryAddon()
   , _ackTimeout(VWIRE_DEFAULT_ACK_TIMEOUT)
   , _maxRetries(VWIRE_DEFAULT_MAX_RETRIES)
   , _deliveryCallback(nullptr)
-  , _msgIdCounter(0) {
+  , _nextSeq(0)
+  , _baseSeq(0)
+  , _inFlight(0)
+  , _nextDeadline(0) {
   memset(_pendingMessages, 0, sizeof(_pendingMessages));
 }
 
@@ -46,6 +77,11 @@ void VwireReliableDeliveryAddon::begin(VwireClass& vwire) {
 
 void VwireReliableDeliveryAddon::onAttach(VwireClass& vwire) {
   _vwire = &vwire;
+  // Start each boot in a different region of the sequence space so the
+  // server does not mistake new messages for ones from a previous boot.
+  // Staying below 2^31 leaves billions of sends before the counter wraps.
+  _nextSeq = (uint32_t)random(1, 0x8000) << 16;
+  _baseSeq = _nextSeq;
 }
 
 // =============================================================================
@@ -80,24 +116,21 @@ void VwireReliableDeliveryAddon::onDeliveryStatus(DeliveryCallback cb) {
 // =============================================================================
 
 uint8_t VwireReliableDeliveryAddon::getPendingCount() const {
-  uint8_t count = 0;
-  for (int i = 0; i < VWIRE_MAX_PENDING_MESSAGES; i++) {
-    if (_pendingMessages[i].active) count++;
-  }
-  return count;
+  return _inFlight;
 }
 
 bool VwireReliableDeliveryAddon::isPending() const {
-  return getPendingCount() > 0;
+  return _inFlight > 0;
 }
 
-bool VwireReliableDeliveryAddon::send(uint8_t pin, const String& value) {
+bool VwireReliableDeliveryAddon::send(uint8_t pin, const char* value) {
   if (!_enabled || !_vwire) {
     return false;
   }
 
-  int slot = _findPendingSlot();
-  if (slot < 0) {
+  // The slot for _nextSeq is free once everything a full window back has
+  // been acknowledged or dropped.
+  if (_nextSeq - _baseSeq >= VWIRE_MAX_PENDING_MESSAGES) {
     _vwire->_setError(VWIRE_ERR_QUEUE_FULL);
     VWIRE_LOG("[Vwire] Error: Reliable delivery queue full!");
     if (_deliveryCallback) {
@@ -106,24 +139,28 @@ bool VwireReliableDeliveryAddon::send(uint8_t pin, const String& value) {
     return true;
   }
 
-  PendingMessage& pending = _pendingMessages[slot];
-  _msgIdCounter++;
-  snprintf(pending.msgId, sizeof(pending.msgId), "%04X_%lu",
-           (uint16_t)(_msgIdCounter & 0xFFFF), millis() % 10000);
+  PendingMessage& pending = _slot(_nextSeq);
+  pending.seq = _nextSeq++;
   pending.pin = pin;
-  if (value.length() >= sizeof(pending.value)) {
+  size_t valueLen = strlen(value);
+  if (valueLen >= sizeof(pending.value)) {
     VWIRE_LOGF("[Vwire] Warning: reliable delivery value truncated (%d > %d bytes)",
-              value.length(), sizeof(pending.value) - 1);
+              (int)valueLen, (int)(sizeof(pending.value) - 1));
   }
-  strncpy(pending.value, value.c_str(), sizeof(pending.value) - 1);
+  strncpy(pending.value, value, sizeof(pending.value) - 1);
   pending.value[sizeof(pending.value) - 1] = '\0';
-  pending.sentAt = millis();
   pending.retries = 0;
+  pending.deadline = millis() + _backoff(0);
   pending.active = true;
 
+  if (_inFlight == 0 || (long)(pending.deadline - _nextDeadline) < 0) {
+    _nextDeadline = pending.deadline;
+  }
+  _inFlight++;
+
   _publishPending(pending);
-  VWIRE_LOGF("[Vwire] Reliable write V%d = %s (msgId: %s)",
-                       pin, value.c_str(), pending.msgId);
+  VWIRE_LOGF("[Vwire] Reliable write V%d = %s (msgId: %lu)",
+                       pin, value, (unsigned long)pending.seq);
   return true;
 }
 
@@ -134,115 +171,143 @@ bool VwireReliableDeliveryAddon::send(uint8_t pin, const String& value) {
 void VwireReliableDeliveryAddon::onConnect() {
   if (!_enabled || !_vwire) return;
 
-  String ackTopic = _vwire->_buildTopic("ack");
-  _vwire->_mqttClient.subscribe(ackTopic.c_str(), 1);
-  VWIRE_LOGF("[Vwire] Subscribed to: %s (ACK)", ackTopic.c_str());
+  char ackTopic[96];
+  _vwire->_topic(ackTopic, sizeof(ackTopic), "ack");
+  _vwire->_streamSubscribe(ackTopic, 1);
+  VWIRE_LOGF("[Vwire] Subscribed to: %s (ACK)", ackTopic);
 }
 
-bool VwireReliableDeliveryAddon::onMessage(const char* topic, const char* payload) {
-  if (!_enabled) return false;
-
-  const char* ackPos = strstr(topic, "/ack");
-  if (!ackPos || *(ackPos + 4) != '\0') {
-    return false;
-  }
-
-  const char* msgIdStart = strstr(payload, "\"msgId\":\"");
-  const char* okStart = strstr(payload, "\"ok\":");
-  if (!msgIdStart || !okStart) {
-    return true;
-  }
-
-  msgIdStart += 9;
-  const char* msgIdEnd = strchr(msgIdStart, '\"');
-  if (!msgIdEnd) {
-    return true;
+bool VwireReliableDeliveryAddon::onMessage(const VwireMessage& message) {
+  if (!_enabled || message.type != VWIRE_MSG_ACK) return false;
+
+  const char* payload = message.payload;
+  bool success = _vwireJsonOk(payload);
+  uint32_t first = 0;
+  uint32_t last = 0;
+
+  if (_vwireJsonUint(payload, "\"ack\":", last)) {
+    VWIRE_LOGF("[Vwire] ACK received: up to %lu", (unsigned long)last);
+    _ackRange(_baseSeq, last, true);
+  } else if (_vwireJsonUint(payload, "\"from\":", first) &&
+             _vwireJsonUint(payload, "\"to\":", last)) {
+    VWIRE_LOGF("[Vwire] ACK received: %lu-%lu = %s",
+               (unsigned long)first, (unsigned long)last, success ? "OK" : "FAIL");
+    _ackRange(first, last, success);
+  } else if (_vwireJsonUint(payload, "\"msgId\":", first)) {
+    VWIRE_LOGF("[Vwire] ACK received: %lu = %s", (unsigned long)first, success ? "OK" : "FAIL");
+    PendingMessage& pending = _slot(first);
+    if (pending.active && pending.seq == first) {
+      _complete(pending, success);
+      _advanceBase();
+    } else {
+      VWIRE_LOGF("[Vwire] ACK for unknown message: %lu", (unsigned long)first);
+    }
   }
-
-  char msgId[16];
-  int len = min((int)(msgIdEnd - msgIdStart), 15);
-  strncpy(msgId, msgIdStart, len);
-  msgId[len] = '\0';
-
-  bool success = strstr(okStart, "true") != nullptr;
-  _handleAck(msgId, success);
   return true;
 }
 
 void VwireReliableDeliveryAddon::onRun() {
-  if (!_enabled || !_vwire) return;
+  if (!_enabled || !_vwire || _inFlight == 0) return;
 
+  // Nothing to retransmit before the earliest deadline
   unsigned long now = millis();
-  for (int i = 0; i < VWIRE_MAX_PENDING_MESSAGES; i++) {
-    PendingMessage& pending = _pendingMessages[i];
-    if (!pending.active) continue;
-    if (now - pending.sentAt < _ackTimeout) continue;
-
-    if (pending.retries < _maxRetries) {
+  if ((long)(now - _nextDeadline) < 0) return;
+
+  unsigned long next = now + VWIRE_MAX_ACK_BACKOFF;
+  for (uint32_t seq = _baseSeq; seq != _nextSeq; seq++) {
+    PendingMessage& pending = _slot(seq);
+    if (!pending.active || pending.seq != seq) continue;
+
+    if ((long)(now - pending.deadline) >= 0) {
+      if (pending.retries >= _maxRetries) {
+        VWIRE_LOGF("[Vwire] Message %lu dropped after %d retries",
+                             (unsigned long)pending.seq, _maxRetries);
+        _complete(pending, false);
+        continue;
+      }
       pending.retries++;
-      pending.sentAt = now;
+      pending.deadline = now + _backoff(pending.retries);
       _publishPending(pending);
-      VWIRE_LOGF("[Vwire] Retry %d/%d for message %s",
-                           pending.retries, _maxRetries, pending.msgId);
-      continue;
+      VWIRE_LOGF("[Vwire] Retry %d/%d for message %lu",
+                           pending.retries, _maxRetries, (unsigned long)pending.seq);
     }
-
-    VWIRE_LOGF("[Vwire] Message %s dropped after %d retries",
-                         pending.msgId, _maxRetries);
-    if (_deliveryCallback) {
-      _deliveryCallback(pending.msgId, false);
+    if ((long)(pending.deadline - next) < 0) {
+      next = pending.deadline;
     }
-    pending.active = false;
   }
+  _nextDeadline = next;
+  _advanceBase();
 }
 
 // =============================================================================
 // INTERNAL HELPERS
 // =============================================================================
 
-int VwireReliableDeliveryAddon::_findPendingSlot() const {
-  for (int i = 0; i < VWIRE_MAX_PENDING_MESSAGES; i++) {
-    if (!_pendingMessages[i].active) return i;
+unsigned long VwireReliableDeliveryAddon::_backoff(uint8_t retries) const {
+  // ackTimeout, 2x, 4x, ... capped at VWIRE_MAX_ACK_BACKOFF
+  unsigned long timeout = _ackTimeout;
+  while (retries-- > 0 && timeout < VWIRE_MAX_ACK_BACKOFF) {
+    timeout <<= 1;
   }
-  return -1;
+  return timeout < VWIRE_MAX_ACK_BACKOFF ? timeout : VWIRE_MAX_ACK_BACKOFF;
 }
 
 void VwireReliableDeliveryAddon::_clearPending() {
   for (int i = 0; i < VWIRE_MAX_PENDING_MESSAGES; i++) {
     _pendingMessages[i].active = false;
   }
+  _inFlight = 0;
+  _baseSeq = _nextSeq;
 }
 
-void VwireReliableDeliveryAddon::_handleAck(const char* msgId, bool success) {
-  VWIRE_LOGF("[Vwire] ACK received: %s = %s", msgId, success ? "OK" : "FAIL");
-
-  for (int i = 0; i < VWIRE_MAX_PENDING_MESSAGES; i++) {
-    PendingMessage& pending = _pendingMessages[i];
-    if (!pending.active || strcmp(pending.msgId, msgId) != 0) continue;
+void VwireReliableDeliveryAddon::_complete(PendingMessage& pending, bool success) {
+  pending.active = false;
+  _inFlight--;
+  if (_deliveryCallback) {
+    char msgId[11];
+    snprintf(msgId, sizeof(msgId), "%lu", (unsigned long)pending.seq);
+    _deliveryCallback(msgId, success);
+  }
+}
 
-    pending.active = false;
-    if (_deliveryCallback) {
-      _deliveryCallback(msgId, success);
+void VwireReliableDeliveryAddon::_ackRange(uint32_t first, uint32_t last, bool success) {
+  // Only the in-flight window can match, so walk that rather than the range
+  for (uint32_t seq = _baseSeq; seq != _nextSeq; seq++) {
+    if ((int32_t)(seq - first) < 0 || (int32_t)(seq - last) > 0) continue;
+    PendingMessage& pending = _slot(seq);
+    if (pending.active && pending.seq == seq) {
+      _complete(pending, success);
     }
-    return;
   }
+  _advanceBase();
+}
 
-  VWIRE_LOGF("[Vwire] ACK for unknown message: %s", msgId);
+void VwireReliableDeliveryAddon::_advanceBase() {
+  while (_baseSeq != _nextSeq) {
+    PendingMessage& pending = _slot(_baseSeq);
+    if (pending.active && pending.seq == _baseSeq) break;
+    _baseSeq++;
+  }
 }
 
 void VwireReliableDeliveryAddon::_publishPending(PendingMessage& message) {
-  char payload[VWIRE_JSON_BUFFER_SIZE];
   char topic[96];
-
-  snprintf(payload, sizeof(payload),
-           "{\"msgId\":\"%s\",\"pin\":\"V%d\",\"value\":\"%s\"}",
-           message.msgId, message.pin, message.value);
-  snprintf(topic, sizeof(topic), "vwire/%s/data", _vwire->_deviceId);
-
-  unsigned int len = strlen(payload);
-  _vwire->_mqttClient.beginPublish(topic, len, false);
-  _vwire->_mqttClient.print(payload);
-  _vwire->_mqttClient.endPublish();
+  char msgId[12];
+  char pin[6];
+
+  // msgId stays a string for servers that echo it back verbatim
+  snprintf(msgId, sizeof(msgId), "%lu", (unsigned long)message.seq);
+  snprintf(pin, sizeof(pin), "V%d", message.pin);
+  _vwire->_topic(topic, sizeof(topic), "data");
+
+  _vwire->_publishJson(topic, false, [&](VwireJsonWriter& json) {
+    json.beginObject();
+    json.field("msgId", msgId);
+    json.field("seq", (unsigned long)message.seq);
+    json.field("pin", pin);
+    json.field("value", message.value);
+    json.endObject();
+  });
 }
 
 // =============================================================================
@@ -4,6 +4,11 @@
  * Provides application-level acknowledgment handling for sketches that need
  * guaranteed delivery semantics on top of normal MQTT publish behaviour.
  * 
+ * Messages carry increasing uint32 sequence numbers and up to
+ * VWIRE_MAX_PENDING_MESSAGES may be in flight at once. The server can
+ * acknowledge them one by one, by range, or cumulatively (see
+ * VwireReliableDelivery.cpp for the ACK formats).
+ * 
  * Usage:
  *   Vwire.setReliableDelivery(true);
  *   Vwire.setAckTimeout(5000);
@@ -56,7 +61,7 @@ public:
 
   uint8_t getPendingCount() const override;
   bool isPending() const override;
-  bool send(uint8_t pin, const String& value) override;
+  bool send(uint8_t pin, const char* value) override;
 
   // =========================================================================
   // ADDON LIFECYCLE
@@ -64,18 +69,19 @@ public:
 
   void onAttach(VwireClass& vwire) override;
   void onConnect() override;
-  bool onMessage(const char* topic, const char* payload) override;
+  using VwireAddon::onMessage;
+  bool onMessage(const VwireMessage& message) override;
   void onRun() override;
 
 private:
-  /** @brief Internal queue entry for a reliable publish awaiting ACK */
+  /** @brief In-flight message awaiting ACK, stored in slot seq % window */
   struct PendingMessage {
-    char msgId[16];
+    uint32_t seq;                           ///< Sequence number (msgId)
+    unsigned long deadline;                 ///< millis() at which to retransmit
     uint8_t pin;
-    char value[64];
-    unsigned long sentAt;
     uint8_t retries;
     bool active;
+    char value[VWIRE_RELIABLE_VALUE_SIZE];
   };
 
   VwireClass* _vwire;
@@ -83,12 +89,20 @@ private:
   unsigned long _ackTimeout;
   uint8_t _maxRetries;
   DeliveryCallback _deliveryCallback;
-  uint32_t _msgIdCounter;
+  uint32_t _nextSeq;                        ///< Sequence number for the next send
+  uint32_t _baseSeq;                        ///< Oldest sequence number that may be in flight
+  uint8_t _inFlight;                        ///< Number of active slots
+  unsigned long _nextDeadline;              ///< Earliest retransmit deadline
   PendingMessage _pendingMessages[VWIRE_MAX_PENDING_MESSAGES];
 
-  int _findPendingSlot() const;
+  PendingMessage& _slot(uint32_t seq) {
+    return _pendingMessages[seq % VWIRE_MAX_PENDING_MESSAGES];
+  }
+  unsigned long _backoff(uint8_t retries) const;
   void _clearPending();
-  void _handleAck(const char* msgId, bool success);
+  void _complete(PendingMessage& pending, bool success);
+  void _ackRange(uint32_t first, uint32_t last, bool success);
+  void _advanceBase();
   void _publishPending(PendingMessage& message);
 };
 
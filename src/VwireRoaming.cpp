@@ -0,0 +1,262 @@
+/*
+ * Vwire IOT Arduino Library - WiFi Roaming
+ *
+ * Keeps a short list of networks and chooses access points by signal.
+ * With roaming active a connection attempt is a scan (VWIRE_STEP_SCAN)
+ * followed by a join of the strongest known BSSID on its channel, so the
+ * station never has to scan again on its own. While connected, run()
+ * samples the RSSI; when it stays weak, an asynchronous scan looks for an
+ * access point of the same network that is clearly stronger and the
+ * station reassociates to it. Moving to another network would change the
+ * address and drop the MQTT session, so that only happens on reconnect.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_ROAMING
+
+#include "VwireConfigStore.h"
+
+static const char* _vwirePassword(const char* password) {
+  return password[0] ? password : nullptr;
+}
+
+bool VwireClass::addNetwork(const char* ssid, const char* password) {
+  if (!ssid || !ssid[0] || strlen(ssid) >= sizeof(_networks[0].ssid) ||
+      (password && strlen(password) >= sizeof(_networks[0].password))) {
+    VWIRE_LOG("[Vwire] Error: invalid network name or password");
+    return false;
+  }
+
+  RoamNetwork* network = nullptr;
+  for (uint8_t i = 0; i < _networkCount; i++) {
+    if (strcmp(_networks[i].ssid, ssid) == 0) {
+      network = &_networks[i];        // Known: only the password may change
+      break;
+    }
+  }
+  if (!network) {
+    if (_networkCount >= VWIRE_MAX_NETWORKS) {
+      VWIRE_LOGF("[Vwire] Error: network list is full (%d)", VWIRE_MAX_NETWORKS);
+      return false;
+    }
+    network = &_networks[_networkCount++];
+    strcpy(network->ssid, ssid);
+  }
+  strcpy(network->password, password ? password : "");
+  return true;
+}
+
+void VwireClass::clearNetworks() {
+  memset(_networks, 0, sizeof(_networks));
+  _networkCount = 0;
+}
+
+uint8_t VwireClass::getNetworkCount() {
+  return _networkCount;
+}
+
+void VwireClass::setRoaming(bool enable, int8_t rssiThreshold) {
+  _roamEnabled = enable;
+  _roamThreshold = rssiThreshold;
+}
+
+bool VwireClass::saveNetworks() {
+  if (_networkCount == 0) {
+    return VwireStore.remove(VWIRE_CONFIG_NETWORKS);
+  }
+  if (!VwireStore.put(VWIRE_CONFIG_NETWORKS, _networks, _networkCount * sizeof(RoamNetwork))) {
+    VWIRE_LOG("[Vwire] Error: could not save the network list");
+    return false;
+  }
+  return true;
+}
+
+bool VwireClass::loadNetworks() {
+  size_t length = VwireStore.length(VWIRE_CONFIG_NETWORKS);
+  if (length == 0 || length > sizeof(_networks) || length % sizeof(RoamNetwork) != 0) {
+    return false;
+  }
+  clearNetworks();
+  VwireStore.get(VWIRE_CONFIG_NETWORKS, _networks, sizeof(_networks));
+  _networkCount = length / sizeof(RoamNetwork);
+  for (uint8_t i = 0; i < _networkCount; i++) {
+    _networks[i].ssid[sizeof(_networks[i].ssid) - 1] = '\0';
+    _networks[i].password[sizeof(_networks[i].password) - 1] = '\0';
+  }
+  VWIRE_LOGF("[Vwire] Loaded %d saved networks", _networkCount);
+  return true;
+}
+
+// =============================================================================
+// CONNECTING
+// =============================================================================
+
+bool VwireClass::_roamActive() const {
+  return _networkCount > 1 || (_roamEnabled && _networkCount > 0);
+}
+
+bool VwireClass::_roamFastWake() {
+  // _startWiFi() already tried the network passed to begin()
+  for (uint8_t i = 0; i < _networkCount; i++) {
+    if (strcmp(_networks[i].ssid, _wifiSsid) == 0) continue;
+    if (_beginFastWake(_networks[i].ssid, _networks[i].password)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void VwireClass::_roamStartScan() {
+  // A station still trying to join refuses to scan
+  WiFi.disconnect();
+  WiFi.scanDelete();
+  _roamScanning = false;
+  _fastWakeAttempt = false;
+  if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+    VWIRE_LOG("[Vwire] WiFi scan failed to start");
+  }
+  VWIRE_LOGF("[Vwire] Scanning for %d known networks", _networkCount);
+  _connectStep = VWIRE_STEP_SCAN;
+  _stepStartedAt = millis();
+}
+
+void VwireClass::_roamConnectStep() {
+  int found = WiFi.scanComplete();
+  if (found == WIFI_SCAN_RUNNING && millis() - _stepStartedAt < VWIRE_ROAM_SCAN_TIMEOUT) {
+    return;
+  }
+
+  int network = 0;
+  int best = found > 0 ? _roamPick(found, nullptr, network) : -1;
+  const RoamNetwork& target = _networks[network];
+  if (best >= 0) {
+    VWIRE_LOGF("[Vwire] Joining %s on channel %d (%d dBm)", target.ssid,
+               (int)WiFi.channel(best), (int)WiFi.RSSI(best));
+    WiFi.begin(target.ssid, _vwirePassword(target.password), WiFi.channel(best),
+               WiFi.BSSID(best), true);
+  } else {
+    // Hidden, out of range or the scan failed: let the station search
+    VWIRE_LOGF("[Vwire] No known network found, trying %s", target.ssid);
+    WiFi.begin(target.ssid, _vwirePassword(target.password));
+  }
+  WiFi.scanDelete();
+  _connectStep = VWIRE_STEP_WIFI;
+  _stepStartedAt = millis();
+}
+
+int VwireClass::_roamPick(int found, const char* ssid, int& network) {
+  int best = -1;
+  int32_t bestRssi = -127;
+  for (int i = 0; i < found; i++) {
+    String name = WiFi.SSID(i);
+    if (ssid && strcmp(name.c_str(), ssid) != 0) continue;
+    int32_t rssi = WiFi.RSSI(i);
+    if (rssi <= bestRssi) continue;
+    for (uint8_t k = 0; k < _networkCount; k++) {
+      if (strcmp(_networks[k].ssid, name.c_str()) == 0) {
+        best = i;
+        bestRssi = rssi;
+        network = k;
+        break;
+      }
+    }
+  }
+  return best;
+}
+
+// =============================================================================
+// ROAMING WHILE CONNECTED
+// =============================================================================
+
+void VwireClass::_roamRun(unsigned long now) {
+  if (_roamScanning) {
+    int found = WiFi.scanComplete();
+    if (found == WIFI_SCAN_RUNNING && now - _roamScanAt < VWIRE_ROAM_SCAN_TIMEOUT) {
+      return;
+    }
+    _roamScanning = false;
+
+    // Only access points of the current network: the address, and with it
+    // the MQTT session, can survive the move
+    String current = WiFi.SSID();
+    int network = 0;
+    int best = found > 0 ? _roamPick(found, current.c_str(), network) : -1;
+    const uint8_t* bssid = WiFi.BSSID();
+    int32_t rssi = WiFi.RSSI();
+    if (best >= 0 && bssid && memcmp(WiFi.BSSID(best), bssid, 6) != 0 &&
+        WiFi.RSSI(best) >= rssi + VWIRE_ROAM_HYSTERESIS) {
+      VWIRE_LOGF("[Vwire] Roaming to channel %d: %d dBm -> %d dBm",
+                 (int)WiFi.channel(best), (int)rssi, (int)WiFi.RSSI(best));
+      WiFi.begin(_networks[network].ssid, _vwirePassword(_networks[network].password),
+                 WiFi.channel(best), WiFi.BSSID(best), true);
+      _roamPending = true;
+    }
+    WiFi.scanDelete();
+    return;
+  }
+
+  if (now - _roamCheckedAt < VWIRE_ROAM_CHECK_INTERVAL) return;
+  _roamCheckedAt = now;
+
+  if (_roamPending) {
+    if (WiFi.status() != WL_CONNECTED) return;
+    _roamPending = false;
+    _saveAccessPoint();               // Cold boots join the new AP directly
+  }
+
+  int32_t rssi = WiFi.RSSI();
+  if (rssi == 0 || rssi >= _roamThreshold) return;     // 0: no reading
+  if (_roamScanAt != 0 && now - _roamScanAt < VWIRE_ROAM_SCAN_INTERVAL) return;
+
+  // The station keeps its association while it scans the other channels
+  _roamScanAt = now;
+  if (WiFi.scanNetworks(true) != WIFI_SCAN_FAILED) {
+    VWIRE_LOGF("[Vwire] Weak signal (%d dBm), scanning for a better access point", (int)rssi);
+    _roamScanning = true;
+  }
+}
+
+#else
+
+bool VwireClass::addNetwork(const char* ssid, const char* password) {
+  (void)ssid;
+  (void)password;
+  _debugPrint("[Vwire] WiFi roaming is not available in this build");
+  return false;
+}
+
+void VwireClass::clearNetworks() {
+}
+
+uint8_t VwireClass::getNetworkCount() {
+  return 0;
+}
+
+void VwireClass::setRoaming(bool enable, int8_t rssiThreshold) {
+  (void)enable;
+  (void)rssiThreshold;
+  _debugPrint("[Vwire] WiFi roaming is not available in this build");
+}
+
+bool VwireClass::saveNetworks() {
+  return false;
+}
+
+bool VwireClass::loadNetworks() {
+  return false;
+}
+
+#endif // VWIRE_ENABLE_ROAMING
@@ -0,0 +1,183 @@
+/*
+ * Vwire IOT Arduino Library - Cooperative Scheduler
+ *
+ * Every addon gets a task slot when it is registered; VwireTimers join
+ * through addTimer(). run() walks the slots in priority order and runs the
+ * ones that are due until the per-run() budget is spent. Tasks deferred by
+ * the budget skip the budget check on the next call, which bounds how long
+ * any due task can wait to one extra run() call.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+#if VWIRE_ENABLE_LOGGING
+  #define VWIRE_LOG(message) _debugPrint(message)
+  #define VWIRE_LOGF(...) _debugPrintf(__VA_ARGS__)
+#else
+  #define VWIRE_LOG(message) do { } while (0)
+  #define VWIRE_LOGF(...) do { } while (0)
+#endif
+
+#if VWIRE_ENABLE_SCHEDULER
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+bool VwireClass::setAddonSchedule(VwireAddon& addon, uint32_t periodMs, uint32_t budgetUs,
+                                  VwireTaskPriority priority) {
+  for (uint8_t i = 0; i < _taskCount; i++) {
+    SchedTask& task = _tasks[i];
+    if (task.addon != &addon) continue;
+
+    task.periodMs = periodMs;
+    task.budgetUs = budgetUs;
+    task.nextRun = millis();
+    task.deferred = false;
+    if (task.priority != (uint8_t)priority) {
+      task.priority = (uint8_t)priority;
+      _sortTask(i);
+    }
+    return true;
+  }
+
+  VWIRE_LOG("[Vwire] Error: setAddonSchedule() needs a registered addon");
+  return false;
+}
+
+bool VwireClass::addTimer(VwireTimer& timer, uint32_t budgetUs, VwireTaskPriority priority) {
+  uint8_t timers = 0;
+  for (uint8_t i = 0; i < _taskCount; i++) {
+    if (_tasks[i].timer == &timer) {
+      return true;
+    }
+    if (_tasks[i].timer) timers++;
+  }
+
+  if (timers >= VWIRE_MAX_SCHED_TIMERS) {
+    VWIRE_LOGF("[Vwire] Error: Max timers reached (%d)", VWIRE_MAX_SCHED_TIMERS);
+    return false;
+  }
+  return _addTask(nullptr, &timer, 0xFF, budgetUs, (uint8_t)priority);
+}
+
+void VwireClass::setRunBudget(uint32_t budgetUs) {
+  _runBudgetUs = budgetUs;
+}
+
+// =============================================================================
+// INTERNAL
+// =============================================================================
+
+bool VwireClass::_addTask(VwireAddon* addon, VwireTimer* timer, uint8_t addonIndex,
+                          uint32_t budgetUs, uint8_t priority) {
+  if (_taskCount >= VWIRE_MAX_TASKS) {
+    return false;
+  }
+
+  SchedTask& task = _tasks[_taskCount];
+  task.addon = addon;
+  task.timer = timer;
+  task.periodMs = 0;
+  task.budgetUs = budgetUs;
+  task.nextRun = millis();
+  task.addonIndex = addonIndex;
+  task.priority = priority;
+  task.deferred = false;
+  _sortTask(_taskCount++);
+  return true;
+}
+
+// Move a task to its place by priority, after tasks of equal priority
+void VwireClass::_sortTask(uint8_t index) {
+  SchedTask task = _tasks[index];
+  for (uint8_t i = index; i + 1 < _taskCount; i++) {
+    _tasks[i] = _tasks[i + 1];
+  }
+
+  uint8_t pos = _taskCount - 1;
+  while (pos > 0 && _tasks[pos - 1].priority > task.priority) {
+    _tasks[pos] = _tasks[pos - 1];
+    pos--;
+  }
+  _tasks[pos] = task;
+}
+
+void VwireClass::_runTasks(uint32_t runStartUs, unsigned long now, bool addons, bool timers) {
+  for (uint8_t i = 0; i < _taskCount; i++) {
+    SchedTask& task = _tasks[i];
+
+    // Addons only run while connected; timers whenever the caller owns them
+    if (task.timer) {
+      if (!timers || task.timer->msUntilNextEvent() != 0) continue;
+    } else {
+      if (!addons) continue;
+      if (task.periodMs > 0 && (long)(now - task.nextRun) < 0) continue;
+    }
+
+    if (_runBudgetUs > 0 && !task.deferred && micros() - runStartUs >= _runBudgetUs) {
+      task.deferred = true;
+      VWIRE_METRIC_COUNT(_metrics.deferrals, 1);
+      continue;
+    }
+    task.deferred = false;
+
+    uint32_t startUs = micros();
+    if (task.timer) {
+      task.timer->run(task.budgetUs);
+    } else {
+      task.addon->onRun();
+    }
+    uint32_t tookUs = micros() - startUs;
+
+    #if VWIRE_ENABLE_METRICS
+    if (task.timer) {
+      _metrics.timerRun.record(tookUs);
+      if (task.budgetUs > 0 && tookUs > task.budgetUs) _metrics.timerOverruns++;
+    } else {
+      _metrics.addonRun[task.addonIndex].record(tookUs);
+      if (task.budgetUs > 0 && tookUs > task.budgetUs) _metrics.addonOverruns[task.addonIndex]++;
+    }
+    #else
+    (void)tookUs;
+    #endif
+
+    if (!task.timer && task.periodMs > 0) {
+      // Stay on the period grid; restart it after a long stall
+      task.nextRun += task.periodMs;
+      if ((long)(now - task.nextRun) >= 0) {
+        task.nextRun = now + task.periodMs;
+      }
+    }
+  }
+}
+
+#else
+
+bool VwireClass::setAddonSchedule(VwireAddon& addon, uint32_t periodMs, uint32_t budgetUs,
+                                  VwireTaskPriority priority) {
+  (void)addon;
+  (void)periodMs;
+  (void)budgetUs;
+  (void)priority;
+  _debugPrint("[Vwire] Scheduler is not available in this build");
+  return false;
+}
+
+bool VwireClass::addTimer(VwireTimer& timer, uint32_t budgetUs, VwireTaskPriority priority) {
+  (void)timer;
+  (void)budgetUs;
+  (void)priority;
+  _debugPrint("[Vwire] Scheduler is not available in this build");
+  return false;
+}
+
+void VwireClass::setRunBudget(uint32_t budgetUs) {
+  (void)budgetUs;
+}
+
+#endif // VWIRE_ENABLE_SCHEDULER
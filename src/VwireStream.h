@@ -0,0 +1,298 @@
+/*
+ * Vwire IOT Arduino Library - Streaming Publish
+ *
+ * VwireJsonWriter emits JSON to a Print (or only counts it), escaping
+ * strings as it goes. VwirePublishStream is a Print that frames an MQTT
+ * PUBLISH (QoS 0) itself and hands the transport the fixed header, topic
+ * and payload from one staging buffer, so a message that fits is a single
+ * client write and a single TLS record.
+ *
+ * A publish runs the same writer code twice: once counting, for the MQTT
+ * remaining length, once into the stream. No payload buffer is needed.
+ *
+ * Usage (inside VwireClass):
+ *   _publishJson(topic, false, [&](VwireJsonWriter& json) {
+ *     json.beginObject();
+ *     json.field("subject", subject);
+ *     json.endObject();
+ *   });
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#ifndef VWIRE_STREAM_H
+#define VWIRE_STREAM_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "VwireConfig.h"
+
+/** @brief Staging buffer of a publish stream (largest single client write) */
+#ifndef VWIRE_STREAM_BUFFER_SIZE
+  #if defined(VWIRE_BOARD_ESP32) || defined(VWIRE_BOARD_ESP8266)
+    #define VWIRE_STREAM_BUFFER_SIZE 256
+  #else
+    #define VWIRE_STREAM_BUFFER_SIZE 128
+  #endif
+#endif
+
+// =============================================================================
+// JSON WRITER
+// =============================================================================
+
+/**
+ * @brief Streaming JSON writer
+ *
+ * Separators are inserted automatically; nesting is limited to 8 levels.
+ * Strings are escaped (quote, backslash, control characters as \u00XX).
+ */
+class VwireJsonWriter {
+public:
+  /** @brief Write to out, or only count bytes when out is nullptr */
+  explicit VwireJsonWriter(Print* out = nullptr)
+    : _out(out), _length(0), _depth(0), _started(0), _afterKey(false) {}
+
+  void beginObject() { _separate(); _put('{'); _open(); }
+  void endObject() { _close(); _put('}'); }
+  void beginArray() { _separate(); _put('['); _open(); }
+  void endArray() { _close(); _put(']'); }
+
+  /** @brief Object key; the next value belongs to it */
+  void key(const char* name) {
+    _separate();
+    _putString(name);
+    _put(':');
+    _afterKey = true;
+  }
+
+  void string(const char* value) { _separate(); _putString(value ? value : ""); }
+  void number(long value) { char text[24]; _separate(); _putPrinted(text, sizeof(text), snprintf(text, sizeof(text), "%ld", value)); }
+  void number(unsigned long value) { char text[24]; _separate(); _putPrinted(text, sizeof(text), snprintf(text, sizeof(text), "%lu", value)); }
+  void boolean(bool value) { _separate(); value ? _put("true", 4) : _put("false", 5); }
+
+  /** @brief Already-encoded JSON value, written verbatim */
+  void raw(const char* json) { _separate(); _put(json, strlen(json)); }
+
+  void field(const char* name, const char* value) { key(name); string(value); }
+  void field(const char* name, int value) { key(name); number((long)value); }
+  void field(const char* name, long value) { key(name); number(value); }
+  void field(const char* name, unsigned long value) { key(name); number(value); }
+  void field(const char* name, bool value) { key(name); boolean(value); }
+
+  /** @brief Bytes written so far */
+  size_t length() const { return _length; }
+
+  /** @brief Length of value once escaped (without quotes) */
+  static size_t escapedLength(const char* value) {
+    size_t len = 0;
+    for (const char* c = value; *c; c++) {
+      if (*c == '"' || *c == '\\') len += 2;
+      else if ((uint8_t)*c < 0x20) len += 6;   // \u00XX
+      else len++;
+    }
+    return len;
+  }
+
+  /** @brief Escape value into out (escapedLength() bytes, no terminator) */
+  static char* escapeInto(char* out, const char* value) {
+    for (const char* c = value; *c; c++) {
+      uint8_t ch = (uint8_t)*c;
+      if (ch == '"' || ch == '\\') {
+        *out++ = '\\';
+        *out++ = (char)ch;
+      } else if (ch < 0x20) {
+        out = _escapeControl(out, ch);
+      } else {
+        *out++ = (char)ch;
+      }
+    }
+    return out;
+  }
+
+private:
+  Print* _out;
+  size_t _length;
+  uint8_t _depth;
+  uint8_t _started;                    // Bit per level: a value was written
+  bool _afterKey;
+
+  void _open() {
+    if (_depth < 8) _started &= (uint8_t)~(1 << _depth);
+    _depth++;
+  }
+
+  void _close() {
+    if (_depth > 0) _depth--;
+  }
+
+  void _separate() {
+    if (_afterKey) {
+      _afterKey = false;
+      return;
+    }
+    if (_depth == 0 || _depth > 8) return;
+    uint8_t bit = (uint8_t)(1 << (_depth - 1));
+    if (_started & bit) _put(',');
+    _started |= bit;
+  }
+
+  void _put(char c) { _put(&c, 1); }
+
+  void _put(const char* data, size_t length) {
+    if (_out && length > 0) _out->write((const uint8_t*)data, length);
+    _length += length;
+  }
+
+  // snprintf() output, clamped to what it actually wrote into text
+  void _putPrinted(const char* text, size_t size, int printed) {
+    if (printed <= 0) return;
+    _put(text, (size_t)printed < size ? (size_t)printed : size - 1);
+  }
+
+  // Copies unescaped runs in one write each
+  void _putString(const char* value) {
+    _put('"');
+    const char* run = value;
+    for (const char* c = value; ; c++) {
+      uint8_t ch = (uint8_t)*c;
+      if (ch != 0 && ch != '"' && ch != '\\' && ch >= 0x20) continue;
+      _put(run, c - run);
+      if (ch == 0) break;
+      char escaped[6];
+      if (ch < 0x20) {
+        _put(escaped, _escapeControl(escaped, ch) - escaped);
+      } else {
+        escaped[0] = '\\';
+        escaped[1] = (char)ch;
+        _put(escaped, 2);
+      }
+      run = c + 1;
+    }
+    _put('"');
+  }
+
+  static char* _escapeControl(char* out, uint8_t ch) {
+    static const char hex[] = "0123456789abcdef";
+    *out++ = '\\'; *out++ = 'u'; *out++ = '0'; *out++ = '0';
+    *out++ = hex[ch >> 4];
+    *out++ = hex[ch & 0x0F];
+    return out;
+  }
+};
+
+// =============================================================================
+// PUBLISH STREAM
+// =============================================================================
+
+/**
+ * @brief Coalescing writer for one MQTT PUBLISH packet (QoS 0)
+ *
+ * begin() stages the fixed header and topic; payload bytes follow in the
+ * same buffer, which goes to the client whenever it fills and at end().
+ *
+ * If the payload turns out longer or shorter than declared, or the client
+ * takes a short write, the packet is abandoned. Once any of it has reached
+ * the client the connection is stopped rather than padded, since the broker
+ * would otherwise read the next packet as the rest of this one; run() then
+ * reconnects as for any other drop.
+ */
+class VwirePublishStream : public Print {
+public:
+  explicit VwirePublishStream(Client& client)
+    : _client(client), _staged(0), _remaining(0), _sent(false), _failed(false) {}
+
+  using Print::write;
+
+  /**
+   * @brief Start a packet
+   * @param payloadLength Exact number of payload bytes that will follow
+   */
+  void begin(const char* topic, size_t payloadLength, bool retain) {
+    size_t topicLength = strlen(topic);
+    uint32_t remaining = (uint32_t)(2 + topicLength + payloadLength);
+    _remaining = payloadLength;
+
+    uint8_t header[5];
+    uint8_t headerLength = 0;
+    header[headerLength++] = (uint8_t)(0x30 | (retain ? 1 : 0));
+    do {
+      uint8_t digit = remaining % 128;
+      remaining /= 128;
+      header[headerLength++] = remaining > 0 ? (uint8_t)(digit | 0x80) : digit;
+    } while (remaining > 0 && headerLength < 5);
+
+    _stage(header, headerLength);
+    uint8_t lengthBytes[2] = { (uint8_t)(topicLength >> 8), (uint8_t)topicLength };
+    _stage(lengthBytes, 2);
+    _stage((const uint8_t*)topic, topicLength);
+  }
+
+  size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t* data, size_t length) override {
+    if (_failed) return 0;
+    if (length > _remaining) {
+      _fail();                         // Sizing pass disagreed: frame would be corrupt
+      return 0;
+    }
+    _stage(data, length);
+    _remaining -= length;
+    return length;
+  }
+
+  /**
+   * @brief Send what is staged
+   * @return true if the whole packet reached the client
+   */
+  bool end() {
+    if (_remaining > 0) _fail();       // Shorter than declared
+    _flush();
+    return !_failed;
+  }
+
+private:
+  Client& _client;
+  uint8_t _buffer[VWIRE_STREAM_BUFFER_SIZE];
+  size_t _staged;
+  size_t _remaining;
+  bool _sent;                          ///< Some bytes reached the client
+  bool _failed;
+
+  void _fail() {
+    if (_failed) return;
+    _failed = true;
+    _staged = 0;
+    if (_sent) _client.stop();         // Drop the half-written packet with the connection
+  }
+
+  void _stage(const uint8_t* data, size_t length) {
+    while (length > 0) {
+      if (_staged == sizeof(_buffer)) _flush();
+      size_t chunk = sizeof(_buffer) - _staged;
+      if (chunk > length) chunk = length;
+      memcpy(_buffer + _staged, data, chunk);
+      _staged += chunk;
+      data += chunk;
+      length -= chunk;
+    }
+  }
+
+  void _flush() {
+    if (_staged == 0 || _failed) {
+      _staged = 0;
+      return;
+    }
+    size_t length = _staged;
+    _staged = 0;
+    _sent = true;
+    if (_client.write(_buffer, length) != length) {
+      _fail();
+    }
+  }
+};
+
+#endif // VWIRE_STREAM_H
@@ -3,6 +3,11 @@
  * 
  * Non-blocking software timer using millis() for universal compatibility.
  * 
+ * Enabled timers sit in a binary min-heap keyed by their next deadline, so
+ * run() only looks at the root until something is due and each firing costs
+ * O(log n). Deadlines advance by whole intervals from the previous deadline
+ * rather than from the moment run() noticed them, so periods do not drift.
+ * 
  * Copyright (c) 2026 Vwire IOT
  * Website: https://vwire.io
  * MIT License
@@ -16,6 +21,7 @@
 
 VwireTimer::VwireTimer() {
   _numTimers = 0;
+  _heapSize = 0;
   
   // Initialize all timer slots
   for (int i = 0; i < VWIRE_MAX_TIMERS; i++) {
@@ -23,12 +29,14 @@ VwireTimer::VwireTimer() {
     _timers[i].callbackArg = NULL;
     _timers[i].arg = NULL;
     _timers[i].interval = 0;
-    _timers[i].lastTriggered = 0;
+    _timers[i].dueAt = 0;
     _timers[i].maxRuns = 0;
     _timers[i].currentRun = 0;
     _timers[i].enabled = false;
     _timers[i].hasArg = false;
     _timers[i].inUse = false;
+    _timers[i].catchUp = VWIRE_CATCHUP_SKIP;
+    _heapPos[i] = 0xFF;
   }
 }
 
@@ -57,7 +65,6 @@ int VwireTimer::_createTimer(unsigned long interval, int maxRuns) {
   }
   
   _timers[slot].interval = interval;
-  _timers[slot].lastTriggered = millis();
   _timers[slot].maxRuns = maxRuns;
   _timers[slot].currentRun = 0;
   _timers[slot].enabled = true;
@@ -66,12 +73,84 @@ int VwireTimer::_createTimer(unsigned long interval, int maxRuns) {
   _timers[slot].callback = NULL;
   _timers[slot].callbackArg = NULL;
   _timers[slot].arg = NULL;
+  _timers[slot].catchUp = VWIRE_CATCHUP_SKIP;
   
   _numTimers++;
+  _schedule(slot, millis() + interval);
   
   return slot;
 }
 
+// =============================================================================
+// DEADLINE HEAP
+// =============================================================================
+
+// Wrap-safe deadline order (valid while deadlines are < 24.8 days apart)
+bool VwireTimer::_before(uint8_t a, uint8_t b) const {
+  return (long)(_timers[a].dueAt - _timers[b].dueAt) < 0;
+}
+
+void VwireTimer::_heapSwap(uint8_t i, uint8_t j) {
+  uint8_t id = _heap[i];
+  _heap[i] = _heap[j];
+  _heap[j] = id;
+  _heapPos[_heap[i]] = i;
+  _heapPos[_heap[j]] = j;
+}
+
+void VwireTimer::_siftUp(uint8_t pos) {
+  while (pos > 0) {
+    uint8_t parent = (pos - 1) / 2;
+    if (!_before(_heap[pos], _heap[parent])) break;
+    _heapSwap(pos, parent);
+    pos = parent;
+  }
+}
+
+void VwireTimer::_siftDown(uint8_t pos) {
+  for (;;) {
+    uint8_t first = pos;
+    uint8_t left = 2 * pos + 1;
+    uint8_t right = left + 1;
+    if (left < _heapSize && _before(_heap[left], _heap[first])) first = left;
+    if (right < _heapSize && _before(_heap[right], _heap[first])) first = right;
+    if (first == pos) break;
+    _heapSwap(pos, first);
+    pos = first;
+  }
+}
+
+// Set a timer's deadline and (re)insert it into the heap
+void VwireTimer::_schedule(int timerId, unsigned long dueAt) {
+  _timers[timerId].dueAt = dueAt;
+
+  uint8_t pos = _heapPos[timerId];
+  if (pos == 0xFF) {
+    pos = _heapSize++;
+    _heap[pos] = (uint8_t)timerId;
+    _heapPos[timerId] = pos;
+  }
+  _siftUp(pos);
+  _siftDown(_heapPos[timerId]);
+}
+
+void VwireTimer::_unschedule(int timerId) {
+  uint8_t pos = _heapPos[timerId];
+  if (pos == 0xFF) {
+    return;
+  }
+
+  _heapPos[timerId] = 0xFF;
+  uint8_t last = --_heapSize;
+  if (pos != last) {
+    uint8_t moved = _heap[last];
+    _heap[pos] = moved;
+    _heapPos[moved] = pos;
+    _siftUp(pos);
+    _siftDown(_heapPos[moved]);
+  }
+}
+
 // =============================================================================
 // TIMER CREATION - setInterval
 // =============================================================================
@@ -170,11 +249,13 @@ void VwireTimer::deleteTimer(int timerId) {
     return;
   }
   
+  _unschedule(timerId);
+  
   _timers[timerId].callback = NULL;
   _timers[timerId].callbackArg = NULL;
   _timers[timerId].arg = NULL;
   _timers[timerId].interval = 0;
-  _timers[timerId].lastTriggered = 0;
+  _timers[timerId].dueAt = 0;
   _timers[timerId].maxRuns = 0;
   _timers[timerId].currentRun = 0;
   _timers[timerId].enabled = false;
@@ -187,13 +268,14 @@ void VwireTimer::deleteTimer(int timerId) {
 void VwireTimer::enable(int timerId) {
   if (_isValidId(timerId)) {
     _timers[timerId].enabled = true;
-    _timers[timerId].lastTriggered = millis();  // Reset timing
+    _schedule(timerId, millis() + _timers[timerId].interval);  // Reset timing
   }
 }
 
 void VwireTimer::disable(int timerId) {
   if (_isValidId(timerId)) {
     _timers[timerId].enabled = false;
+    _unschedule(timerId);
   }
 }
 
@@ -205,7 +287,9 @@ bool VwireTimer::toggle(int timerId) {
   _timers[timerId].enabled = !_timers[timerId].enabled;
   
   if (_timers[timerId].enabled) {
-    _timers[timerId].lastTriggered = millis();  // Reset timing on enable
+    _schedule(timerId, millis() + _timers[timerId].interval);  // Reset timing on enable
+  } else {
+    _unschedule(timerId);
   }
   
   return _timers[timerId].enabled;
@@ -213,16 +297,18 @@ bool VwireTimer::toggle(int timerId) {
 
 void VwireTimer::restartTimer(int timerId) {
   if (_isValidId(timerId)) {
-    _timers[timerId].lastTriggered = millis();
     _timers[timerId].currentRun = 0;
     _timers[timerId].enabled = true;
+    _schedule(timerId, millis() + _timers[timerId].interval);
   }
 }
 
 void VwireTimer::changeInterval(int timerId, unsigned long newInterval) {
   if (_isValidId(timerId)) {
     _timers[timerId].interval = newInterval;
-    _timers[timerId].lastTriggered = millis();  // Reset timing
+    if (_timers[timerId].enabled) {
+      _schedule(timerId, millis() + newInterval);  // Reset timing
+    }
   }
 }
 
@@ -231,13 +317,22 @@ unsigned long VwireTimer::getRemaining(int timerId) {
     return 0;
   }
   
-  unsigned long elapsed = millis() - _timers[timerId].lastTriggered;
-  
-  if (elapsed >= _timers[timerId].interval) {
-    return 0;
+  long remaining = (long)(_timers[timerId].dueAt - millis());
+  return remaining > 0 ? (unsigned long)remaining : 0;
+}
+
+void VwireTimer::setCatchUp(int timerId, VwireTimerCatchUp mode) {
+  if (_isValidId(timerId)) {
+    _timers[timerId].catchUp = (uint8_t)mode;
   }
-  
-  return _timers[timerId].interval - elapsed;
+}
+
+unsigned long VwireTimer::msUntilNextEvent() {
+  if (_heapSize == 0) {
+    return VWIRE_TIMER_NEVER;
+  }
+  long remaining = (long)(_timers[_heap[0]].dueAt - millis());
+  return remaining > 0 ? (unsigned long)remaining : 0;
 }
 
 // =============================================================================
@@ -271,37 +366,70 @@ int VwireTimer::getMaxTimers() {
 // EXECUTION - Must be called in loop()
 // =============================================================================
 
-void VwireTimer::run() {
+void VwireTimer::run(uint32_t budgetUs) {
+  if (_heapSize == 0) {
+    return;
+  }
+  
   unsigned long currentMillis = millis();
+  uint32_t startUs = budgetUs > 0 ? micros() : 0;
   
-  for (int i = 0; i < VWIRE_MAX_TIMERS; i++) {
-    // Skip unused or disabled slots
-    if (!_timers[i].inUse || !_timers[i].enabled) {
-      continue;
+  // Each timer fires at most once per call, even when it is rescheduled
+  // into the past (interval 0, BURST catch-up): reaching one that already
+  // fired ends the pass. Whatever else is due sorts after it and runs on
+  // the next call.
+  uint8_t fired[(VWIRE_MAX_TIMERS + 7) / 8];
+  memset(fired, 0, sizeof(fired));
+  
+  while (_heapSize > 0) {
+    int i = _heap[0];
+    TimerSlot& timer = _timers[i];
+    
+    // Nothing due yet (handles millis() overflow correctly)
+    if ((long)(currentMillis - timer.dueAt) < 0) {
+      break;
     }
     
-    // Check if interval has elapsed (handles millis() overflow correctly)
-    if ((unsigned long)(currentMillis - _timers[i].lastTriggered) >= _timers[i].interval) {
-      
-      // Update last triggered time
-      _timers[i].lastTriggered = currentMillis;
-      
-      // Increment run count
-      _timers[i].currentRun++;
-      
-      // Execute callback
-      if (_timers[i].hasArg && _timers[i].callbackArg != NULL) {
-        _timers[i].callbackArg(_timers[i].arg);
-      } else if (_timers[i].callback != NULL) {
-        _timers[i].callback();
-      }
-      
-      // Check if timer should stop (not infinite and reached max runs)
-      if (_timers[i].maxRuns != VWIRE_RUN_FOREVER && 
-          _timers[i].currentRun >= _timers[i].maxRuns) {
-        // Auto-delete timer that has finished
-        deleteTimer(i);
+    uint8_t bit = (uint8_t)(1 << (i % 8));
+    if (fired[i / 8] & bit) {
+      break;
+    }
+    fired[i / 8] |= bit;
+    
+    // Keep the callback: a finished timer is deleted before it runs, so the
+    // callback may safely create, restart or delete timers (including this one)
+    vwire_timer_callback callback = timer.callback;
+    vwire_timer_callback_arg callbackArg = timer.callbackArg;
+    void* arg = timer.arg;
+    bool hasArg = timer.hasArg;
+    
+    // Increment run count
+    timer.currentRun++;
+    
+    // Check if timer should stop (not infinite and reached max runs)
+    if (timer.maxRuns != VWIRE_RUN_FOREVER && timer.currentRun >= timer.maxRuns) {
+      // Auto-delete timer that has finished
+      deleteTimer(i);
+    } else {
+      unsigned long next = timer.dueAt + timer.interval;
+      if (timer.catchUp == VWIRE_CATCHUP_NONE || timer.interval == 0) {
+        next = currentMillis + timer.interval;
+      } else if (timer.catchUp == VWIRE_CATCHUP_SKIP && (long)(currentMillis - next) >= 0) {
+        // Late by one or more whole periods: jump to the next grid point
+        next += ((currentMillis - next) / timer.interval + 1) * timer.interval;
       }
+      _schedule(i, next);
+    }
+    
+    // Execute callback
+    if (hasArg && callbackArg != NULL) {
+      callbackArg(arg);
+    } else if (callback != NULL) {
+      callback();
+    }
+    
+    if (budgetUs > 0 && micros() - startUs >= budgetUs) {
+      break;
     }
   }
 }
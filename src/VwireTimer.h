@@ -12,6 +12,9 @@
  * - Enable/disable/toggle control
  * - Change interval on the fly
  * - Callback with optional argument
+ * - Drift-free periods with selectable catch-up after a late run()
+ * - Deadline-ordered: run() is O(1) when nothing is due, and
+ *   msUntilNextEvent() tells the loop how long it may sleep
  * 
  * Compatible with:
  * - ESP32, ESP8266
@@ -48,12 +51,33 @@
   #endif
 #endif
 
+#if VWIRE_MAX_TIMERS > 255
+  #error "VWIRE_MAX_TIMERS must be 255 or less"
+#endif
+
 // Invalid timer ID
 #define VWIRE_TIMER_INVALID -1
 
 // Infinite runs (for setInterval)
 #define VWIRE_RUN_FOREVER -1
 
+// msUntilNextEvent() when no timer is enabled
+#define VWIRE_TIMER_NEVER 0xFFFFFFFFUL
+
+// =============================================================================
+// CATCH-UP POLICIES
+// =============================================================================
+
+/**
+ * What a repeating timer does when run() comes late.
+ * All policies keep the callback from running more than once per run().
+ */
+typedef enum {
+  VWIRE_CATCHUP_SKIP = 0,   // Stay on the original grid, drop missed runs (default)
+  VWIRE_CATCHUP_BURST,      // Stay on the grid, make up every missed run, one per run()
+  VWIRE_CATCHUP_NONE        // Restart the period from the late run (drifts)
+} VwireTimerCatchUp;
+
 // =============================================================================
 // CALLBACK TYPES
 // =============================================================================
@@ -180,6 +204,24 @@ public:
    * @return Milliseconds until next run, or 0 if invalid/disabled
    */
   unsigned long getRemaining(int timerId);
+
+  /**
+   * Choose how a timer catches up after a late run()
+   * @param timerId Timer ID
+   * @param mode Catch-up policy (new timers use VWIRE_CATCHUP_SKIP)
+   */
+  void setCatchUp(int timerId, VwireTimerCatchUp mode);
+
+  /**
+   * Time until the next enabled timer is due
+   *
+   * Lets the loop sleep exactly as long as nothing is scheduled, e.g.
+   * delay(min(timer.msUntilNextEvent(), 100UL)) keeps Vwire.run() serviced
+   * while the WiFi modem sleeps in between.
+   *
+   * @return Milliseconds (0 if a timer is due), or VWIRE_TIMER_NEVER
+   */
+  unsigned long msUntilNextEvent();
   
   // =========================================================================
   // STATUS METHODS
@@ -223,9 +265,13 @@ public:
   
   /**
    * Process all timers - MUST be called in loop()
-   * Checks each timer and executes callbacks as needed
+   * Executes due callbacks in deadline order, each at most once per call;
+   * returns after a single comparison when nothing is due
+   * @param budgetUs Stop starting callbacks once this many microseconds
+   *                 have passed (0 = run everything due). Timers left over
+   *                 keep their deadline and run first on the next call.
    */
-  void run();
+  void run(uint32_t budgetUs = 0);
   
   /**
    * Delete all timers
@@ -239,22 +285,35 @@ private:
     vwire_timer_callback_arg callbackArg;   // Callback with argument
     void* arg;                              // User argument
     unsigned long interval;                 // Interval in ms
-    unsigned long lastTriggered;            // Last execution time
+    unsigned long dueAt;                    // Next execution time
     int maxRuns;                            // Max runs (-1 = infinite, 0 = done)
     int currentRun;                         // Current run count
     bool enabled;                           // Timer active flag
     bool hasArg;                            // Uses callback with argument
     bool inUse;                             // Slot is occupied
+    uint8_t catchUp;                        // VwireTimerCatchUp
   };
   
   // Timer storage
   TimerSlot _timers[VWIRE_MAX_TIMERS];
   int _numTimers;
+
+  // Min-heap of enabled timer IDs ordered by dueAt, and each ID's position
+  // in it (0xFF = not scheduled)
+  uint8_t _heap[VWIRE_MAX_TIMERS];
+  uint8_t _heapPos[VWIRE_MAX_TIMERS];
+  uint8_t _heapSize;
   
   // Internal helpers
   int _findFreeSlot();
   bool _isValidId(int timerId);
   int _createTimer(unsigned long interval, int maxRuns);
+  void _schedule(int timerId, unsigned long dueAt);
+  void _unschedule(int timerId);
+  bool _before(uint8_t a, uint8_t b) const;
+  void _heapSwap(uint8_t i, uint8_t j);
+  void _siftUp(uint8_t pos);
+  void _siftDown(uint8_t pos);
 };
 
 #endif // VWIRE_TIMER_H
@@ -0,0 +1,299 @@
+/*
+ * Vwire IOT Arduino Library - Virtual Pin Values
+ *
+ * Fixed-storage implementation of VirtualPin. Values live in an inline
+ * buffer inside the object; only values longer than VWIRE_PIN_INLINE_SIZE
+ * take a single heap block. Typed setters format straight into that buffer,
+ * numeric getters parse once and cache the result, and array access goes
+ * through an element offset index built in one pass.
+ *
+ * Copyright (c) 2026 Vwire IOT
+ * Website: https://vwire.io
+ * MIT License
+ */
+
+#include "Vwire.h"
+
+// =============================================================================
+// FORMATTING HELPERS
+// =============================================================================
+
+static size_t _vwireFormatDouble(char* buffer, size_t size, double value, uint8_t decimals) {
+  // dtostrf() has no bounds check; keep its output within the 48-byte
+  // worst case for |value| < 1e30 and fall back to exponent notation above.
+  if (value > 1e30 || value < -1e30) {
+    snprintf(buffer, size, "%.*e", decimals, value);
+  } else {
+    dtostrf(value, decimals + 2, decimals, buffer);
+  }
+  // dtostrf() pads to the minimum width with leading spaces
+  char* start = buffer;
+  while (*start == ' ') start++;
+  size_t len = strlen(start);
+  if (start != buffer) memmove(buffer, start, len + 1);
+  return len;
+}
+
+static bool _vwireEqualsIgnoreCase(const char* a, const char* b) {
+  while (*a && *b) {
+    if (tolower((unsigned char)*a) != tolower((unsigned char)*b)) return false;
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+// =============================================================================
+// STORAGE
+// =============================================================================
+
+void VirtualPin::_release() {
+  if (_data != _inline && _capacity != 0) {
+    free(_data);
+  }
+  _init();
+}
+
+bool VirtualPin::_reserve(size_t capacity) {
+  if (capacity <= _capacity) return true;
+
+  char* block;
+  if (_capacity == 0 && capacity <= sizeof(_inline)) {
+    // Borrowed view being modified: the inline buffer is enough
+    block = _inline;
+    capacity = sizeof(_inline);
+  } else {
+    block = (char*)malloc(capacity);
+    if (!block) return false;
+  }
+  memcpy(block, _data, _length + 1);
+  if (_data != _inline && _capacity != 0) free(_data);
+  _data = block;
+  _capacity = capacity;
+  return true;
+}
+
+void VirtualPin::_assign(const char* value, size_t length) {
+  if (!value) length = 0;
+  if (_capacity == 0) {
+    // Drop a borrowed view; the value never aliases our own storage here
+    _init();
+  }
+  if (length + 1 > _capacity && !_reserve(length + 1)) {
+    length = _capacity - 1;  // Out of memory: keep what fits
+  }
+  // memmove: value may point into our own buffer (e.g. set(asCString()))
+  if (length > 0) memmove(_data, value, length);
+  _data[length] = '\0';
+  _length = length;
+  _cached = 0;
+}
+
+bool VirtualPin::_append(const char* value, size_t length) {
+  size_t needed = _length + length + 1;
+  if (needed > _capacity) {
+    size_t grow = _capacity * 2;
+    if (!_reserve(grow > needed ? grow : needed)) return false;
+  }
+  memcpy(_data + _length, value, length);
+  _length += length;
+  _data[_length] = '\0';
+  _cached = 0;
+  return true;
+}
+
+// =============================================================================
+// TYPED SETTERS
+// =============================================================================
+
+void VirtualPin::set(long value) {
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%ld", value);
+  _assign(buffer, len);
+  // The numeric value is already known exactly; skip parsing it back
+  _longValue = value;
+  _doubleValue = (double)value;
+  _cached = CACHE_LONG | CACHE_DOUBLE;
+}
+
+void VirtualPin::set(unsigned long value) {
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%lu", value);
+  _assign(buffer, len);
+  _doubleValue = (double)value;
+  _cached = CACHE_DOUBLE;
+}
+
+void VirtualPin::_setDouble(double value, uint8_t decimals) {
+  char buffer[48];
+  size_t len = _vwireFormatDouble(buffer, sizeof(buffer), value, decimals);
+  _assign(buffer, len);
+}
+
+void VirtualPin::setArray(const float* values, int count, uint8_t decimals) {
+  _assign("", 0);
+  char buffer[48];
+  for (int i = 0; i < count; i++) {
+    if (i > 0 && !_append(",", 1)) return;
+    size_t len = _vwireFormatDouble(buffer, sizeof(buffer), values[i], decimals);
+    if (!_append(buffer, len)) return;
+  }
+}
+
+void VirtualPin::setArray(const int* values, int count) {
+  _assign("", 0);
+  char buffer[12];
+  for (int i = 0; i < count; i++) {
+    if (i > 0 && !_append(",", 1)) return;
+    int len = snprintf(buffer, sizeof(buffer), "%d", values[i]);
+    if (!_append(buffer, len)) return;
+  }
+}
+
+// Appends element (length bytes) after a comma unless it is the first;
+// false once it does not fit in out with the terminator
+static bool _vwireAppendElement(char* out, size_t size, size_t& used,
+                                const char* element, size_t length) {
+  size_t needed = used + (used > 0 ? 1 : 0) + length;
+  if (needed + 1 > size) return false;
+  if (used > 0) out[used++] = ',';
+  memcpy(out + used, element, length);
+  used += length;
+  out[used] = '\0';
+  return true;
+}
+
+size_t VirtualPin::formatArray(char* out, size_t size, const float* values, int count,
+                               uint8_t decimals) {
+  if (size == 0) return 0;
+  out[0] = '\0';
+  size_t used = 0;
+  char buffer[48];
+  for (int i = 0; i < count; i++) {
+    size_t len = _vwireFormatDouble(buffer, sizeof(buffer), values[i], decimals);
+    if (!_vwireAppendElement(out, size, used, buffer, len)) break;
+  }
+  return used;
+}
+
+size_t VirtualPin::formatArray(char* out, size_t size, const int* values, int count) {
+  if (size == 0) return 0;
+  out[0] = '\0';
+  size_t used = 0;
+  char buffer[12];
+  for (int i = 0; i < count; i++) {
+    int len = snprintf(buffer, sizeof(buffer), "%d", values[i]);
+    if (!_vwireAppendElement(out, size, used, buffer, len)) break;
+  }
+  return used;
+}
+
+// =============================================================================
+// GETTERS
+// =============================================================================
+
+long VirtualPin::_parseLong() const {
+  if (!(_cached & CACHE_LONG)) {
+    _longValue = atol(_data);
+    _cached |= CACHE_LONG;
+  }
+  return _longValue;
+}
+
+double VirtualPin::_parseDouble() const {
+  if (!(_cached & CACHE_DOUBLE)) {
+    _doubleValue = atof(_data);
+    _cached |= CACHE_DOUBLE;
+  }
+  return _doubleValue;
+}
+
+bool VirtualPin::asBool() const {
+  if (_length == 1) return _data[0] == '1';
+  return _vwireEqualsIgnoreCase(_data, "true") || _vwireEqualsIgnoreCase(_data, "on");
+}
+
+// =============================================================================
+// ARRAY SUPPORT
+// =============================================================================
+
+void VirtualPin::_indexArray() const {
+  if (_cached & CACHE_ARRAY) return;
+
+  if (_length == 0) {
+    _arraySize = 0;
+  } else {
+    int count = 1;
+    _offsets[0] = 0;
+    for (size_t i = 0; i < _length; i++) {
+      if (_data[i] == ',') {
+        if (count < VWIRE_PIN_ARRAY_CACHE) {
+          _offsets[count] = (uint16_t)(i + 1);
+        }
+        count++;
+      }
+    }
+    _arraySize = count;
+  }
+  _cached |= CACHE_ARRAY;
+}
+
+const char* VirtualPin::_element(int index, size_t* length) const {
+  _indexArray();
+  if (index < 0 || index >= _arraySize) return nullptr;
+
+  const char* start;
+  if (index < VWIRE_PIN_ARRAY_CACHE) {
+    start = _data + _offsets[index];
+  } else {
+    // Past the cached offsets: walk forward from the last one we have
+    start = _data + _offsets[VWIRE_PIN_ARRAY_CACHE - 1];
+    for (int skip = index - (VWIRE_PIN_ARRAY_CACHE - 1); skip > 0; skip--) {
+      start = strchr(start, ',') + 1;
+    }
+  }
+
+  if (length) {
+    const char* end = strchr(start, ',');
+    *length = end ? (size_t)(end - start) : (size_t)(_data + _length - start);
+  }
+  return start;
+}
+
+int VirtualPin::getArrayInt(int index) const {
+  // atol()/atof() stop at the ',' that ends the element
+  const char* element = _element(index, nullptr);
+  return element ? (int)atol(element) : 0;
+}
+
+float VirtualPin::getArrayFloat(int index) const {
+  const char* element = _element(index, nullptr);
+  return element ? (float)atof(element) : 0.0f;
+}
+
+String VirtualPin::getArrayElement(int index) const {
+  size_t len = 0;
+  const char* element = _element(index, &len);
+  String result;
+  if (!element) return result;
+  result.reserve(len);
+  for (size_t i = 0; i < len; i++) {
+    result += element[i];
+  }
+  return result;
+}
+
+int VirtualPin::getArrayElement(int index, char* buffer, size_t size) const {
+  size_t len = 0;
+  const char* element = _element(index, &len);
+  if (!element) {
+    if (size > 0) buffer[0] = '\0';
+    return -1;
+  }
+  if (size > 0) {
+    size_t copyLen = len < size - 1 ? len : size - 1;
+    memcpy(buffer, element, copyLen);
+    buffer[copyLen] = '\0';
+  }
+  return (int)len;
+}